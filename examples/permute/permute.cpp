@@ -0,0 +1,94 @@
+/*
+ *  This file is a part of TiledArray.
+ *  Copyright (C) 2016  Virginia Tech
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include <iostream>
+#include <iomanip>
+#include <sstream>
+#include <algorithm>
+#include <cstdlib>
+#include <vector>
+#include <tiledarray.h>
+
+// Benchmark the permuted tensor copy of fourth-order tensors. The element-wise
+// permute kernel is compared to the cache blocked SIMD permute copy kernel.
+
+int main(int argc, char** argv) {
+  madness::World& world = madness::initialize(argc, argv);
+
+  // Get command line arguments
+  const std::size_t n = (argc > 1 ? std::atol(argv[1]) : 40ul);
+  const std::size_t repeat = (argc > 2 ? std::atol(argv[2]) : 10ul);
+  if(n < 1ul || repeat < 1ul) {
+    std::cerr << "Usage: " << argv[0] << " [extent = 40] [repeat = 10]\n";
+    madness::finalize();
+    return 1;
+  }
+
+  typedef TiledArray::Tensor<double> TensorD;
+
+  TensorD arg(TiledArray::Range(std::vector<std::size_t>(4, n)));
+  for(std::size_t i = 0ul; i < arg.size(); ++i)
+    arg[i] = double(i);
+
+  const std::vector<TiledArray::Permutation> perms = {
+      TiledArray::Permutation({0,1,3,2}), TiledArray::Permutation({1,0,3,2}),
+      TiledArray::Permutation({0,3,2,1}), TiledArray::Permutation({2,3,0,1}),
+      TiledArray::Permutation({3,2,1,0}), TiledArray::Permutation({1,0,2,3}) };
+
+  const double gbytes = double(repeat * arg.size() * 2ul * sizeof(double)) / 1.0e9;
+
+  if(world.rank() == 0)
+    std::cout << "Permute of " << n << "^4 tensor, " << repeat << " repetitions\n"
+              << std::setw(16) << "permutation"
+              << std::setw(14) << "permute (s)" << std::setw(14) << "GB/s"
+              << std::setw(14) << "copy (s)" << std::setw(14) << "GB/s" << "\n";
+
+  for(const auto& perm : perms) {
+    auto input_op = [] (const double arg) { return arg; };
+    auto output_op = [] (double* result, const double arg) { *result = arg; };
+
+    // Element-wise permute
+    TensorD result0(perm * arg.range());
+    double start = madness::wall_time();
+    for(std::size_t r = 0ul; r < repeat; ++r)
+      TiledArray::detail::permute(input_op, output_op, result0, perm, arg);
+    const double time0 = madness::wall_time() - start;
+
+    // Blocked permute copy
+    TensorD result1(perm * arg.range());
+    start = madness::wall_time();
+    for(std::size_t r = 0ul; r < repeat; ++r)
+      TiledArray::detail::permute_copy(result1, perm, arg);
+    const double time1 = madness::wall_time() - start;
+
+    if(! std::equal(result0.begin(), result0.end(), result1.begin()))
+      std::cerr << "Error: results differ for permutation " << perm << "\n";
+
+    if(world.rank() == 0) {
+      std::stringstream ss;
+      ss << perm;
+      std::cout << std::setw(16) << ss.str()
+                << std::setw(14) << time0 << std::setw(14) << gbytes / time0
+                << std::setw(14) << time1 << std::setw(14) << gbytes / time1 << "\n";
+    }
+  }
+
+  madness::finalize();
+  return 0;
+}
@@ -509,6 +509,46 @@ namespace TiledArray {
       /// \return A const reference to this object unique id
       const madness::uniqueidT& id() const { return data_.id(); }
 
+      /// Set the remote tile cache
+
+      /// \param max_bytes The maximum number of bytes of cached tiles, or zero
+      /// to disable the cache
+      /// \sa DistributedStorage::set_remote_cache()
+      void set_remote_cache(const std::size_t max_bytes) {
+        data_.set_remote_cache(max_bytes);
+      }
+
+      /// Remote tile cache hit counter
+
+      /// \return The number of remote tiles found in the cache
+      std::size_t remote_cache_hits() const { return data_.remote_cache_hits(); }
+
+      /// Remote tile cache miss counter
+
+      /// \return The number of remote tiles requested while the cache is
+      /// enabled that were not found in the cache
+      std::size_t remote_cache_misses() const { return data_.remote_cache_misses(); }
+
+      /// Set the out-of-core storage of local tiles
+
+      /// \param max_bytes The memory budget for local tiles in bytes, or zero
+      /// to disable spilling
+      /// \param directory The directory of the spill file
+      /// \sa DistributedStorage::set_spill()
+      void set_spill(const std::size_t max_bytes, const std::string& directory) {
+        data_.set_spill(max_bytes, directory);
+      }
+
+      /// Prefetch a local tile
+
+      /// \tparam Index The index type
+      /// \param i The tile index
+      /// \sa DistributedStorage::prefetch()
+      template <typename Index>
+      void prefetch(const Index& i) const {
+        data_.prefetch(TensorImpl_::trange().tiles_range().ordinal(i));
+      }
+
     }; // class ArrayImpl
 
 
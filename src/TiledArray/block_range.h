@@ -40,6 +40,26 @@ namespace TiledArray {
 
     Range::ordinal_type block_offset_ = 0ul;
 
+    /// Map an ordinal index of the block to an offset in the parent range
+
+    /// \tparam N The rank, or \c 0 when the rank is only known at run time
+    template <unsigned int N>
+    struct BlockOrdinal {
+      static TILEDARRAY_FORCE_INLINE ordinal_type
+      eval(const unsigned int rank, ordinal_type index,
+          const size_type* restrict const size,
+          const size_type* restrict const stride)
+      {
+        ordinal_type result = 0ul;
+        detail::rank_for_reverse<N>(rank, [&] (const unsigned int i) {
+          const auto size_i = size[i];
+          result += (index % size_i) * stride[i];
+          index /= size_i;
+        });
+        return result;
+      }
+    }; // struct BlockOrdinal
+
 
     template <typename Index>
     void init(const Range& range, const Index& lower_bound, const Index& upper_bound) {
@@ -53,10 +73,9 @@ namespace TiledArray {
           [](const size_type l, const size_type r) { return l <= r; }));
 
       // Initialize the block range data members
-      data_ = new size_type[range.rank() << 2];
+      alloc_data(range.rank());
       offset_ = range.offset();
       volume_ = 1ul;
-      rank_ = range.rank();
       block_offset_ = 0ul;
 
       // Construct temp pointers
@@ -148,22 +167,13 @@ namespace TiledArray {
       // Check that index is contained by range.
       TA_ASSERT(includes(index));
 
-      // Construct result coordinate index object and allocate its memory.
-      ordinal_type result = 0ul;
-
       // Get pointers to the data
       const auto * restrict const size = data_ + rank_ + rank_;
       const auto * restrict const stride = size + rank_;
 
-      // Compute the coordinate index of o in range.
-      for(int i = int(rank_) - 1; i >= 0; --i) {
-        const auto size_i = size[i];
-        const auto stride_i = stride[i];
-
-        // Compute result index element i
-        result += (index % size_i) * stride_i;
-        index /= size_i;
-      }
+      // Compute the ordinal offset of index in the parent range.
+      const ordinal_type result =
+          detail::fixed_rank_eval<BlockOrdinal>(rank_, index, size, stride);
 
       return result + block_offset_ - offset_;
     }
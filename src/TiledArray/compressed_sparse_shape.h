@@ -0,0 +1,1187 @@
+/*
+ *  This file is a part of TiledArray.
+ *  Copyright (C) 2016  Virginia Tech
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef TILEDARRAY_COMPRESSED_SPARSE_SHAPE_H__INCLUDED
+#define TILEDARRAY_COMPRESSED_SPARSE_SHAPE_H__INCLUDED
+
+#include <TiledArray/sparse_shape.h>
+#include <TiledArray/perm_index.h>
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+namespace TiledArray {
+
+  /// Sparse shape that stores only the non-zero tile norms
+
+  /// \c SparseShape stores the norm of every tile in a dense tensor, which is
+  /// replicated on every process and summed over all processes when the
+  /// shape is constructed. For arrays with a very large number of tiles,
+  /// most of which are zero, this shape stores the ordinal indices and
+  /// normalized norms of the non-zero tiles only, sorted by ordinal index,
+  /// and the shape operations work on the compressed data directly. The norm
+  /// data is normalized and screened exactly as in \c SparseShape , and the
+  /// zero threshold is shared with <tt>SparseShape<T></tt>.
+  /// \tparam T The sparse element value type
+  template <typename T>
+  class CompressedSparseShape {
+  public:
+    typedef CompressedSparseShape<T> CompressedSparseShape_; ///< This object type
+    typedef T value_type; ///< The norm value type
+    typedef typename Tensor<value_type>::size_type size_type;  ///< Size type
+    typedef std::pair<size_type, value_type> nonzero_type;
+        ///< An ordinal index and tile norm pair
+
+  private:
+
+    // T must be a numeric type
+    static_assert(std::is_floating_point<T>::value,
+        "CompressedSparseShape template type T must be a floating point type");
+
+    // Internal typedefs
+    typedef detail::ValArray<value_type> vector_type;
+
+    /// Compressed norm data
+    struct NormData {
+      std::vector<size_type> ordinals; ///< Sorted ordinals of the non-zero tiles
+      std::vector<value_type> norms; ///< Normalized norms of the non-zero tiles
+
+      void reserve(const size_type n) {
+        ordinals.reserve(n);
+        norms.reserve(n);
+      }
+
+      void push_back(const size_type ordinal, const value_type norm) {
+        ordinals.push_back(ordinal);
+        norms.push_back(norm);
+      }
+
+      size_type size() const { return ordinals.size(); }
+    }; // struct NormData
+
+    Range range_; ///< The tiles range
+    std::shared_ptr<const NormData> data_; ///< Non-zero tile norms
+    std::shared_ptr<vector_type> size_vectors_; ///< Tile size information
+
+    static std::shared_ptr<vector_type>
+    initialize_size_vectors(const TiledRange& trange) {
+      // Allocate memory for size vectors
+      const unsigned int dim = trange.tiles_range().rank();
+      std::shared_ptr<vector_type> size_vectors(new vector_type[dim],
+          std::default_delete<vector_type[]>());
+
+      // Initialize the size vectors
+      for(unsigned int i = 0ul; i != dim; ++i) {
+        const size_type n = trange.data()[i].tiles_range().second - trange.data()[i].tiles_range().first;
+
+        size_vectors.get()[i] = vector_type(n, & (* trange.data()[i].begin()),
+            [] (const TiledRange1::range_type& tile)
+            { return value_type(tile.second - tile.first); });
+      }
+
+      return size_vectors;
+    }
+
+    std::shared_ptr<vector_type> perm_size_vectors(const Permutation& perm) const {
+      const unsigned int n = range_.rank();
+
+      // Allocate memory for the contracted size vectors
+      std::shared_ptr<vector_type> result_size_vectors(new vector_type[n],
+          std::default_delete<vector_type[]>());
+
+      // Initialize the size vectors
+      for(unsigned int i = 0u; i < n; ++i) {
+        const unsigned int perm_i = perm[i];
+        result_size_vectors.get()[perm_i] = size_vectors_.get()[i];
+      }
+
+      return result_size_vectors;
+    }
+
+    /// The number of elements in a tile
+
+    /// \param range The tiles range
+    /// \param size_vectors The tile sizes of each dimension of \c range
+    /// \param ordinal The ordinal index of the tile in \c range
+    /// \return The volume of the tile
+    static value_type tile_volume(const Range& range,
+        const vector_type* restrict const size_vectors, size_type ordinal)
+    {
+      const unsigned int rank = range.rank();
+      const auto* restrict const stride = range.stride_data();
+      value_type volume = value_type(1);
+      for(unsigned int i = 0u; i < rank; ++i) {
+        const size_type stride_i = stride[i];
+        volume *= size_vectors[i][ordinal / stride_i];
+        ordinal %= stride_i;
+      }
+      return volume;
+    }
+
+    /// Sum, normalize, and screen unsorted tile norms
+
+    /// \param tile_norms Pairs of ordinal indices and tile norms, where the
+    /// norms of repeated ordinal indices are summed. \c tile_norms is sorted
+    /// by this function.
+    /// \return The compressed data of the normalized norms
+    std::shared_ptr<NormData>
+    normalize(std::vector<nonzero_type>& tile_norms) const {
+      std::sort(tile_norms.begin(), tile_norms.end(),
+          [] (const nonzero_type& left, const nonzero_type& right)
+          { return left.first < right.first; });
+
+      const value_type threshold = SparseShape<T>::threshold();
+      const vector_type* restrict const size_vectors = size_vectors_.get();
+      std::shared_ptr<NormData> result = std::make_shared<NormData>();
+
+      auto it = tile_norms.begin();
+      const auto end = tile_norms.end();
+      while(it != end) {
+        const size_type ordinal = it->first;
+        TA_ASSERT(ordinal < range_.volume());
+        value_type norm = value_type(0);
+        for(; (it != end) && (it->first == ordinal); ++it) {
+          TA_ASSERT(it->second >= value_type(0));
+          norm += it->second;
+        }
+
+        norm /= tile_volume(range_, size_vectors, ordinal);
+        if(norm >= threshold)
+          result->push_back(ordinal, norm);
+      }
+
+      return result;
+    }
+
+    /// Collect the non-zero tile norms of a dense tensor
+
+    /// \param tile_norms The tile norms
+    /// \return The ordinal index and norm of each non-zero element of
+    /// \c tile_norms
+    static std::vector<nonzero_type>
+    nonzeros(const Tensor<value_type>& tile_norms) {
+      std::vector<nonzero_type> result;
+      const value_type* restrict const data = tile_norms.data();
+      const size_type n = tile_norms.size();
+      for(size_type i = 0ul; i < n; ++i)
+        if(data[i] != value_type(0))
+          result.emplace_back(i, data[i]);
+      return result;
+    }
+
+    /// Gather the tile norms of all processes
+
+    /// Only the non-zero norms are communicated, so the amount of data that
+    /// is reduced is proportional to the total number of non-zero tiles
+    /// rather than the number of tiles.
+    /// \param world The world where the shape will live
+    /// \param tile_norms The local tile norms, which are replaced by the
+    /// tile norms of all processes
+    static void all_gather(World& world, std::vector<nonzero_type>& tile_norms) {
+      const std::size_t nproc = world.size();
+      const std::size_t rank = world.rank();
+
+      // Compute the offset of the local data in the global buffer
+      std::vector<size_type> counts(nproc, 0ul);
+      counts[rank] = tile_norms.size();
+      world.gop.sum(counts.data(), nproc);
+      size_type offset = 0ul, total = 0ul;
+      for(std::size_t p = 0ul; p < nproc; ++p) {
+        if(p < rank)
+          offset += counts[p];
+        total += counts[p];
+      }
+
+      if(total == 0ul) {
+        tile_norms.clear();
+        return;
+      }
+
+      // Sum the ordinals and norms of all processes, where each process owns
+      // a disjoint segment of the buffers.
+      std::vector<size_type> ordinals(total, 0ul);
+      std::vector<value_type> norms(total, value_type(0));
+      for(size_type i = 0ul; i < tile_norms.size(); ++i) {
+        ordinals[offset + i] = tile_norms[i].first;
+        norms[offset + i] = tile_norms[i].second;
+      }
+      world.gop.sum(ordinals.data(), total);
+      world.gop.sum(norms.data(), total);
+
+      tile_norms.clear();
+      tile_norms.reserve(total);
+      for(size_type i = 0ul; i < total; ++i)
+        tile_norms.emplace_back(ordinals[i], norms[i]);
+    }
+
+    /// Find the position of a tile in the compressed data
+
+    /// \param ordinal The ordinal index of the tile
+    /// \return The position of the tile in the compressed data, or
+    /// <tt>nnz()</tt> when the tile is zero
+    size_type find(const size_type ordinal) const {
+      const auto& ordinals = data_->ordinals;
+      const auto it = std::lower_bound(ordinals.begin(), ordinals.end(), ordinal);
+      return ((it != ordinals.end()) && (*it == ordinal) ?
+          it - ordinals.begin() : ordinals.size());
+    }
+
+    CompressedSparseShape(const Range& range,
+        const std::shared_ptr<const NormData>& data,
+        const std::shared_ptr<vector_type>& size_vectors) :
+      range_(range), data_(data), size_vectors_(size_vectors)
+    { }
+
+  public:
+
+    /// Default constructor
+
+    /// Construct a shape with no data.
+    CompressedSparseShape() : range_(), data_(), size_vectors_() { }
+
+    /// Constructor
+
+    /// This constructor will normalize the tile norm, where the normalization
+    /// constant for each tile is the inverse of the number of elements in the
+    /// tile.
+    /// \param tile_norms The Frobenius norm of tiles
+    /// \param trange The tiled range of the tensor
+    CompressedSparseShape(const Tensor<value_type>& tile_norms,
+        const TiledRange& trange) :
+      range_(trange.tiles_range()), data_(),
+      size_vectors_(initialize_size_vectors(trange))
+    {
+      TA_ASSERT(! tile_norms.empty());
+      TA_ASSERT(tile_norms.range() == trange.tiles_range());
+
+      std::vector<nonzero_type> nonzero_norms = nonzeros(tile_norms);
+      data_ = normalize(nonzero_norms);
+    }
+
+    /// Collective constructor
+
+    /// This constructor will sum the tile_norms data across all processes.
+    /// Only the non-zero elements of \c tile_norms are communicated. After
+    /// the norms have been summed, they are normalized, where the
+    /// normalization constant for each tile is the inverse of the number of
+    /// elements in the tile.
+    /// \param world The world where the shape will live
+    /// \param tile_norms The Frobenius norm of tiles
+    /// \param trange The tiled range of the tensor
+    CompressedSparseShape(World& world, const Tensor<value_type>& tile_norms,
+        const TiledRange& trange) :
+      range_(trange.tiles_range()), data_(),
+      size_vectors_(initialize_size_vectors(trange))
+    {
+      TA_ASSERT(! tile_norms.empty());
+      TA_ASSERT(tile_norms.range() == trange.tiles_range());
+
+      std::vector<nonzero_type> nonzero_norms = nonzeros(tile_norms);
+      all_gather(world, nonzero_norms);
+      data_ = normalize(nonzero_norms);
+    }
+
+    /// Sparse constructor
+
+    /// Construct a shape from the norms of the non-zero tiles, so that a
+    /// dense norm tensor is never allocated. Norms of repeated ordinal
+    /// indices are summed, and the norms are normalized as in the dense
+    /// constructor.
+    /// \param tile_norms Pairs of ordinal indices, in the tiles range of
+    /// \c trange , and the Frobenius norms of tiles
+    /// \param trange The tiled range of the tensor
+    CompressedSparseShape(std::vector<nonzero_type> tile_norms,
+        const TiledRange& trange) :
+      range_(trange.tiles_range()), data_(),
+      size_vectors_(initialize_size_vectors(trange))
+    {
+      data_ = normalize(tile_norms);
+    }
+
+    /// Sparse, collective constructor
+
+    /// Construct a shape from the norms of the non-zero tiles of all
+    /// processes, so that a dense norm tensor is never allocated. Norms of
+    /// repeated ordinal indices are summed, and the norms are normalized as
+    /// in the dense constructor.
+    /// \param world The world where the shape will live
+    /// \param tile_norms Pairs of ordinal indices, in the tiles range of
+    /// \c trange , and the Frobenius norms of the local tiles
+    /// \param trange The tiled range of the tensor
+    CompressedSparseShape(World& world, std::vector<nonzero_type> tile_norms,
+        const TiledRange& trange) :
+      range_(trange.tiles_range()), data_(),
+      size_vectors_(initialize_size_vectors(trange))
+    {
+      all_gather(world, tile_norms);
+      data_ = normalize(tile_norms);
+    }
+
+    /// Copy constructor
+
+    /// Shallow copy of \c other.
+    /// \param other The other shape object to be copied
+    CompressedSparseShape(const CompressedSparseShape_& other) :
+      range_(other.range_), data_(other.data_),
+      size_vectors_(other.size_vectors_)
+    { }
+
+    /// Copy assignment operator
+
+    /// Shallow copy of \c other.
+    /// \param other The other shape object to be copied
+    /// \return A reference to this object.
+    CompressedSparseShape_& operator=(const CompressedSparseShape_& other) {
+      range_ = other.range_;
+      data_ = other.data_;
+      size_vectors_ = other.size_vectors_;
+      return *this;
+    }
+
+    /// Validate shape range
+
+    /// \return \c true when range matches the range of this shape
+    bool validate(const Range& range) const {
+      if(! data_)
+        return false;
+      return (range == range_);
+    }
+
+    /// Check that a tile is zero
+
+    /// \tparam Index The type of the index
+    /// \return \c true when the tile at \c i is zero
+    template <typename Index>
+    bool is_zero(const Index& i) const {
+      TA_ASSERT(data_);
+      return find(range_.ordinal(i)) == data_->size();
+    }
+
+    /// Check density
+
+    /// \return false
+    static constexpr bool is_dense() { return false; }
+
+    /// Sparsity of the shape
+
+    /// \return The fraction of tiles that are zero.
+    float sparsity() const {
+      TA_ASSERT(data_);
+      return float(range_.volume() - data_->size()) / float(range_.volume());
+    }
+
+    /// The number of non-zero tiles
+
+    /// \return The number of tiles with a norm that is not less than the
+    /// zero threshold
+    size_type nnz() const {
+      TA_ASSERT(data_);
+      return data_->size();
+    }
+
+    /// Threshold accessor
+
+    /// \return The current threshold, which is shared with \c SparseShape
+    static value_type threshold() { return SparseShape<T>::threshold(); }
+
+    /// Set threshold to \c thresh
+
+    /// \param thresh The new threshold
+    static void threshold(const value_type thresh) { SparseShape<T>::threshold(thresh); }
+
+    /// Tile norm accessor
+
+    /// \tparam Index The index type
+    /// \param index The index of the tile norm to retrieve
+    /// \return The norm of the tile at \c index
+    template <typename Index>
+    value_type operator[](const Index& index) const {
+      TA_ASSERT(data_);
+      const size_type i = find(range_.ordinal(index));
+      return (i < data_->size() ? data_->norms[i] : value_type(0));
+    }
+
+    /// Transform the non-zero tile norms with an operation
+
+    /// The operation is applied to the compressed norms only, so zero tiles
+    /// remain zero and a dense norm tensor is never allocated.
+    /// Op should take a const ref to a std::vector<T> that contains the
+    /// norms of the non-zero tiles, in the order of \c nonzero_ordinals() ,
+    /// and return a std::vector<T> of the same size.
+    /// The output norms are not normalized, and tiles with an output norm
+    /// that is less than the zero threshold are removed from the result.
+    /// \return A deep copy of the norms of the object having
+    /// performed the operation Op.
+    template <typename Op>
+    CompressedSparseShape_ transform(Op&& op) const {
+      TA_ASSERT(data_);
+      const std::vector<value_type> new_norms = op(data_->norms);
+      TA_ASSERT(new_norms.size() == data_->size());
+
+      const value_type threshold = SparseShape<T>::threshold();
+      std::shared_ptr<NormData> result = std::make_shared<NormData>();
+      result->reserve(new_norms.size());
+      for(size_type i = 0ul; i < new_norms.size(); ++i) {
+        TA_ASSERT(new_norms[i] >= value_type(0));
+        if(new_norms[i] >= threshold)
+          result->push_back(data_->ordinals[i], new_norms[i]);
+      }
+
+      return CompressedSparseShape_(range_, result, size_vectors_);
+    }
+
+    /// Dense norm accessor
+
+    /// The compressed norms are expanded into a tensor with one element per
+    /// tile, so this function requires memory for the dense norm tensor. Use
+    /// \c nonzero_ordinals() and \c nonzero_norms() to access the norms
+    /// without expanding them.
+    /// \return A dense \c Tensor object that contains the normalized tile
+    /// norms
+    Tensor<value_type> dense_data() const {
+      TA_ASSERT(data_);
+      Tensor<value_type> result(range_, value_type(0));
+      value_type* restrict const norms = result.data();
+      for(size_type i = 0ul; i < data_->size(); ++i)
+        norms[data_->ordinals[i]] = data_->norms[i];
+      return result;
+    }
+
+    /// Ordinal indices of the non-zero tiles
+
+    /// \return A sorted vector of the ordinal indices of the non-zero tiles
+    const std::vector<size_type>& nonzero_ordinals() const {
+      TA_ASSERT(data_);
+      return data_->ordinals;
+    }
+
+    /// Norms of the non-zero tiles
+
+    /// \return A vector of the normalized norms of the non-zero tiles, in
+    /// the order of \c nonzero_ordinals()
+    const std::vector<value_type>& nonzero_norms() const {
+      TA_ASSERT(data_);
+      return data_->norms;
+    }
+
+    /// Initialization check
+
+    /// \return \c true when this shape has been initialized.
+    bool empty() const { return ! data_; }
+
+    /// Compute union of two shapes
+
+    /// \param mask_shape The input shape, hard zeros are used to mask the output.
+    /// \return A shape that is masked by the mask.
+    CompressedSparseShape_ mask(const CompressedSparseShape_& mask_shape) const {
+      TA_ASSERT(data_);
+      TA_ASSERT(mask_shape.data_);
+      TA_ASSERT(range_ == mask_shape.range_);
+
+      const NormData& left = *data_;
+      const NormData& right = *mask_shape.data_;
+      std::shared_ptr<NormData> result = std::make_shared<NormData>();
+      result->reserve(std::min(left.size(), right.size()));
+
+      for(size_type i = 0ul, j = 0ul; (i < left.size()) && (j < right.size()); ) {
+        if(left.ordinals[i] < right.ordinals[j]) {
+          ++i;
+        } else if(right.ordinals[j] < left.ordinals[i]) {
+          ++j;
+        } else {
+          result->push_back(left.ordinals[i], left.norms[i]);
+          ++i;
+          ++j;
+        }
+      }
+
+      return CompressedSparseShape_(range_, result, size_vectors_);
+    }
+
+    /// Update sub-block of shape
+
+    /// Update a sub-block shape information with another shape object.
+    /// \tparam Index The bound index type
+    /// \param lower_bound The lower bound of the sub-block to be updated
+    /// \param upper_bound The upper bound of the sub-block to be updated
+    /// \param other The shape that will be used to update the sub-block
+    /// \return A new sparse shape object where the specified sub-block
+    /// contains the data of \c other.
+    template <typename Index>
+    CompressedSparseShape_ update_block(const Index& lower_bound,
+        const Index& upper_bound, const CompressedSparseShape_& other) const
+    {
+      TA_ASSERT(data_);
+      TA_ASSERT(other.data_);
+      TA_ASSERT(detail::size(lower_bound) == range_.rank());
+      TA_ASSERT(detail::size(upper_bound) == range_.rank());
+      TA_ASSERT(other.range_.rank() == range_.rank());
+
+      const unsigned int rank = range_.rank();
+      const auto* restrict const lower = detail::data(lower_bound);
+      const auto* restrict const upper = detail::data(upper_bound);
+      const auto* restrict const lobound = range_.lobound_data();
+      const auto* restrict const stride = range_.stride_data();
+      const auto* restrict const other_stride = other.range_.stride_data();
+
+      // Keep the tiles of this shape that are outside the block
+      const NormData& arg = *data_;
+      NormData outside;
+      outside.reserve(arg.size());
+      for(size_type i = 0ul; i < arg.size(); ++i) {
+        size_type ordinal = arg.ordinals[i];
+        bool in_block = true;
+        for(unsigned int d = 0u; d < rank; ++d) {
+          const size_type index_d = ordinal / stride[d] + lobound[d];
+          ordinal %= stride[d];
+          if((index_d < size_type(lower[d])) || (index_d >= size_type(upper[d]))) {
+            in_block = false;
+            break;
+          }
+        }
+        if(! in_block)
+          outside.push_back(arg.ordinals[i], arg.norms[i]);
+      }
+
+      // Map the tiles of other into the range of this shape
+      const NormData& block = *other.data_;
+      std::vector<size_type> block_ordinals;
+      block_ordinals.reserve(block.size());
+      for(size_type i = 0ul; i < block.size(); ++i) {
+        size_type ordinal = block.ordinals[i];
+        size_type result_ordinal = 0ul;
+        for(unsigned int d = 0u; d < rank; ++d) {
+          TA_ASSERT(size_type(upper[d] - lower[d]) == other.range_.extent_data()[d]);
+          const size_type index_d = ordinal / other_stride[d] + lower[d];
+          ordinal %= other_stride[d];
+          result_ordinal += (index_d - lobound[d]) * stride[d];
+        }
+        block_ordinals.push_back(result_ordinal);
+      }
+
+      // Merge the two sets of tiles, which are both sorted
+      std::shared_ptr<NormData> result = std::make_shared<NormData>();
+      result->reserve(outside.size() + block.size());
+      size_type i = 0ul, j = 0ul;
+      while((i < outside.size()) || (j < block.size())) {
+        if((j == block.size()) ||
+            ((i < outside.size()) && (outside.ordinals[i] < block_ordinals[j])))
+        {
+          result->push_back(outside.ordinals[i], outside.norms[i]);
+          ++i;
+        } else {
+          result->push_back(block_ordinals[j], block.norms[j]);
+          ++j;
+        }
+      }
+
+      return CompressedSparseShape_(range_, result, size_vectors_);
+    }
+
+  private:
+
+    /// Create a copy of a sub-block of the shape
+
+    /// \tparam Index The upper and lower bound array type
+    /// \param lower_bound The lower bound of the sub-block
+    /// \param upper_bound The upper bound of the sub-block
+    /// \param abs_factor The scaling factor
+    template <typename Index>
+    CompressedSparseShape_ scaled_block(const Index& lower_bound,
+        const Index& upper_bound, const value_type abs_factor) const
+    {
+      TA_ASSERT(data_);
+      TA_ASSERT(detail::size(lower_bound) == range_.rank());
+      TA_ASSERT(detail::size(upper_bound) == range_.rank());
+
+      const unsigned int rank = range_.rank();
+      const auto* restrict const lower = detail::data(lower_bound);
+      const auto* restrict const upper = detail::data(upper_bound);
+      const auto* restrict const lobound = range_.lobound_data();
+      const auto* restrict const stride = range_.stride_data();
+
+      // Construct the block range and size vectors
+      std::vector<size_type> extent(rank);
+      std::shared_ptr<vector_type> size_vectors(new vector_type[rank],
+          std::default_delete<vector_type[]>());
+      for(unsigned int d = 0u; d < rank; ++d) {
+        const auto lower_d = lower[d];
+        const auto upper_d = upper[d];
+
+        // Check that the input indices are in range
+        TA_ASSERT(lower_d < upper_d);
+        TA_ASSERT(size_type(lower_d) >= range_.lobound_data()[d]);
+        TA_ASSERT(size_type(upper_d) <= range_.upbound_data()[d]);
+
+        extent[d] = upper_d - lower_d;
+        size_vectors.get()[d] = vector_type(extent[d],
+            size_vectors_.get()[d].data() + (lower_d - lobound[d]));
+      }
+      const Range result_range(extent);
+      const auto* restrict const result_stride = result_range.stride_data();
+
+      // Copy the tiles that are inside the block. The result ordinals are
+      // sorted since the block is traversed in row-major order.
+      const value_type threshold = SparseShape<T>::threshold();
+      const NormData& arg = *data_;
+      std::shared_ptr<NormData> result = std::make_shared<NormData>();
+      for(size_type i = 0ul; i < arg.size(); ++i) {
+        size_type ordinal = arg.ordinals[i];
+        size_type result_ordinal = 0ul;
+        bool in_block = true;
+        for(unsigned int d = 0u; d < rank; ++d) {
+          const size_type index_d = ordinal / stride[d] + lobound[d];
+          ordinal %= stride[d];
+          if((index_d < size_type(lower[d])) || (index_d >= size_type(upper[d]))) {
+            in_block = false;
+            break;
+          }
+          result_ordinal += (index_d - lower[d]) * result_stride[d];
+        }
+
+        if(in_block) {
+          const value_type norm = arg.norms[i] * abs_factor;
+          if(norm >= threshold)
+            result->push_back(result_ordinal, norm);
+        }
+      }
+
+      return CompressedSparseShape_(result_range, result, size_vectors);
+    }
+
+  public:
+
+    /// Create a copy of a sub-block of the shape
+
+    /// \tparam Index The upper and lower bound array type
+    /// \param lower_bound The lower bound of the sub-block
+    /// \param upper_bound The upper bound of the sub-block
+    template <typename Index>
+    CompressedSparseShape_ block(const Index& lower_bound,
+        const Index& upper_bound) const
+    {
+      return scaled_block(lower_bound, upper_bound, value_type(1));
+    }
+
+    /// Create a scaled sub-block of the shape
+
+    /// \tparam Index The upper and lower bound array type
+    /// \tparam Factor The scaling factor type
+    /// \note expression abs(Factor) must be well defined (by default, std::abs will be used)
+    /// \param lower_bound The lower bound of the sub-block
+    /// \param upper_bound The upper bound of the sub-block
+    /// \param factor The scaling factor
+    template <typename Index, typename Factor>
+    CompressedSparseShape_ block(const Index& lower_bound,
+        const Index& upper_bound, const Factor factor) const
+    {
+      return scaled_block(lower_bound, upper_bound, to_abs_factor(factor));
+    }
+
+    /// Create a permuted copy of a sub-block of the shape
+
+    /// \param lower_bound The lower bound of the sub-block
+    /// \param upper_bound The upper bound of the sub-block
+    /// \param perm The permutation to be applied
+    template <typename Index>
+    CompressedSparseShape_ block(const Index& lower_bound,
+        const Index& upper_bound, const Permutation& perm) const
+    {
+      return block(lower_bound, upper_bound).perm(perm);
+    }
+
+    /// Create a scaled and permuted copy of a sub-block of the shape
+
+    /// \tparam Factor The scaling factor type
+    /// \note expression abs(Factor) must be well defined (by default, std::abs will be used)
+    /// \param lower_bound The lower bound of the sub-block
+    /// \param upper_bound The upper bound of the sub-block
+    /// \param factor The scaling factor
+    /// \param perm The permutation to be applied
+    template <typename Index, typename Factor>
+    CompressedSparseShape_ block(const Index& lower_bound,
+        const Index& upper_bound, const Factor factor,
+        const Permutation& perm) const
+    {
+      return block(lower_bound, upper_bound, factor).perm(perm);
+    }
+
+    /// Create a permuted shape of this shape
+
+    /// \param perm The permutation to be applied
+    /// \return A new, permuted shape
+    CompressedSparseShape_ perm(const Permutation& perm) const {
+      TA_ASSERT(data_);
+      TA_ASSERT(perm.dim() == range_.rank());
+
+      // Permute the ordinal indices
+      const detail::PermIndex perm_index(range_, perm);
+      const NormData& arg = *data_;
+      std::vector<nonzero_type> tile_norms;
+      tile_norms.reserve(arg.size());
+      for(size_type i = 0ul; i < arg.size(); ++i)
+        tile_norms.emplace_back(perm_index(arg.ordinals[i]), arg.norms[i]);
+      std::sort(tile_norms.begin(), tile_norms.end(),
+          [] (const nonzero_type& left, const nonzero_type& right)
+          { return left.first < right.first; });
+
+      std::shared_ptr<NormData> result = std::make_shared<NormData>();
+      result->reserve(tile_norms.size());
+      for(const auto& tile_norm : tile_norms)
+        result->push_back(tile_norm.first, tile_norm.second);
+
+      return CompressedSparseShape_(perm * range_, result,
+          perm_size_vectors(perm));
+    }
+
+    /// Scale shape
+
+    /// Construct a new scaled shape as:
+    /// \f[
+    /// {(\rm{result})}_{ij...} = |(\rm{factor})| (\rm{this})_{ij...}
+    /// \f]
+    /// \tparam Factor The scaling factor type
+    /// \note expression abs(Factor) must be well defined (by default, std::abs will be used)
+    /// \param factor The scaling factor
+    /// \return A new, scaled shape
+    template <typename Factor>
+    CompressedSparseShape_ scale(const Factor factor) const {
+      TA_ASSERT(data_);
+      const value_type threshold = SparseShape<T>::threshold();
+      const value_type abs_factor = to_abs_factor(factor);
+
+      const NormData& arg = *data_;
+      std::shared_ptr<NormData> result = std::make_shared<NormData>();
+      result->reserve(arg.size());
+      for(size_type i = 0ul; i < arg.size(); ++i) {
+        const value_type norm = arg.norms[i] * abs_factor;
+        if(norm >= threshold)
+          result->push_back(arg.ordinals[i], norm);
+      }
+
+      return CompressedSparseShape_(range_, result, size_vectors_);
+    }
+
+    /// Scale and permute shape
+
+    /// Compute a new scaled shape is computed as:
+    /// \f[
+    /// {(\rm{result})}_{ji...} = \rm{perm}(j,i) |(\rm{factor})| (\rm{this})_{ij...}
+    /// \f]
+    /// \tparam Factor The scaling factor type
+    /// \note expression abs(Factor) must be well defined (by default, std::abs will be used)
+    /// \param factor The scaling factor
+    /// \param perm The permutation that will be applied to this tensor.
+    /// \return A new, scaled-and-permuted shape
+    template <typename Factor>
+    CompressedSparseShape_ scale(const Factor factor, const Permutation& perm) const {
+      return scale(factor).perm(perm);
+    }
+
+  private:
+
+    /// Sum of two compressed shapes
+
+    /// \param other The shape to be added to this shape
+    /// \param abs_factor The scaling factor that is applied to the sum
+    /// \return A scaled sum of shapes
+    CompressedSparseShape_ scaled_add(const CompressedSparseShape_& other,
+        const value_type abs_factor) const
+    {
+      TA_ASSERT(data_);
+      TA_ASSERT(other.data_);
+      TA_ASSERT(range_ == other.range_);
+
+      const value_type threshold = SparseShape<T>::threshold();
+      const NormData& left = *data_;
+      const NormData& right = *other.data_;
+      std::shared_ptr<NormData> result = std::make_shared<NormData>();
+      result->reserve(left.size() + right.size());
+
+      size_type i = 0ul, j = 0ul;
+      while((i < left.size()) || (j < right.size())) {
+        size_type ordinal = 0ul;
+        value_type norm = value_type(0);
+        if((j == right.size()) ||
+            ((i < left.size()) && (left.ordinals[i] < right.ordinals[j])))
+        {
+          ordinal = left.ordinals[i];
+          norm = left.norms[i++];
+        } else if((i == left.size()) || (right.ordinals[j] < left.ordinals[i])) {
+          ordinal = right.ordinals[j];
+          norm = right.norms[j++];
+        } else {
+          ordinal = left.ordinals[i];
+          norm = left.norms[i++] + right.norms[j++];
+        }
+
+        norm *= abs_factor;
+        if(norm >= threshold)
+          result->push_back(ordinal, norm);
+      }
+
+      return CompressedSparseShape_(range_, result, size_vectors_);
+    }
+
+  public:
+
+    /// Add shapes
+
+    /// Construct a new sum of shapes as:
+    /// \f[
+    /// {(\rm{result})}_{ij...} = (\rm{this})_{ij...} + (\rm{other})_{ij...}
+    /// \f]
+    /// \param other The shape to be added to this shape
+    /// \return A sum of shapes
+    CompressedSparseShape_ add(const CompressedSparseShape_& other) const {
+      return scaled_add(other, value_type(1));
+    }
+
+    /// Add and permute shapes
+
+    /// Construct a new sum of shapes as:
+    /// \f[
+    /// {(\rm{result})}_{ji...} = \rm{perm}(i,j) (\rm{this})_{ij...} + (\rm{other})_{ij...}
+    /// \f]
+    /// \param other The shape to be added to this shape
+    /// \param perm The permutation that is applied to the result
+    /// \return the new shape, equals \c this + \c other
+    CompressedSparseShape_ add(const CompressedSparseShape_& other,
+        const Permutation& perm) const
+    {
+      return add(other).perm(perm);
+    }
+
+    /// Add and scale shapes
+
+    /// Construct a new sum of shapes as:
+    /// \f[
+    /// {(\rm{result})}_{ij...} = |(\rm{factor})| ((\rm{this})_{ij...} + (\rm{other})_{ij...})
+    /// \f]
+    /// \tparam Factor The scaling factor type
+    /// \note expression abs(Factor) must be well defined (by default, std::abs will be used)
+    /// \param other The shape to be added to this shape
+    /// \param factor The scaling factor
+    /// \return A scaled sum of shapes
+    template <typename Factor>
+    CompressedSparseShape_ add(const CompressedSparseShape_& other,
+        const Factor factor) const
+    {
+      return scaled_add(other, to_abs_factor(factor));
+    }
+
+    /// Add, scale, and permute shapes
+
+    /// Construct a new sum of shapes as:
+    /// \f[
+    /// {(\rm{result})}_{ij...} = |(\rm{factor})| ((\rm{this})_{ij...} + (\rm{other})_{ij...})
+    /// \f]
+    /// \tparam Factor The scaling factor type
+    /// \note expression abs(Factor) must be well defined (by default, std::abs will be used)
+    /// \param other The shape to be added to this shape
+    /// \param factor The scaling factor
+    /// \param perm The permutation that is applied to the result
+    /// \return A scaled and permuted sum of shapes
+    template <typename Factor>
+    CompressedSparseShape_ add(const CompressedSparseShape_& other,
+        const Factor factor, const Permutation& perm) const
+    {
+      return add(other, factor).perm(perm);
+    }
+
+    /// Add a constant to the shape
+
+    /// Adding a constant makes every tile non-zero in general, so this
+    /// operation visits every tile.
+    /// \param value The constant to be added
+    /// \return The new shape
+    CompressedSparseShape_ add(value_type value) const {
+      TA_ASSERT(data_);
+      const value_type threshold = SparseShape<T>::threshold();
+      const vector_type* restrict const size_vectors = size_vectors_.get();
+      value = std::abs(value);
+
+      const NormData& arg = *data_;
+      std::shared_ptr<NormData> result = std::make_shared<NormData>();
+      const size_type n = range_.volume();
+      for(size_type ordinal = 0ul, i = 0ul; ordinal < n; ++ordinal) {
+        value_type norm = value /
+            std::sqrt(tile_volume(range_, size_vectors, ordinal));
+        if((i < arg.size()) && (arg.ordinals[i] == ordinal))
+          norm += arg.norms[i++];
+        if(norm >= threshold)
+          result->push_back(ordinal, norm);
+      }
+
+      return CompressedSparseShape_(range_, result, size_vectors_);
+    }
+
+    CompressedSparseShape_ add(const value_type value, const Permutation& perm) const {
+      return add(value).perm(perm);
+    }
+
+    CompressedSparseShape_ subt(const CompressedSparseShape_& other) const {
+      return add(other);
+    }
+
+    CompressedSparseShape_ subt(const CompressedSparseShape_& other,
+        const Permutation& perm) const
+    {
+      return add(other, perm);
+    }
+
+    template <typename Factor>
+    CompressedSparseShape_ subt(const CompressedSparseShape_& other,
+        const Factor factor) const
+    {
+      return add(other, factor);
+    }
+
+    template <typename Factor>
+    CompressedSparseShape_ subt(const CompressedSparseShape_& other,
+        const Factor factor, const Permutation& perm) const
+    {
+      return add(other, factor, perm);
+    }
+
+    CompressedSparseShape_ subt(const value_type value) const {
+      return add(value);
+    }
+
+    CompressedSparseShape_ subt(const value_type value, const Permutation& perm) const {
+      return add(value, perm);
+    }
+
+  private:
+
+    /// Hadamard product of two compressed shapes
+
+    /// \param other The right-hand shape
+    /// \param abs_factor The scaling factor
+    /// \return A scaled product of shapes
+    CompressedSparseShape_ scaled_mult(const CompressedSparseShape_& other,
+        const value_type abs_factor) const
+    {
+      TA_ASSERT(data_);
+      TA_ASSERT(other.data_);
+      TA_ASSERT(range_ == other.range_);
+
+      const value_type threshold = SparseShape<T>::threshold();
+      const vector_type* restrict const size_vectors = size_vectors_.get();
+      const NormData& left = *data_;
+      const NormData& right = *other.data_;
+      std::shared_ptr<NormData> result = std::make_shared<NormData>();
+
+      for(size_type i = 0ul, j = 0ul; (i < left.size()) && (j < right.size()); ) {
+        if(left.ordinals[i] < right.ordinals[j]) {
+          ++i;
+        } else if(right.ordinals[j] < left.ordinals[i]) {
+          ++j;
+        } else {
+          const size_type ordinal = left.ordinals[i];
+          const value_type norm = left.norms[i] * right.norms[j] * abs_factor *
+              tile_volume(range_, size_vectors, ordinal);
+          if(norm >= threshold)
+            result->push_back(ordinal, norm);
+          ++i;
+          ++j;
+        }
+      }
+
+      return CompressedSparseShape_(range_, result, size_vectors_);
+    }
+
+  public:
+
+    CompressedSparseShape_ mult(const CompressedSparseShape_& other) const {
+      return scaled_mult(other, value_type(1));
+    }
+
+    CompressedSparseShape_ mult(const CompressedSparseShape_& other,
+        const Permutation& perm) const
+    {
+      return mult(other).perm(perm);
+    }
+
+    /// \tparam Factor The scaling factor type
+    /// \note expression abs(Factor) must be well defined (by default, std::abs will be used)
+    template <typename Factor>
+    CompressedSparseShape_ mult(const CompressedSparseShape_& other,
+        const Factor factor) const
+    {
+      return scaled_mult(other, to_abs_factor(factor));
+    }
+
+    /// \tparam Factor The scaling factor type
+    /// \note expression abs(Factor) must be well defined (by default, std::abs will be used)
+    template <typename Factor>
+    CompressedSparseShape_ mult(const CompressedSparseShape_& other,
+        const Factor factor, const Permutation& perm) const
+    {
+      return mult(other, factor).perm(perm);
+    }
+
+    /// Contract shapes
+
+    /// The norms are contracted as a sparse matrix product, row by row, so
+    /// the work is proportional to the number of non-zero tile products and
+    /// the memory to the number of non-zero result tiles.
+    /// \tparam Factor The scaling factor type
+    /// \note expression abs(Factor) must be well defined (by default, std::abs will be used)
+    /// \param other The right-hand shape
+    /// \param factor The scaling factor
+    /// \param gemm_helper The contraction that is applied to the shapes,
+    /// where the arguments are not transposed
+    /// \return The contracted shape
+    template <typename Factor>
+    CompressedSparseShape_ gemm(const CompressedSparseShape_& other,
+        const Factor factor, const math::GemmHelper& gemm_helper) const
+    {
+      TA_ASSERT(data_);
+      TA_ASSERT(other.data_);
+      TA_ASSERT(gemm_helper.left_op() == madness::cblas::NoTrans);
+      TA_ASSERT(gemm_helper.right_op() == madness::cblas::NoTrans);
+
+      const value_type abs_factor = to_abs_factor(factor);
+      const value_type threshold = SparseShape<T>::threshold();
+      integer M = 0, N = 0, K = 0;
+      gemm_helper.compute_matrix_sizes(M, N, K, range_, other.range_);
+
+      // Allocate memory for the contracted size vectors
+      std::shared_ptr<vector_type> result_size_vectors(new vector_type[gemm_helper.result_rank()],
+          std::default_delete<vector_type[]>());
+
+      // Initialize the result size vectors
+      unsigned int x = 0ul;
+      for(unsigned int i = gemm_helper.left_outer_begin(); i < gemm_helper.left_outer_end(); ++i, ++x)
+        result_size_vectors.get()[x] = size_vectors_.get()[i];
+      for(unsigned int i = gemm_helper.right_outer_begin(); i < gemm_helper.right_outer_end(); ++i, ++x)
+        result_size_vectors.get()[x] = other.size_vectors_.get()[i];
+
+      // Compute the number of elements in each inner tile, where the norms
+      // of both arguments are scaled by the inner tile size.
+      std::vector<value_type> k_sizes(1, value_type(1));
+      for(unsigned int i = gemm_helper.left_inner_begin(); i < gemm_helper.left_inner_end(); ++i) {
+        const vector_type& size_vector = size_vectors_.get()[i];
+        std::vector<value_type> temp;
+        temp.reserve(k_sizes.size() * size_vector.size());
+        for(const value_type left : k_sizes)
+          for(size_type j = 0ul; j < size_vector.size(); ++j)
+            temp.push_back(left * size_vector[j]);
+        k_sizes.swap(temp);
+      }
+      TA_ASSERT(k_sizes.size() == size_type(K));
+      for(value_type& k_size : k_sizes)
+        k_size *= k_size;
+
+      // Compute the row offsets of the right-hand argument
+      const NormData& left = *data_;
+      const NormData& right = *other.data_;
+      std::vector<size_type> right_rows(K + 1, 0ul);
+      for(const size_type ordinal : right.ordinals)
+        ++right_rows[ordinal / N + 1];
+      for(integer k = 0; k < K; ++k)
+        right_rows[k + 1] += right_rows[k];
+
+      // Compute the product one row at a time, accumulating into a dense row
+      std::shared_ptr<NormData> result = std::make_shared<NormData>();
+      std::vector<value_type> row(N, value_type(0));
+      std::vector<char> row_mask(N, 0);
+      std::vector<size_type> columns;
+      for(size_type i = 0ul; i < left.size(); ) {
+        const size_type m = left.ordinals[i] / K;
+
+        // Accumulate the contributions of each tile in row m of left
+        for(; (i < left.size()) && (left.ordinals[i] / K == m); ++i) {
+          const size_type k = left.ordinals[i] % K;
+          const value_type left_norm = left.norms[i] * k_sizes[k];
+          for(size_type j = right_rows[k]; j < right_rows[k + 1]; ++j) {
+            const size_type n = right.ordinals[j] % N;
+            if(! row_mask[n]) {
+              row_mask[n] = 1;
+              columns.push_back(n);
+            }
+            row[n] += left_norm * right.norms[j];
+          }
+        }
+
+        // Hard zero tiles that are below the zero threshold
+        std::sort(columns.begin(), columns.end());
+        for(const size_type n : columns) {
+          const value_type norm = row[n] * abs_factor;
+          if(norm >= threshold)
+            result->push_back(m * N + n, norm);
+          row[n] = value_type(0);
+          row_mask[n] = 0;
+        }
+        columns.clear();
+      }
+
+      return CompressedSparseShape_(
+          gemm_helper.make_result_range<Range>(range_, other.range_), result,
+          result_size_vectors);
+    }
+
+    /// \tparam Factor The scaling factor type
+    /// \note expression abs(Factor) must be well defined (by default, std::abs will be used)
+    template <typename Factor>
+    CompressedSparseShape_ gemm(const CompressedSparseShape_& other,
+        const Factor factor, const math::GemmHelper& gemm_helper,
+        const Permutation& perm) const
+    {
+      return gemm(other, factor, gemm_helper).perm(perm);
+    }
+
+  private:
+    template <typename Factor>
+    static value_type to_abs_factor(const Factor factor) {
+      using std::abs;
+      return static_cast<value_type>(abs(factor));
+    }
+
+  }; // class CompressedSparseShape
+
+  /// Add the shape to an output stream
+
+  /// Only the non-zero tile norms are written to the stream.
+  /// \tparam T the numeric type supporting the type of \c shape
+  /// \param os The output stream
+  /// \param shape the CompressedSparseShape<T> object
+  /// \return A reference to the output stream
+  template <typename T>
+  inline std::ostream& operator<<(std::ostream& os,
+      const CompressedSparseShape<T>& shape)
+  {
+    os << "CompressedSparseShape<" << typeid(T).name() << ">: { ";
+    for(std::size_t i = 0ul; i < shape.nnz(); ++i)
+      os << shape.nonzero_ordinals()[i] << ":" << shape.nonzero_norms()[i] << " ";
+    os << "}" << std::endl;
+    return os;
+  }
+
+
+#ifndef TILEDARRAY_HEADER_ONLY
+
+  extern template class CompressedSparseShape<float>;
+
+#endif // TILEDARRAY_HEADER_ONLY
+
+} // namespace TiledArray
+
+#endif // TILEDARRAY_COMPRESSED_SPARSE_SHAPE_H__INCLUDED
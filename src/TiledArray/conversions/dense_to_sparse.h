@@ -54,6 +54,110 @@ namespace TiledArray {
       return sparse_array;
   }
 
+  /// Function to convert a compressed sparse array into a block sparse array
+
+  /// The norms of the local non-zero tiles are collected into a dense norm
+  /// tensor for the \c SparseShape , and the non-zero tiles are cloned into
+  /// the block sparse array.
+  template <typename Tile>
+  DistArray<Tile, SparsePolicy>
+  to_sparse(DistArray<Tile, CompressedSparsePolicy> const &compressed_array) {
+      typedef DistArray<Tile, SparsePolicy> ArrayType;  // return type
+      typedef typename ArrayType::shape_type shape_type;
+
+      TiledArray::Tensor<typename shape_type::value_type>
+          tile_norms(compressed_array.trange().tiles_range(), 0.0);
+
+      const auto end = compressed_array.end();
+      const auto begin = compressed_array.begin();
+      for (auto it = begin; it != end; ++it) {
+          tile_norms[it.ordinal()] = it->get().norm();
+      }
+
+      shape_type shape(compressed_array.world(), tile_norms,
+                       compressed_array.trange());
+
+      ArrayType sparse_array(compressed_array.world(),
+                             compressed_array.trange(), shape);
+
+      for (auto it = begin; it != end; ++it) {
+          const auto ord = it.ordinal();
+          if (!sparse_array.is_zero(ord)) {
+              sparse_array.set(ord, it->get().clone());
+          }
+      }
+
+      return sparse_array;
+  }
+
+  namespace detail {
+
+    /// Copy the significant tiles of an array into a compressed sparse array
+
+    /// Only the norms of the local non-zero tiles of \c array are collected
+    /// and communicated, so a dense norm tensor is never allocated.
+    /// \tparam Tile The tile type of the array
+    /// \tparam Policy The policy type of \c array
+    /// \param array The array to be converted
+    /// \return A compressed sparse array with a copy of the significant tiles
+    /// of \c array
+    template <typename Tile, typename Policy>
+    DistArray<Tile, CompressedSparsePolicy>
+    to_compressed_sparse(DistArray<Tile, Policy> const &array) {
+        typedef DistArray<Tile, CompressedSparsePolicy> ArrayType;  // return type
+        typedef typename ArrayType::shape_type shape_type;
+
+        std::vector<typename shape_type::nonzero_type> tile_norms;
+
+        const auto end = array.end();
+        const auto begin = array.begin();
+        for (auto it = begin; it != end; ++it) {
+            tile_norms.emplace_back(it.ordinal(), it->get().norm());
+        }
+
+        shape_type shape(array.world(), std::move(tile_norms), array.trange());
+
+        ArrayType compressed_array(array.world(), array.trange(), shape);
+
+        for (auto it = begin; it != end; ++it) {
+            const auto ord = it.ordinal();
+            if (!compressed_array.is_zero(ord)) {
+                compressed_array.set(ord, it->get().clone());
+            }
+        }
+
+        return compressed_array;
+    }
+
+  } // namespace detail
+
+  /// Function to convert a dense array into a compressed sparse array
+
+  /// The significant tiles of \c dense_array are cloned into the compressed
+  /// sparse array.
+  template <typename Tile>
+  DistArray<Tile, CompressedSparsePolicy>
+  to_compressed_sparse(DistArray<Tile, DensePolicy> const &dense_array) {
+      return detail::to_compressed_sparse(dense_array);
+  }
+
+  /// Function to convert a block sparse array into a compressed sparse array
+
+  /// The significant tiles of \c sparse_array are cloned into the compressed
+  /// sparse array.
+  template <typename Tile>
+  DistArray<Tile, CompressedSparsePolicy>
+  to_compressed_sparse(DistArray<Tile, SparsePolicy> const &sparse_array) {
+      return detail::to_compressed_sparse(sparse_array);
+  }
+
+  /// If the array is already compressed sparse return a copy of the array.
+  template <typename Tile>
+  DistArray<Tile, CompressedSparsePolicy>
+  to_compressed_sparse(DistArray<Tile, CompressedSparsePolicy> const &compressed_array) {
+      return compressed_array;
+  }
+
 }  // namespace TiledArray
 
 #endif /* end of include guard: TILEDARRAY_DENSETOSPARSE_H__INCLUDED */
@@ -40,6 +40,7 @@ namespace TiledArray {
   template <typename, typename> class Tensor;
   class DensePolicy;
   class SparsePolicy;
+  class CompressedSparsePolicy;
 
   namespace detail {
 
@@ -190,6 +191,74 @@ namespace TiledArray {
       return result;
     }
 
+    /// base implementation of compressed sparse TiledArray::foreach
+
+    /// The result tile norms are collected as ordinal index and norm pairs
+    /// of the local non-zero tiles, so the result shape is constructed
+    /// without a dense norm tensor.
+    /// \note can't autodeduce \c ResultTile from \c void \c Op(ResultTile,ArgTile)
+    template <typename ResultTile, typename ArgTile, typename Op, bool inplace = false>
+    inline DistArray<ResultTile, CompressedSparsePolicy>
+    foreach(const_if_t<not inplace, DistArray<ArgTile, CompressedSparsePolicy>>& arg, Op&& op) {
+      typedef DistArray<ArgTile, CompressedSparsePolicy> arg_array_type;
+      typedef DistArray<ResultTile, CompressedSparsePolicy> result_array_type;
+
+      typedef typename arg_array_type::value_type arg_value_type;
+      typedef typename result_array_type::value_type result_value_type;
+      typedef typename arg_array_type::size_type size_type;
+      typedef typename arg_array_type::shape_type shape_type;
+      typedef std::pair<size_type, Future<result_value_type>> datum_type;
+
+      // Collect the local non-zero tiles before any task is spawned, so the
+      // norm data is not reallocated while the tasks write to it.
+      std::vector<typename shape_type::nonzero_type> tile_norms;
+      for(auto index: *(arg.pmap()))
+        if(! arg.is_zero(index))
+          tile_norms.emplace_back(index, typename shape_type::value_type(0));
+
+      // Create a vector to hold local tiles
+      std::vector<datum_type> tiles;
+      tiles.reserve(tile_norms.size());
+
+      // Construct the task function used to construct the result tiles.
+      madness::AtomicInt counter; counter = 0;
+      const int task_count = tile_norms.size();
+      auto task = [&op,&counter,&tile_norms](const size_type i,
+          const_if_t<not inplace, arg_value_type>& arg_tile) -> result_value_type {
+        nonvoid_op_helper<Op,
+            result_value_type,
+            arg_value_type,
+            typename shape_type::value_type,
+            inplace> op_caller;
+        auto result_tile = op_caller(std::forward<Op>(op), arg_tile, tile_norms[i].second);
+        ++counter;
+        return result_tile;
+      };
+
+      World& world = arg.world();
+
+      for(size_type i = 0ul; i < tile_norms.size(); ++i) {
+        const size_type index = tile_norms[i].first;
+        auto result_tile = world.taskq.add(task, i, arg.find(index));
+        tiles.push_back(datum_type(index, result_tile));
+      }
+
+      // Wait for tile norm data to be collected.
+      if(task_count > 0)
+        world.await([&counter,task_count] () -> bool { return counter == task_count; });
+
+      // Construct the new array
+      result_array_type result(world, arg.trange(),
+          shape_type(world, std::move(tile_norms), arg.trange()), arg.pmap());
+      for(typename std::vector<datum_type>::const_iterator it = tiles.begin(); it != tiles.end(); ++it) {
+        const size_type index = it->first;
+        if(! result.is_zero(index))
+          result.set(it->first, it->second);
+      }
+
+      return result;
+    }
+
   } // namespace TiledArray::detail
 
   /// Apply a function to each tile of a dense Array
@@ -381,6 +450,58 @@ namespace TiledArray {
     arg = detail::foreach<Tile,Tile,Op,true>(arg, std::forward<Op>(op));
   }
 
+  /// Apply a function to each tile of a compressed sparse Array
+
+  /// This function behaves like \c foreach for sparse arrays, where \c op
+  /// returns the 2-norm (Frobenius norm) of the result tile. The result
+  /// shape is constructed from the norms of the non-zero tiles only.
+  /// \tparam Op Tile operation
+  /// \tparam Tile The tile type of the array
+  /// \param op The tile function
+  /// \param arg The argument array
+  template <typename ResultTile, typename ArgTile, typename Op,
+            typename = typename std::enable_if<!std::is_same<ResultTile,ArgTile>::value>::type>
+  inline DistArray<ResultTile, CompressedSparsePolicy>
+  foreach(const DistArray<ArgTile, CompressedSparsePolicy>& arg, Op&& op) {
+    return detail::foreach<ResultTile,ArgTile,Op>(arg,std::forward<Op>(op));
+  }
+
+  /// Apply a function to each tile of a compressed sparse Array
+
+  /// Specialization of foreach<ResultTile,ArgTile,Op> for
+  /// the case \c ResultTile == \c ArgTile
+  template <typename Tile, typename Op>
+  inline DistArray<Tile, CompressedSparsePolicy>
+  foreach(const DistArray<Tile, CompressedSparsePolicy>& arg, Op&& op) {
+    return detail::foreach<Tile,Tile,Op>(arg,std::forward<Op>(op));
+  }
+
+  /// Modify each tile of a compressed sparse Array
+
+  /// This function behaves like \c foreach_inplace for sparse arrays, where
+  /// \c op returns the 2-norm (Frobenius norm) of the modified tile.
+  /// \tparam Op Mutating tile operation
+  /// \tparam Tile The tile type of the array
+  /// \param op The mutating tile function
+  /// \param arg The argument array to be modified
+  /// \param fence A flag that indicates fencing behavior. If \c true this
+  /// function will fence before data is modified.
+  /// \warning This function fences by default to avoid data race conditions.
+  /// Only disable the fence if you can ensure, the data is not being read by
+  /// another thread.
+  template <typename Tile, typename Op>
+  inline void
+  foreach_inplace(DistArray<Tile, CompressedSparsePolicy>& arg, Op&& op, bool fence = true) {
+
+    // The tile data is being modified in place, which means we may need to
+    // fence to ensure no other threads are using the data.
+    if(fence)
+      arg.world().gop.fence();
+
+    // Set the arg with the new array
+    arg = detail::foreach<Tile,Tile,Op,true>(arg, std::forward<Op>(op));
+  }
+
 } // namespace TiledArray
 
 #endif // TILEDARRAY_CONVERSIONS_TRUNCATE_H__INCLUDED
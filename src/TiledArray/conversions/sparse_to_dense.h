@@ -30,32 +30,55 @@
 
 namespace TiledArray {
 
+  namespace detail {
+
+    /// Copy the tiles of a sparse array into a dense array
+
+    /// \tparam Tile The tile type of the array
+    /// \tparam Policy The policy type of the sparse array
+    /// \param sparse_array The sparse array
+    /// \return A dense array with a copy of the tiles of \c sparse_array ,
+    /// where the zero tiles are filled with zeros
+    template <typename Tile, typename Policy>
+    DistArray<Tile, DensePolicy>
+    sparse_to_dense(DistArray<Tile, Policy> const& sparse_array) {
+        typedef DistArray<Tile, DensePolicy> ArrayType;
+        ArrayType dense_array(sparse_array.world(), sparse_array.trange());
+
+        typedef typename ArrayType::pmap_interface pmap_interface;
+        std::shared_ptr<pmap_interface> const& pmap = dense_array.pmap();
+
+        typename pmap_interface::const_iterator end = pmap->end();
+
+        // iterate over sparse tiles
+        for (typename pmap_interface::const_iterator it = pmap->begin(); it != end;
+             ++it) {
+            const std::size_t ord = *it;
+            if (!sparse_array.is_zero(ord)) {
+                // clone because tiles are shallow copied
+                Tile tile(sparse_array.find(ord).get().clone());
+                dense_array.set(ord, tile);
+            } else {
+                // see DistArray::set(ordinal, element_type)
+                dense_array.set(ord, 0);
+            }
+        }
+
+        return dense_array;
+    }
+
+  } // namespace detail
+
   template <typename Tile>
   DistArray<Tile, DensePolicy>
   to_dense(DistArray<Tile, SparsePolicy> const& sparse_array) {
-      typedef DistArray<Tile, DensePolicy> ArrayType;
-      ArrayType dense_array(sparse_array.world(), sparse_array.trange());
-
-      typedef typename ArrayType::pmap_interface pmap_interface;
-      std::shared_ptr<pmap_interface> const& pmap = dense_array.pmap();
-
-      typename pmap_interface::const_iterator end = pmap->end();
-
-      // iterate over sparse tiles
-      for (typename pmap_interface::const_iterator it = pmap->begin(); it != end;
-           ++it) {
-          const std::size_t ord = *it;
-          if (!sparse_array.is_zero(ord)) {
-              // clone because tiles are shallow copied
-              Tile tile(sparse_array.find(ord).get().clone());
-              dense_array.set(ord, tile);
-          } else {
-              // see DistArray::set(ordinal, element_type)
-              dense_array.set(ord, 0);
-          }
-      }
-
-      return dense_array;
+      return detail::sparse_to_dense(sparse_array);
+  }
+
+  template <typename Tile>
+  DistArray<Tile, DensePolicy>
+  to_dense(DistArray<Tile, CompressedSparsePolicy> const& sparse_array) {
+      return detail::sparse_to_dense(sparse_array);
   }
 
   // If array is already dense just use the copy constructor.
@@ -34,6 +34,7 @@ namespace TiledArray {
   template <typename, typename> class DistArray;
   class DensePolicy;
   class SparsePolicy;
+  class CompressedSparsePolicy;
 
   /// Truncate a dense Array
 
@@ -58,6 +59,21 @@ namespace TiledArray {
         });
   }
 
+  /// Truncate a compressed sparse Array
+
+  /// \tparam Tile The tile type of the array
+  /// \param[in,out] array The array object to be truncated
+  template <typename Tile>
+  inline void truncate(DistArray<Tile, CompressedSparsePolicy>& array) {
+    typedef typename DistArray<Tile, CompressedSparsePolicy>::value_type value_type;
+    array =
+        foreach(array, [] (value_type& result_tile, const value_type& arg_tile) {
+          typename detail::scalar_type<value_type>::type norm = arg_tile.norm();
+          result_tile = arg_tile; // Assume this is shallow copy
+          return norm;
+        });
+  }
+
 } // namespace TiledArray
 
 #endif // TILEDARRAY_CONVERSIONS_TRUNCATE_H__INCLUDED
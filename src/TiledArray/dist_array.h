@@ -21,6 +21,7 @@
 #define TILEDARRAY_ARRAY_H__INCLUDED
 
 #include <TiledArray/replicator.h>
+#include <TiledArray/redistributor.h>
 #include <TiledArray/pmap/replicated_pmap.h>
 //#include <TiledArray/tensor.h>
 #include <TiledArray/policies/dense_policy.h>
@@ -636,6 +637,76 @@ namespace TiledArray {
       return pimpl_->is_zero(i);
     }
 
+    /// Set the remote tile cache
+
+    /// When the cache is enabled, remote tiles accessed with \c find() are
+    /// kept on this process, so repeated requests for the same remote tile
+    /// between fences do not communicate. Cached tiles are discarded at the
+    /// next fence, when they are set from this process, and by the least
+    /// recently used rule when the cache exceeds \c max_bytes . Tiles that
+    /// are assigned by other processes after they are cached are not
+    /// updated. This is a local operation, and it must not be called while
+    /// tiles of this array are accessed by other threads.
+    /// \param max_bytes The maximum number of bytes of cached tiles, or zero
+    /// to disable the cache
+    void set_remote_cache(const std::size_t max_bytes) {
+      check_pimpl();
+      pimpl_->set_remote_cache(max_bytes);
+    }
+
+    /// Remote tile cache hit counter
+
+    /// \return The number of remote tiles found in the cache of this process
+    std::size_t remote_cache_hits() const {
+      check_pimpl();
+      return pimpl_->remote_cache_hits();
+    }
+
+    /// Remote tile cache miss counter
+
+    /// \return The number of remote tiles that this process requested from
+    /// their owners while the cache was enabled
+    std::size_t remote_cache_misses() const {
+      check_pimpl();
+      return pimpl_->remote_cache_misses();
+    }
+
+    /// Set the out-of-core storage of local tiles
+
+    /// When spilling is enabled, the local tiles of this array are kept in
+    /// memory until their total size exceeds \c max_bytes . The least
+    /// recently used tiles are then written to a spill file in \c directory
+    /// and read back by a task when they are accessed with \c find() or
+    /// \c prefetch() . This is a local operation, and it must be called
+    /// before any local tile is assigned. The setting belongs to the tile
+    /// storage of this array, so it is replaced when the array is assigned
+    /// the result of an expression. The storage of every array, including
+    /// expression results, uses the budget given by the
+    /// \c TA_SPILL_MAX_BYTES environment variable by default.
+    /// \param max_bytes The memory budget for the local tiles of this
+    /// process in bytes, or zero to disable spilling
+    /// \param directory The directory of the spill file (default is the value
+    /// of the \c TA_SPILL_DIR or \c TMPDIR environment variable, or \c /tmp )
+    void set_spill(const std::size_t max_bytes,
+        const std::string& directory = impl_type::storage_type::spill_directory())
+    {
+      check_pimpl();
+      pimpl_->set_spill(max_bytes, directory);
+    }
+
+    /// Prefetch a local tile
+
+    /// Start reading a local tile that has been spilled, so that a later
+    /// \c find() does not wait for the file. This function does nothing when
+    /// spilling is disabled or the tile is not local.
+    /// \tparam Index An index type
+    /// \param i The index of a tile
+    template <typename Index>
+    void prefetch(const Index& i) const {
+      check_index(i);
+      pimpl_->prefetch(i);
+    }
+
     /// Swap this array with \c other
 
     /// \param other The array to be swapped with this array.
@@ -663,6 +734,48 @@ namespace TiledArray {
       }
     }
 
+    /// Move the tiles of this array to a new process map
+
+    /// The tiles of this array are sent directly to their owners in \c pmap ,
+    /// in aggregated messages with a bounded number of messages in flight
+    /// per process (see \c detail::Redistributor ). Tiles that are owned by
+    /// the same process in both maps are not copied. When \c pmap is
+    /// replicated and this array is not, this is equivalent to
+    /// \c make_replicated() . This is a
+    /// collective operation, and the tiles of the result may be accessed
+    /// immediately.
+    /// \param pmap The new process map
+    /// \throw TiledArray::Exception When \c pmap is not valid for this array
+    void redistribute(const std::shared_ptr<pmap_interface>& pmap) {
+      check_pimpl();
+      TA_USER_ASSERT(pmap,
+          "Array::redistribute() -- The process map is not initialized.");
+      if(pmap == pimpl_->pmap())
+        return;
+
+      DistArray_ result = DistArray_(world(), trange(), shape(), pmap);
+      if(pmap->is_replicated() && ! pimpl_->pmap()->is_replicated()
+          && (world().size() > 1))
+      {
+        // Broadcast all tiles with the replicator. A replicated array already
+        // holds all tiles, so it is copied locally by the redistributor.
+        std::shared_ptr<detail::Replicator<DistArray_> > replicator(
+            new detail::Replicator<DistArray_>(*this, result));
+        TA_ASSERT(replicator.unique()); // Required for deferred_cleanup
+        madness::detail::deferred_cleanup(world(), replicator);
+      } else {
+        std::shared_ptr<detail::Redistributor<DistArray_> > redistributor(
+            new detail::Redistributor<DistArray_>(*this, result));
+
+        // Put the redistributor pointer in the deferred cleanup object so it
+        // will be deleted at the end of the next fence.
+        TA_ASSERT(redistributor.unique()); // Required for deferred_cleanup
+        madness::detail::deferred_cleanup(world(), redistributor);
+      }
+
+      DistArray_::operator=(result);
+    }
+
     /// Update shape data and remove tiles that are below the zero threshold
 
     /// \note This function is a no-op for dense arrays.
@@ -25,6 +25,7 @@
 #include <TiledArray/reduce_task.h>
 #include <TiledArray/type_traits.h>
 #include <TiledArray/shape.h>
+#include <atomic>
 
 //#define TILEDARRAY_ENABLE_SUMMA_TRACE_EVAL 1
 //#define TILEDARRAY_ENABLE_SUMMA_TRACE_INITIALIZE 1
@@ -35,6 +36,36 @@
 namespace TiledArray {
   namespace detail {
 
+    /// SUMMA screening flag accessor
+
+    /// When the flag is set, SUMMA evaluations of sparse arguments skip tile
+    /// pairs with a negligible norm product. The flag is initialized by the
+    /// \c TA_SUMMA_SCREEN environment variable, and it is read when a SUMMA
+    /// evaluator is constructed.
+    /// \return A reference to the screening flag of this process
+    inline std::atomic<bool>& summa_screen() {
+      static std::atomic<bool> screen{ getenv("TA_SUMMA_SCREEN") &&
+          (std::stoi(getenv("TA_SUMMA_SCREEN")) != 0) };
+      return screen;
+    }
+
+    /// Statistics for tile pairs skipped by the SUMMA screening
+
+    /// The counters are accumulated over all SUMMA evaluations of this
+    /// process.
+    struct SummaScreenStatistics {
+      std::atomic<std::size_t> pairs; ///< The number of skipped tile pairs
+      std::atomic<std::size_t> flops; ///< The number of skipped floating point operations
+    }; // struct SummaScreenStatistics
+
+    /// SUMMA screening statistics accessor
+
+    /// \return A reference to the screening statistics of this process
+    inline SummaScreenStatistics& summa_screen_statistics() {
+      static SummaScreenStatistics stats{ {0ul}, {0ul} };
+      return stats;
+    }
+
     /// Distributed contraction evaluator implementation
 
     /// \tparam Left The left-hand argument evaluator type
@@ -46,6 +77,13 @@ namespace TiledArray {
     /// argument and the column phase of the right-hand argument are equal to
     /// the number of rows and columns, respectively, in the \c ProcGrid object
     /// passed to the constructor.
+    /// \note When the \c ProcGrid object has more than one layer, this class
+    /// evaluates the communication-avoiding (2.5D) variant of SUMMA. The
+    /// arguments are expected to be distributed by the \c LayeredCyclicPmap
+    /// objects constructed by the process grid, where each layer of processes
+    /// holds a contiguous block of the inner dimension. Each layer evaluates
+    /// the partial contraction for its block, and the partial results are
+    /// reduced onto the first layer.
     template <typename Left, typename Right, typename Op, typename Policy>
     class Summa :
         public DistEvalImpl<typename Op::result_type, Policy>,
@@ -82,10 +120,25 @@ namespace TiledArray {
       // Dimension information
       const size_type k_; ///< Number of tiles in the inner dimension
       const ProcGrid proc_grid_; ///< Process grid for this contraction
+      const size_type k_begin_; ///< The first inner dimension tile of this process layer
+      const size_type k_end_; ///< The end of the inner dimension tiles of this process layer
 
       // Contraction results
       ReducePairTask<op_type>* reduce_tasks_; ///< A pointer to the reduction tasks
 
+      // Screening data
+      const bool screen_; ///< Skip tile pairs with a negligible norm product
+      std::vector<size_type> k_sizes_; ///< The number of elements in each inner dimension tile
+      std::atomic<std::size_t> screened_pairs_; ///< The number of skipped tile pairs
+      std::atomic<std::size_t> screened_flops_; ///< The number of skipped floating point operations
+
+      // Pipeline control
+      const size_type left_tile_bytes_; ///< The average size of a left-hand tile in bytes
+      const size_type right_tile_bytes_; ///< The average size of a right-hand tile in bytes
+      std::atomic<std::size_t> bytes_in_flight_; ///< Bytes of argument tiles held by in-flight iterations and of the result tiles of pending reductions
+      size_type depth_; ///< The current number of concurrent SUMMA iterations
+      size_type depth_limit_; ///< The upper bound on the number of concurrent SUMMA iterations
+
       // Constant used to iterate over columns and rows of left_ and right_, respectively.
       const size_type left_start_local_; ///< The starting point of left column iterator ranges (just add k for specific columns)
       const size_type left_end_; ///< The end of the left column iterator ranges
@@ -335,6 +388,44 @@ namespace TiledArray {
         get_vector(right_, begin, end, right_stride_local_, row);
       }
 
+      /// Compute the size of a vector of argument tiles
+
+      /// \tparam Arg The argument type
+      /// \tparam Datum The vector element type
+      /// \param arg The argument that owns the tiles
+      /// \param index The index of the first tile of the vector
+      /// \param stride The stride between the tile indices of the vector
+      /// \param vec The vector of tiles
+      /// \return The number of bytes of the data of the tiles in \c vec
+      template <typename Arg, typename Datum>
+      static std::size_t vector_bytes(const Arg& arg, const size_type index,
+          const size_type stride, const std::vector<Datum>& vec)
+      {
+        std::size_t volume = 0ul;
+        for(const Datum& datum : vec)
+          volume += arg.trange().make_tile_range(index + datum.first * stride).volume();
+        return volume * sizeof(typename numeric_type<typename Arg::eval_type>::type);
+      }
+
+      /// Compute the size of column \c k of \c left_
+
+      /// \param k The column of \c col
+      /// \param col The column tiles collected by \c get_col()
+      /// \return The number of bytes of the data of the tiles in \c col
+      std::size_t col_bytes(const size_type k, const std::vector<col_datum>& col) const {
+        return vector_bytes(left_, left_start_local_ + k, left_stride_local_, col);
+      }
+
+      /// Compute the size of row \c k of \c right_
+
+      /// \param k The row of \c row
+      /// \param row The row tiles collected by \c get_row()
+      /// \return The number of bytes of the data of the tiles in \c row
+      std::size_t row_bytes(const size_type k, const std::vector<row_datum>& row) const {
+        return vector_bytes(right_, k * proc_grid_.cols() + proc_grid_.rank_col(),
+            right_stride_local_, row);
+      }
+
       /// Broadcast tiles from \c arg
 
       /// \param[in] start The index of the first tile to be broadcast
@@ -390,7 +481,8 @@ namespace TiledArray {
       ProcessID get_row_group_root(const size_type k, const madness::Group& row_group) const {
         ProcessID group_root = k % proc_grid_.proc_cols();
         if(! right_.shape().is_dense() && row_group.size() < static_cast<ProcessID>(proc_grid_.proc_cols())) {
-          const ProcessID world_root = proc_grid_.rank_row() * proc_grid_.proc_cols() + group_root;
+          const ProcessID world_root = proc_grid_.layer_offset() +
+              proc_grid_.rank_row() * proc_grid_.proc_cols() + group_root;
           group_root = row_group.rank(world_root);
         }
         return group_root;
@@ -399,7 +491,8 @@ namespace TiledArray {
       ProcessID get_col_group_root(const size_type k, const madness::Group& col_group) const {
         ProcessID group_root = k % proc_grid_.proc_rows();
         if(! left_.shape().is_dense() && col_group.size() < static_cast<ProcessID>(proc_grid_.proc_rows())) {
-          const ProcessID world_root = group_root * proc_grid_.proc_cols() + proc_grid_.rank_col();
+          const ProcessID world_root = proc_grid_.layer_offset() +
+              group_root * proc_grid_.proc_cols() + proc_grid_.rank_col();
           group_root = col_group.rank(world_root);
         }
         return group_root;
@@ -522,12 +615,12 @@ namespace TiledArray {
       /// non-zero tiles in this processes column.
       /// \param k The first row to search
       /// \return The first row, greater than or equal to \c k with non-zero
-      /// tiles, or \c k_ if none is found.
+      /// tiles, or \c k_end_ if none is found.
       size_type iterate_row(size_type k) const {
         // Iterate over k's until a non-zero tile is found or the end of the
         // matrix is reached.
         size_type end = k * proc_grid_.cols();
-        for(; k < k_; ++k) {
+        for(; k < k_end_; ++k) {
           // Search for non-zero tiles in row k of right
           size_type i = end + proc_grid_.rank_col();
           end += proc_grid_.cols();
@@ -546,11 +639,11 @@ namespace TiledArray {
       /// checks for non-zero tiles in this process's row.
       /// \param k The first column to test for non-zero tiles
       /// \return The first column, greater than or equal to \c k, that contains
-      /// a non-zero tile. If no non-zero tile is not found, return \c k_.
+      /// a non-zero tile. If no non-zero tile is not found, return \c k_end_.
       size_type iterate_col(size_type k) const {
         // Iterate over k's until a non-zero tile is found or the end of the
         // matrix is reached.
-        for(; k < k_; ++k)
+        for(; k < k_end_; ++k)
           // Search row k for non-zero tiles
           for(size_type i = left_start_local_ + k; i < left_end_; i += left_stride_local_)
             if(! left_.shape().is_zero(i))
@@ -709,6 +802,39 @@ namespace TiledArray {
         return tile_count;
       }
 
+      /// Compute the size of the local result tiles
+
+      /// The result tiles are accumulated by the reduce tasks, which hold them
+      /// until the contraction is finalized.
+      /// \tparam Shape The shape type
+      /// \param shape The shape of the result
+      /// \return The number of bytes of the data of the non-zero, local
+      /// result tiles
+      template <typename Shape>
+      std::size_t reduce_bytes(const Shape& shape) const {
+        // Initialize iteration variables
+        size_type row_start = proc_grid_.rank_row() * proc_grid_.cols();
+        size_type row_end = row_start + proc_grid_.cols();
+        row_start += proc_grid_.rank_col();
+        const size_type col_stride = // The stride to iterate down a column
+            proc_grid_.proc_rows() * proc_grid_.cols();
+        const size_type row_stride = // The stride to iterate across a row
+            proc_grid_.proc_cols();
+        const size_type end = TensorImpl_::size();
+
+        // Iterate over all local tiles
+        std::size_t volume = 0ul;
+        for(; row_start < end; row_start += col_stride, row_end += col_stride) {
+          for(size_type index = row_start; index < row_end; index += row_stride) {
+            const size_type perm_index = DistEvalImpl_::perm_index_to_target(index);
+            if(! shape.is_zero(perm_index))
+              volume += TensorImpl_::trange().make_tile_range(perm_index).volume();
+          }
+        }
+
+        return volume * sizeof(typename numeric_type<value_type>::type);
+      }
+
       size_type initialize() {
 #ifdef TILEDARRAY_ENABLE_SUMMA_TRACE_INITIALIZE
         printf("init: start rank=%i\n", TensorImpl_::world().rank());
@@ -716,6 +842,11 @@ namespace TiledArray {
 
         const size_type result = initialize(TensorImpl_::shape());
 
+        // The result tiles of the pending reductions count against the
+        // memory bound of the pipeline.
+        if(max_memory_)
+          bytes_in_flight_ += reduce_bytes(TensorImpl_::shape());
+
 #ifdef TILEDARRAY_ENABLE_SUMMA_TRACE_INITIALIZE
         printf("init: finish rank=%i\n", TensorImpl_::world().rank());
 #endif // TILEDARRAY_ENABLE_SUMMA_TRACE_INITIALIZE
@@ -726,6 +857,70 @@ namespace TiledArray {
 
       // Finalize functions ----------------------------------------------------
 
+      /// Reduce the partial result of a process layer
+
+      /// \param result The partial result of the first process layer
+      /// \param arg The partial result of another process layer
+      /// \return The sum of \c result and \c arg
+      value_type reduce_layer_task(value_type result, const value_type& arg) const {
+        using TiledArray::empty;
+        if(empty(arg))
+          return result;
+        if(empty(result))
+          return arg;
+        op_(result, arg);
+        return result;
+      }
+
+      /// Set a result tile
+
+      /// When the process grid has a single layer, the result of the local
+      /// reduction task is the result tile. Otherwise, the partial results of
+      /// the other layers are sent to the corresponding process of the first
+      /// layer, where they are reduced into the result tile.
+      /// \param index The index of the result tile (before permutation)
+      /// \param reduce_task The reduction task for the result tile
+      void finalize_tile(const size_type index, ReducePairTask<op_type>& reduce_task) {
+        const size_type perm_index = DistEvalImpl_::perm_index_to_target(index);
+        const size_type layers = proc_grid_.proc_layers();
+        if(layers == 1ul) {
+          DistEvalImpl_::set_tile(perm_index, reduce_task.submit());
+          return;
+        }
+
+        // Get the partial result for this layer. Reduction tasks without
+        // arguments produce an empty tile.
+        World& world = TensorImpl_::world();
+        Future<value_type> partial = (reduce_task.count() ? reduce_task.submit()
+            : Future<value_type>(value_type()));
+
+        // The layer messages keys are offset by the argument broadcast keys
+        const size_type key_offset = left_.size() + right_.size() + index;
+        const ProcessID layer_size = proc_grid_.proc_size();
+        const ProcessID root = world.rank() - proc_grid_.layer_offset();
+
+        if(proc_grid_.rank_layer() == 0ul) {
+          // Reduce the partial results of the other layers
+          for(size_type l = 1ul; l < layers; ++l) {
+            const madness::DistributedID key(DistEvalImpl_::id(),
+                key_offset + l * TensorImpl_::size());
+            partial = world.taskq.add(this, & Summa_::reduce_layer_task,
+                partial, world.gop.template recv<value_type>(root + l * layer_size, key),
+                madness::TaskAttributes::hipri());
+          }
+
+          DistEvalImpl_::set_tile(perm_index, partial);
+        } else {
+          // Send the partial result to the first layer
+          const madness::DistributedID key(DistEvalImpl_::id(),
+              key_offset + proc_grid_.rank_layer() * TensorImpl_::size());
+          world.gop.send(root, key, partial);
+
+          // Record the assignment of the partial result
+          partial.register_callback(this);
+        }
+      }
+
       /// Set the result tiles, destroy reduce tasks, and destroy broadcast groups
       void finalize(const DenseShape&) {
         // Initialize iteration variables
@@ -745,8 +940,7 @@ namespace TiledArray {
 
 
             // Set the result tile
-            DistEvalImpl_::set_tile(DistEvalImpl_::perm_index_to_target(index),
-                reduce_task->submit());
+            finalize_tile(index, *reduce_task);
 
             // Destroy the the reduce task
             reduce_task->~ReducePairTask<op_type>();
@@ -792,7 +986,7 @@ namespace TiledArray {
 #endif // TILEDARRAY_ENABLE_SUMMA_TRACE_FINALIZE
 
               // Set the result tile
-              DistEvalImpl_::set_tile(perm_index, reduce_task->submit());
+              finalize_tile(index, *reduce_task);
             }
 
             // Destroy the the reduce task
@@ -911,15 +1105,16 @@ namespace TiledArray {
         }
       }
 
-#define TILEDARRAY_DISABLE_TILE_CONTRACTION_FILTER
-#ifndef TILEDARRAY_DISABLE_TILE_CONTRACTION_FILTER
       /// Schedule local contraction tasks for \c col and \c row tile pairs
 
       /// Schedule tile contractions for each tile pair of \c row and \c col. A
       /// callback to \c task will be registered with each tile contraction
       /// task. This version of contract is used when shape_type is
-      /// \c SparseShape. It skips tile contractions that have a negligible
-      /// contribution to the result tile.
+      /// \c SparseShape. When screening is enabled (see \c screen()), it
+      /// skips tile contractions that have a negligible contribution to the
+      /// result tile, i.e. pairs where the contribution to the norm of the
+      /// result is less than the zero threshold divided by the number of
+      /// tiles in the inner dimension.
       /// \tparam T The shape value type
       /// \param k The k step for this contraction set
       /// \param col A column of tiles from the left-hand argument
@@ -930,37 +1125,101 @@ namespace TiledArray {
       contract(const SparseShape<T>&, const size_type k,
           const std::vector<col_datum>& col, const std::vector<row_datum>& row,
           madness::TaskInterface* const task)
+      { screened_contract<T>(k, col, row, task); }
+
+      /// Schedule local contraction tasks for \c col and \c row tile pairs
+
+      /// This version of contract is used when shape_type is
+      /// \c CompressedSparseShape. It screens tile pairs in the same way as
+      /// the \c SparseShape version.
+      /// \tparam T The shape value type
+      /// \param k The k step for this contraction set
+      /// \param col A column of tiles from the left-hand argument
+      /// \param row A row of tiles from the right-hand argument
+      /// \param task The task that depends on the tile contraction tasks
+      template <typename T>
+      typename std::enable_if<std::is_floating_point<T>::value>::type
+      contract(const CompressedSparseShape<T>&, const size_type k,
+          const std::vector<col_datum>& col, const std::vector<row_datum>& row,
+          madness::TaskInterface* const task)
+      { screened_contract<T>(k, col, row, task); }
+
+      /// Schedule local contraction tasks with norm screening
+
+      /// Schedule tile contractions for each tile pair of \c row and \c col,
+      /// skipping negligible pairs when screening is enabled.
+      /// \tparam T The shape value type
+      /// \param k The k step for this contraction set
+      /// \param col A column of tiles from the left-hand argument
+      /// \param row A row of tiles from the right-hand argument
+      /// \param task The task that depends on the tile contraction tasks
+      template <typename T>
+      void screened_contract(const size_type k,
+          const std::vector<col_datum>& col, const std::vector<row_datum>& row,
+          madness::TaskInterface* const task)
       {
+        typedef T shape_value_type;
+
         // Cache row shape data.
-        std::vector<typename SparseShape<T>::value_type> row_shape_values;
-        row_shape_values.reserve(row.size());
+        std::vector<shape_value_type> row_shape_values;
         const size_type row_start = k * proc_grid_.cols() + proc_grid_.rank_col();
-        for(size_type j = 0ul; j < row.size(); ++j)
-          row_shape_values.push_back(right_.shape()[row_start + (row[j].first * right_stride_local_)]);
+        if(screen_) {
+          row_shape_values.reserve(row.size());
+          for(size_type j = 0ul; j < row.size(); ++j)
+            row_shape_values.push_back(right_.shape()[row_start + (row[j].first * right_stride_local_)]);
+        }
 
         const size_type col_start = left_start_local_ + k;
-        const float threshold_k = TensorImpl_::shape().threshold() / typename SparseShape<T>::value_type(k_);
+        const shape_value_type threshold_k = TensorImpl_::shape().threshold() /
+            (shape_value_type(k_) * shape_value_type(k_sizes_.empty() ? 1ul : k_sizes_[k]));
+        std::size_t screened_pairs = 0ul, screened_flops = 0ul;
+
         // Iterate over the row
         for(size_type i = 0ul; i != col.size(); ++i) {
           // Compute the local, result-tile offset
           const size_type offset = col[i].first * proc_grid_.local_cols();
 
           // Get the shape data for col_it tile
-          const typename SparseShape<T>::value_type col_shape_value =
-              left_.shape()[col_start + (col[i].first * left_stride_local_)];
+          const size_type col_index = col_start + (col[i].first * left_stride_local_);
+          const shape_value_type col_shape_value =
+              (screen_ ? left_.shape()[col_index] : shape_value_type(0));
 
           // Iterate over columns
           for(size_type j = 0ul; j < row.size(); ++j) {
-            if((col_shape_value * row_shape_values[j]) < threshold_k)
+            const size_type reduce_task_index = offset + row[j].first;
+
+            // Skip zero tiles
+            if(! reduce_tasks_[reduce_task_index])
+              continue;
+
+            // Skip tile pairs with a negligible contribution
+            if(screen_ && ((col_shape_value * row_shape_values[j]) < threshold_k)) {
+              ++screened_pairs;
+              screened_flops += 2ul *
+                  left_.trange().make_tile_range(col_index).volume() *
+                  right_.trange().make_tile_range(row_start +
+                      (row[j].first * right_stride_local_)).volume() /
+                  k_sizes_[k];
               continue;
+            }
 
+            // Schedule task for contraction pairs
             if(task)
               task->inc();
-            reduce_tasks_[offset + row[j].first].add(col[i].second, row[j].second, task);
+            const left_future left = col[i].second;
+            const right_future right = row[j].second;
+            reduce_tasks_[reduce_task_index].add(left, right, task);
           }
         }
+
+        // Record screening statistics
+        if(screened_pairs) {
+          screened_pairs_ += screened_pairs;
+          screened_flops_ += screened_flops;
+          summa_screen_statistics().pairs += screened_pairs;
+          summa_screen_statistics().flops += screened_flops;
+        }
       }
-#endif // TILEDARRAY_DISABLE_TILE_CONTRACTION_FILTER
 
       void contract(const size_type k, const std::vector<col_datum>& col,
           const std::vector<row_datum>& row, madness::TaskInterface* const task)
@@ -984,14 +1243,25 @@ namespace TiledArray {
         FinalizeTask* finalize_task_; ///< The SUMMA finalization task
         StepTask* next_step_task_ = nullptr; ///< The next SUMMA step task
         StepTask* tail_step_task_ = nullptr; ///< The next SUMMA step task
+        std::size_t col_bytes_ = 0ul; ///< The size of the column tiles of this step
+        std::size_t row_bytes_ = 0ul; ///< The size of the row tiles of this step
+        std::size_t release_bytes_ = 0ul; ///< Bytes released when this task runs
 
         void get_col(const size_type k) {
           owner_->get_col(k, col_);
+          if(owner_->max_memory_) {
+            col_bytes_ = owner_->col_bytes(k, col_);
+            owner_->bytes_in_flight_ += col_bytes_;
+          }
           this->notify();
         }
 
         void get_row(const size_type k) {
           owner_->get_row(k, row_);
+          if(owner_->max_memory_) {
+            row_bytes_ = owner_->row_bytes(k, row_);
+            owner_->bytes_in_flight_ += row_bytes_;
+          }
           this->notify();
         }
 
@@ -1035,8 +1305,8 @@ namespace TiledArray {
         void make_next_step_tasks(Derived* task, size_type depth) {
           TA_ASSERT(depth > 0);
           // Set the depth to be no greater than the maximum number steps
-          if(depth > owner_->k_)
-            depth = owner_->k_;
+          if(depth > (owner_->k_end_ - owner_->k_begin_))
+            depth = owner_->k_end_ - owner_->k_begin_;
 
           // Spawn the first (depth - 1) step tasks
           for(; depth > 0ul; --depth) {
@@ -1055,11 +1325,38 @@ namespace TiledArray {
           printf("step:  start rank=%i k=%lu\n", owner_->world().rank(), k);
 #endif // TILEDARRAY_ENABLE_SUMMA_TRACE_STEP
 
-          if(k < owner_->k_) {
-            // Initialize next tail task and submit next task
+          // The contractions of the steps that were registered with this task
+          // are complete, so their argument tiles are no longer in flight.
+          owner_->bytes_in_flight_ -= release_bytes_;
+
+          if(k < owner_->k_end_) {
             TA_ASSERT(next_step_task_);
-            next_step_task_->tail_step_task_ =
-                new Derived(static_cast<Derived*>(tail_step_task_), 1);
+            TA_ASSERT(tail_step_task_);
+
+            // The argument tiles of this step are held until the contractions,
+            // which are registered with the tail task, are complete.
+            tail_step_task_->release_bytes_ += col_bytes_ + row_bytes_;
+
+            // Initialize next tail task(s). The number of concurrent iterations
+            // is adjusted to the argument memory that is in flight.
+            switch(owner_->next_depth_step(col_bytes_ + row_bytes_)) {
+              case 0ul:
+                // Shrink the pipeline: the next step shares the tail task.
+                TA_ASSERT(next_step_task_ != tail_step_task_);
+                tail_step_task_->inc();
+                next_step_task_->tail_step_task_ = tail_step_task_;
+                break;
+              case 2ul:
+                // Grow the pipeline by an additional step.
+                next_step_task_->tail_step_task_ = new Derived(
+                    new Derived(static_cast<Derived*>(tail_step_task_), 0), 1);
+                break;
+              default:
+                next_step_task_->tail_step_task_ =
+                    new Derived(static_cast<Derived*>(tail_step_task_), 1);
+            }
+
+            // Submit next task
             world_.taskq.add(next_step_task_);
             next_step_task_ = nullptr;
 
@@ -1073,7 +1370,6 @@ namespace TiledArray {
             owner_->contract(k, col_, row_, tail_step_task_);
 
             // Notify task dependencies
-            TA_ASSERT(tail_step_task_);
             tail_step_task_->notify();
             finalize_task_->notify();
 
@@ -1109,7 +1405,7 @@ namespace TiledArray {
 
       public:
         DenseStepTask(const std::shared_ptr<Summa_>& owner, const size_type depth) :
-          StepTask(owner, owner->k_ + 1ul), k_(0)
+          StepTask(owner, owner->k_end_ - owner->k_begin_ + 1ul), k_(owner->k_begin_)
         {
           StepTask::make_next_step_tasks(this, depth);
           StepTask::spawn_get_row_col_tasks(k_);
@@ -1119,7 +1415,7 @@ namespace TiledArray {
           StepTask(parent, ndep), k_(parent->k_ + 1ul)
         {
           // Spawn tasks to get k-th row and column tiles
-          if(k_ < owner_->k_)
+          if(k_ < owner_->k_end_)
             StepTask::spawn_get_row_col_tasks(k_);
         }
 
@@ -1148,7 +1444,7 @@ namespace TiledArray {
           k = owner_->iterate_sparse(k + offset);
           k_.set(k);
 
-          if(k < owner_->k_) {
+          if(k < owner_->k_end_) {
             // NOTE: The order of task submissions is dependent on the order in
             // which we want the tasks to complete.
 
@@ -1180,13 +1476,13 @@ namespace TiledArray {
           // Spawn a task to find the next non-zero iteration
           madness::DependencyInterface::inc();
           world_.taskq.add(this, & SparseStepTask::iterate_task,
-              0ul, 0ul, madness::TaskAttributes::hipri());
+              owner->k_begin_, 0ul, madness::TaskAttributes::hipri());
         }
 
         SparseStepTask(SparseStepTask* const parent, const int ndep) :
           StepTask(parent, ndep)
         {
-          if(parent->k_.probe() && (parent->k_.get() >= owner_->k_)) {
+          if(parent->k_.probe() && (parent->k_.get() >= owner_->k_end_)) {
             // Avoid running extra tasks if not needed.
             k_.set(parent->k_.get());
           } else {
@@ -1206,6 +1502,25 @@ namespace TiledArray {
 
     public:
 
+      /// Maximum memory used by SUMMA per process accessor
+
+      /// \return The maximum number of bytes used by the SUMMA broadcast
+      /// buffers and pending reductions of each process, or zero if the memory
+      /// is unbounded.
+      static size_type max_memory() { return max_memory_; }
+
+      /// Set the maximum memory used by SUMMA per process
+
+      /// The default is given by the \c TA_SUMMA_MAX_MEMORY environment
+      /// variable. This function must not be called while a SUMMA evaluation
+      /// of this type is in progress.
+      /// \param max_memory The maximum number of bytes used by the SUMMA
+      /// broadcast buffers and pending reductions of each process, or zero if
+      /// the memory is unbounded
+      static void max_memory(const size_type max_memory) {
+        max_memory_ = max_memory;
+      }
+
       /// Constructor
 
       /// \param left The left-hand argument evaluator
@@ -1230,17 +1545,75 @@ namespace TiledArray {
         left_(left), right_(right), op_(op),
         row_group_(), col_group_(),
         k_(k), proc_grid_(proc_grid),
-        reduce_tasks_(NULL),
+        k_begin_(proc_grid.layer_k_begin(k)), k_end_(proc_grid.layer_k_end(k)),
+        reduce_tasks_(NULL), screen_(summa_screen()), k_sizes_(),
+        screened_pairs_(0ul),
+        screened_flops_(0ul),
+        left_tile_bytes_((left.trange().elements_range().volume() /
+            left.trange().tiles_range().volume()) *
+            sizeof(typename numeric_type<typename left_type::eval_type>::type)),
+        right_tile_bytes_((right.trange().elements_range().volume() /
+            right.trange().tiles_range().volume()) *
+            sizeof(typename numeric_type<typename right_type::eval_type>::type)),
+        bytes_in_flight_(0ul), depth_(0ul), depth_limit_(0ul),
         left_start_local_(proc_grid_.rank_row() * k),
         left_end_(left.size()),
         left_stride_(k),
         left_stride_local_(proc_grid.proc_rows() * k),
         right_stride_(1ul),
         right_stride_local_(proc_grid.proc_cols())
-      { }
+      {
+        if(screen_ && ! TensorImpl_::shape().is_dense()) {
+          // Compute the number of elements in each inner dimension tile, which
+          // is needed to compute the norm contribution of a tile pair.
+          const auto& left_ranges = left_.trange().data();
+          const std::size_t left_rank = left_ranges.size();
+          const std::size_t inner_rank =
+              (left_rank + right_.trange().rank() - trange.rank()) / 2ul;
+
+          k_sizes_.reserve(k_);
+          for(size_type i = 0ul; i < k_; ++i) {
+            size_type index = i, size = 1ul;
+            for(std::size_t d = left_rank; d > (left_rank - inner_rank); --d) {
+              const TiledRange1& range = left_ranges[d - 1ul];
+              const size_type extent = range.tile_extent();
+              const auto& tile = range.tile(range.tiles_range().first + (index % extent));
+              size *= tile.second - tile.first;
+              index /= extent;
+            }
+            k_sizes_.push_back(size);
+          }
+        }
+      }
 
       virtual ~Summa() { }
 
+      /// Screening flag accessor
+
+      /// Screening is enabled by setting the \c TA_SUMMA_SCREEN environment
+      /// variable to a non-zero value, or with \c summa_screen() before the
+      /// evaluator is constructed.
+      /// \return \c true if tile pairs with a negligible contribution to the
+      /// result are skipped by this evaluator
+      bool screen() const { return screen_; }
+
+      /// Pipeline depth accessor
+
+      /// \return The number of concurrent SUMMA iterations of this process
+      /// after the last step that adjusted the pipeline
+      size_type depth() const { return depth_; }
+
+      /// Skipped tile pair count accessor
+
+      /// \return The number of tile pairs skipped by screening on this process
+      std::size_t screened_pairs() const { return screened_pairs_; }
+
+      /// Skipped floating point operation count accessor
+
+      /// \return The number of floating point operations skipped by
+      /// screening on this process
+      std::size_t screened_flops() const { return screened_flops_; }
+
       /// Get tile at index \c i
 
       /// \param i The index of the tile
@@ -1291,19 +1664,15 @@ namespace TiledArray {
         if(available_memory) {
 
           // Compute the average memory requirement per iteration of this process
-          const std::size_t local_memory_per_iter_left =
-              (left_.trange().elements_range().volume() / left_.trange().tiles_range().volume()) *
-              sizeof(typename numeric_type<typename left_type::eval_type>::type) *
+          const std::size_t local_memory_per_iter_left = left_tile_bytes_ *
               proc_grid_.local_rows() * (1.0f - left_sparsity);
-          const std::size_t local_memory_per_iter_right =
-              (right_.trange().elements_range().volume() / right_.trange().tiles_range().volume()) *
-              sizeof(typename numeric_type<typename right_type::eval_type>::type) *
+          const std::size_t local_memory_per_iter_right = right_tile_bytes_ *
               proc_grid_.local_cols() * (1.0f - right_sparsity);
 
           // Compute the maximum number of iterations based on available memory
-          const size_type mem_bound_depth =
-              ((local_memory_per_iter_left + local_memory_per_iter_right) /
-              available_memory);
+          const size_type mem_bound_depth = available_memory /
+              std::max<std::size_t>(local_memory_per_iter_left +
+              local_memory_per_iter_right, 1ul);
 
           // Check if the memory bounded depth is less than the optimal depth
           if(depth > mem_bound_depth) {
@@ -1327,6 +1696,49 @@ namespace TiledArray {
         return depth;
       }
 
+      /// Initialize the SUMMA pipeline depth
+
+      /// \param depth The initial number of concurrent SUMMA iterations
+      void init_depth(const size_type depth) {
+        depth_ = depth;
+        depth_limit_ = k_end_ - k_begin_;
+        if(max_depth_) depth_limit_ = std::min(depth_limit_, max_depth_);
+        depth_limit_ = std::max(depth_limit_, depth);
+      }
+
+      /// Select the change of the SUMMA pipeline depth for the next step
+
+      /// When a memory bound is set, the number of concurrent SUMMA iterations
+      /// is adjusted at each step so that the memory held by in-flight
+      /// iterations stays within \c max_memory_ . This includes the argument
+      /// tiles of the broadcast panels, which are held until their
+      /// contractions have been reduced, and the result tiles of the pending
+      /// reductions. Panel sizes are computed from the tile ranges of the
+      /// panel. The pipeline shrinks when the budget is exceeded, and grows, up
+      /// to \c depth_limit_ , while one more panel of the size of the current
+      /// panel fits in the budget. Step tasks are run in order, so this
+      /// function is never called concurrently.
+      /// \param panel_bytes The size of the panel of the current step
+      /// \return The number of step tasks that are appended to the pipeline:
+      /// 0 to shrink, 1 to keep, and 2 to grow the pipeline depth.
+      size_type next_depth_step(const std::size_t panel_bytes) {
+        if(! max_memory_)
+          return 1ul;
+
+        const std::size_t bytes = bytes_in_flight_;
+        if(bytes > max_memory_) {
+          if(depth_ > 1ul) {
+            --depth_;
+            return 0ul;
+          }
+        } else if((depth_ < depth_limit_) && ((bytes + panel_bytes) <= max_memory_)) {
+          ++depth_;
+          return 2ul;
+        }
+
+        return 1ul;
+      }
+
       /// Evaluate the tiles of this tensor
 
       /// This function will evaluate the children of this distributed evaluator
@@ -1363,14 +1775,15 @@ namespace TiledArray {
           if(TensorImpl_::shape().is_dense()) {
             // We cannot have more iterations than there are blocks in the k
             // dimension
-            if(depth > k_) depth = k_;
+            if(depth > (k_end_ - k_begin_)) depth = k_end_ - k_begin_;
 
             // Modify the number of concurrent iterations based on the available
             // memory.
             depth = mem_bound_depth(depth, 0.0f, 0.0f);
 
             // Enforce user defined depth bound
-            if(max_depth_) std::min(depth, max_depth_);
+            if(max_depth_) depth = std::min(depth, max_depth_);
+            init_depth(depth);
 
             TensorImpl_::world().taskq.add(new DenseStepTask(shared_from_this(),
                                                              depth));
@@ -1390,14 +1803,15 @@ namespace TiledArray {
 
             // We cannot have more iterations than there are blocks in the k
             // dimension
-            if(depth > k_) depth = k_;
+            if(depth > (k_end_ - k_begin_)) depth = k_end_ - k_begin_;
 
             // Modify the number of concurrent iterations based on the available
             // memory and sparsity of the argument tensors.
             depth = mem_bound_depth(depth, left_sparsity, right_sparsity);
 
             // Enforce user defined depth bound
-            if(max_depth_) std::min(depth, max_depth_);
+            if(max_depth_) depth = std::min(depth, max_depth_);
+            init_depth(depth);
 
             TensorImpl_::world().taskq.add(new SparseStepTask(shared_from_this(),
                                                               depth));
@@ -21,10 +21,32 @@
 #define TILEDARRAY_DISTRIBUTED_STORAGE_H__INCLUDED
 
 #include <TiledArray/pmap/pmap.h>
+#include <TiledArray/spill_file.h>
+#include <TiledArray/type_traits.h>
+#include <atomic>
+#include <cstdlib>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
 
 namespace TiledArray {
   namespace detail {
 
+    /// The approximate size of a stored element in bytes
+
+    /// \param value The element
+    /// \return The number of bytes used to store the data of \c value
+    template <typename T>
+    inline auto element_bytes(const T& value, int) ->
+        decltype(sizeof(T) + value.size() * sizeof(typename numeric_type<T>::type))
+    { return sizeof(T) + value.size() * sizeof(typename numeric_type<T>::type); }
+
+    template <typename T>
+    inline std::size_t element_bytes(const T&, long) { return sizeof(T); }
+
     /// Distributed storage container.
 
     /// Each element in this container is owned by a single node, but any node
@@ -40,6 +62,21 @@ namespace TiledArray {
     /// can easily be achieved by only constructing world objects in the main
     /// thread. DO NOT construct world objects within tasks where the order of
     /// execution is nondeterministic.
+    ///
+    /// When the process map provides an O(1) local ordinal (see
+    /// \c Pmap::has_local_ordinal() ), local elements are stored in a table
+    /// with one slot for each local element of the process map, which is
+    /// indexed by the local ordinal of the element. Slots are filled on first
+    /// access with an atomic compare-and-swap, so accessing local elements does
+    /// not lock. Local elements of other process maps are stored in a
+    /// concurrent hash map.
+    ///
+    /// Local elements may be spilled to a file when they exceed a memory
+    /// budget, see \c set_spill() .
+    ///
+    /// Remote elements may be cached, see \c set_remote_cache() , and
+    /// requests for remote elements may be aggregated, see
+    /// \c set_aggregation() .
     template <typename T>
     class DistributedStorage : public madness::WorldObject<DistributedStorage<T> > {
     public:
@@ -59,19 +96,411 @@ namespace TiledArray {
 
       const size_type max_size_; ///< The maximum number of elements that can be stored by this container
       std::shared_ptr<pmap_interface> pmap_; ///< The process map that defines the element distribution
-      mutable container_type data_; ///< The local data container
+      mutable container_type data_; ///< The local data container (when slots are not used)
+      std::unique_ptr<std::atomic<future*>[]> slots_; ///< Local element slots, or null when the process map has no direct local ordinal
+      mutable std::atomic<size_type> size_; ///< The number of filled local element slots or spilled elements
+
+      /// Spill state of a local element
+      struct SpillInfo {
+        std::unique_ptr<future> element; ///< The element when it is in memory
+        std::size_t generation; ///< The generation of the element
+        std::size_t bytes; ///< The size of the element when it is resident
+        bool resident; ///< The element is in memory and counted in the budget
+        bool on_disk; ///< A copy of the element is stored in the spill file
+        typename std::list<key_type>::iterator lru; ///< Position in the LRU list
+        std::unique_ptr<future> pending; ///< The element while it is being written
+        SpillFile::Region region; ///< The region of the spill file that holds the element
+
+        SpillInfo() :
+          element(), generation(0ul), bytes(0ul), resident(false), on_disk(false), lru(),
+          pending(), region()
+        { }
+      }; // struct SpillInfo
+
+      /// Out-of-core storage of local elements
+
+      /// Local elements that have been assigned are kept in memory until the
+      /// total size of the resident elements exceeds the budget. The least
+      /// recently used elements are then written to the spill file and
+      /// removed from memory. Elements are immutable, so an element is
+      /// written only once, and an element that is accessed after it was
+      /// spilled is read back from the file by a task.
+      struct Spill {
+        std::mutex mutex_; ///< Spill mutex, which guards all local elements
+        const std::size_t max_bytes_; ///< The memory budget
+        std::size_t bytes_; ///< The size of the resident elements
+        std::size_t generation_; ///< Slot generation counter
+        std::unordered_map<key_type, SpillInfo> info_; ///< Spill state of the local elements
+        std::list<key_type> lru_; ///< Resident elements, most recent first
+        std::shared_ptr<SpillFile> file_; ///< The spill file
+
+        Spill(const std::size_t max_bytes, const std::string& directory) :
+          mutex_(), max_bytes_(max_bytes), bytes_(0ul), generation_(0ul),
+          info_(), lru_(), file_(std::make_shared<SpillFile>(directory))
+        { }
+      }; // struct Spill
+
+      /// Callback that adds an arrived local element to the memory budget
+      class SpillArrival : public madness::CallbackInterface {
+      private:
+        const DistributedStorage_& ds_; ///< A reference to the owning object
+        key_type key_; ///< The element key
+        std::size_t generation_; ///< The generation of the element
+
+      public:
+
+        SpillArrival(const DistributedStorage_& ds, const key_type key,
+            const std::size_t generation) :
+          ds_(ds), key_(key), generation_(generation)
+        { }
+
+        virtual ~SpillArrival() { }
+
+        virtual void notify() {
+          ds_.spill_arrival(key_, generation_);
+          delete this;
+        }
+      }; // class SpillArrival
+
+      std::shared_ptr<Spill> spill_; ///< Out-of-core storage (null when disabled)
+
+      /// Read-only cache of remote elements
+
+      /// Cached elements are discarded by the least recently used rule when
+      /// the size of the arrived elements exceeds the byte budget, and all
+      /// elements are discarded at the next fence after they were requested.
+      /// Fences are detected with a token object that is held only by the
+      /// deferred cleanup list of the world, which is cleared by each fence.
+      class RemoteCache {
+      public:
+        struct Fence { }; ///< Fence token type
+
+        /// Cache entry
+        struct Entry {
+          future value; ///< The element
+          std::size_t bytes; ///< The size of the element (zero until it has arrived)
+          std::size_t generation; ///< The generation of the entry
+          typename std::list<key_type>::iterator lru; ///< Position in the LRU list
+        }; // struct Entry
+
+        std::mutex mutex_; ///< Cache mutex
+        World& world_; ///< The world of the storage object
+        const std::size_t max_bytes_; ///< The byte budget
+        std::size_t bytes_; ///< The size of the arrived elements
+        std::size_t generation_; ///< Entry generation counter
+        std::size_t hits_; ///< The number of cache hits
+        std::size_t misses_; ///< The number of cache misses
+        std::unordered_map<key_type, Entry> entries_; ///< Cached elements
+        std::list<key_type> lru_; ///< Cached element keys, most recent first
+        std::weak_ptr<Fence> fence_; ///< Expires at the next fence
+
+        RemoteCache(World& world, const std::size_t max_bytes) :
+          mutex_(), world_(world), max_bytes_(max_bytes), bytes_(0ul),
+          generation_(0ul), hits_(0ul), misses_(0ul), entries_(), lru_(),
+          fence_()
+        { }
+
+        /// Remove all entries (the cache mutex must be locked)
+        void clear() {
+          entries_.clear();
+          lru_.clear();
+          bytes_ = 0ul;
+        }
+
+        /// Remove an entry (the cache mutex must be locked)
+        void erase(const typename std::unordered_map<key_type, Entry>::iterator it) {
+          bytes_ -= it->second.bytes;
+          lru_.erase(it->second.lru);
+          entries_.erase(it);
+        }
+
+        /// Remove the least recently used entries until the arrived elements
+        /// fit in the budget (the cache mutex must be locked)
+        void evict() {
+          while(bytes_ > max_bytes_)
+            erase(entries_.find(lru_.back()));
+        }
+
+        /// Remove all entries if a fence has occurred since they were
+        /// requested (the cache mutex must be locked)
+        void check_fence() {
+          if(fence_.expired()) {
+            clear();
+            std::shared_ptr<Fence> fence = std::make_shared<Fence>();
+            fence_ = fence;
+            madness::detail::deferred_cleanup(world_, fence);
+          }
+        }
+      }; // class RemoteCache
+
+      /// Callback that adds the size of an arrived element to the cache
+      class RemoteCacheArrival : public madness::CallbackInterface {
+      private:
+        std::shared_ptr<RemoteCache> cache_; ///< The cache
+        key_type key_; ///< The element key
+        std::size_t generation_; ///< The generation of the cache entry
+        future value_; ///< The element
+
+      public:
+
+        RemoteCacheArrival(const std::shared_ptr<RemoteCache>& cache,
+            const key_type key, const std::size_t generation, const future& value) :
+          cache_(cache), key_(key), generation_(generation), value_(value)
+        { }
+
+        virtual ~RemoteCacheArrival() { }
+
+        virtual void notify() {
+          {
+            std::lock_guard<std::mutex> lock(cache_->mutex_);
+            auto it = cache_->entries_.find(key_);
+            if((it != cache_->entries_.end()) &&
+                (it->second.generation == generation_))
+            {
+              it->second.bytes = element_bytes(value_.get(), 0);
+              cache_->bytes_ += it->second.bytes;
+              cache_->evict();
+            }
+          }
+          delete this;
+        }
+      }; // class RemoteCacheArrival
+
+      std::shared_ptr<RemoteCache> cache_; ///< Remote element cache (null when disabled)
+
+      /// Buffered requests for one process
+      struct Batch {
+        std::vector<key_type> get_keys; ///< Keys of requested elements
+        std::vector<typename future::remote_refT> get_refs; ///< Futures of requested elements
+        std::vector<key_type> set_keys; ///< Keys of assigned elements
+        std::vector<value_type> set_values; ///< Values of assigned elements
+        std::size_t bytes; ///< The approximate size of the assigned elements
+        bool flush_pending; ///< A flush task has been submitted
+
+        Batch() :
+          get_keys(), get_refs(), set_keys(), set_values(), bytes(0ul),
+          flush_pending(false)
+        { }
+
+        std::size_t size() const { return get_keys.size() + set_keys.size(); }
+      }; // struct Batch
+
+      std::size_t max_batch_size_; ///< The maximum number of requests in a batch (0 == no aggregation)
+      std::size_t max_batch_bytes_; ///< The maximum size of the elements in a batch
+      mutable std::mutex batch_mutex_; ///< Batch mutex
+      mutable std::vector<Batch> batches_; ///< Buffered requests for each process
+
+      /// Default maximum number of requests in a batch
+
+      /// \return The value of the \c TA_STORAGE_AGGREGATE environment variable,
+      /// or zero if it is not set
+      static std::size_t init_max_batch_size() {
+        const char* max_batch_size = getenv("TA_STORAGE_AGGREGATE");
+        if(max_batch_size)
+          return std::stoul(max_batch_size);
+        return 0ul;
+      }
+
+      /// Default memory budget for local elements
+
+      /// \return The value of the \c TA_SPILL_MAX_BYTES environment variable,
+      /// or zero if it is not set
+      static std::size_t init_max_spill_bytes() {
+        const char* max_spill_bytes = getenv("TA_SPILL_MAX_BYTES");
+        if(max_spill_bytes)
+          return std::stoul(max_spill_bytes);
+        return 0ul;
+      }
 
       // not allowed
       DistributedStorage(const DistributedStorage_&);
       DistributedStorage_& operator=(const DistributedStorage_&);
 
-      future get_local(const size_type i) const {
+      /// Local element slot accessor
+
+      /// \param i A local element
+      /// \return The slot of element \c i
+      std::atomic<future*>& slot(const size_type i) const {
         TA_ASSERT(pmap_->is_local(i));
+        return slots_[pmap_->local_ordinal(i)];
+      }
+
+      /// Fill an empty slot
+
+      /// \param slot The slot to be filled
+      /// \param element The element that is stored in the slot; on return it
+      /// is the element that was stored by another thread if the slot was
+      /// filled first by that thread
+      /// \return \c true if \c element was stored in the slot, otherwise
+      /// \c false
+      bool fill_slot(std::atomic<future*>& slot, future*& element) const {
+        future* empty = nullptr;
+        if(slot.compare_exchange_strong(empty, element, std::memory_order_acq_rel,
+            std::memory_order_acquire))
+        {
+          ++size_;
+          return true;
+        }
+
+        delete element;
+        element = empty;
+        return false;
+      }
+
+      /// Read a spilled element
+
+      /// \param file The spill file
+      /// \param region The region of the file that holds the element
+      /// \return The element
+      static value_type load_element(const std::shared_ptr<SpillFile>& file,
+          const SpillFile::Region& region)
+      {
+        return file->template read<value_type>(region);
+      }
+
+      /// Write a spilled element
+
+      /// The element remains available to readers from the pending slot of
+      /// its spill state until it has been written.
+      /// \param spill The out-of-core storage
+      /// \param key The element key
+      /// \param value The element
+      static void store_element(const std::shared_ptr<Spill>& spill,
+          const key_type key, const value_type& value)
+      {
+        const SpillFile::Region region = spill->file_->write(value);
+        std::lock_guard<std::mutex> lock(spill->mutex_);
+        SpillInfo& info = spill->info_[key];
+        info.region = region;
+        info.on_disk = true;
+        info.pending.reset();
+      }
+
+      /// Access a local element when spilling is enabled
+
+      /// \param i A local element
+      /// \param value The value of a new element, or a null pointer to insert
+      /// an unassigned element
+      /// \param[out] inserted \c true if a new element was inserted
+      /// \return The element
+      future get_spill_local(const size_type i, const future* value, bool& inserted) const {
+        future result;
+        std::size_t generation = 0ul;
+        inserted = false;
+        {
+          std::lock_guard<std::mutex> lock(spill_->mutex_);
+          SpillInfo& info = spill_->info_[i];
+          if(info.element) {
+            if(info.resident)
+              spill_->lru_.splice(spill_->lru_.begin(), spill_->lru_, info.lru);
+            return *info.element;
+          }
+
+          if(info.pending) {
+            // The element is being written, so return it to its slot
+            result = *info.pending;
+          } else if(info.on_disk) {
+            // Read the element with a task
+            result = get_world().taskq.add(& DistributedStorage_::load_element,
+                spill_->file_, info.region);
+          } else {
+            // Insert a new element
+            if(value)
+              result = *value;
+            inserted = true;
+            ++size_;
+          }
+
+          info.element.reset(new future(result));
+          generation = info.generation = ++spill_->generation_;
+        }
+
+        // The callback is registered after the mutex is unlocked because it is
+        // called immediately when the element has already been assigned.
+        result.register_callback(new SpillArrival(*this, i, generation));
+
+        return result;
+      }
+
+      /// Add an assigned local element to the memory budget and spill the
+      /// least recently used elements when the budget is exceeded
+
+      /// \param i A local element
+      /// \param generation The generation of the element when it was inserted
+      void spill_arrival(const size_type i, const std::size_t generation) const {
+        std::vector<std::pair<size_type, future> > writes;
+        {
+          std::lock_guard<std::mutex> lock(spill_->mutex_);
+          SpillInfo& info = spill_->info_[i];
+          if((info.generation != generation) || (! info.element) || info.resident)
+            return;
+
+          info.bytes = element_bytes(info.element->get(), 0);
+          info.resident = true;
+          spill_->lru_.push_front(i);
+          info.lru = spill_->lru_.begin();
+          spill_->bytes_ += info.bytes;
+
+          // Remove the least recently used elements from memory
+          while(spill_->bytes_ > spill_->max_bytes_) {
+            const key_type key = spill_->lru_.back();
+            spill_->lru_.pop_back();
+            SpillInfo& victim = spill_->info_[key];
+            spill_->bytes_ -= victim.bytes;
+            victim.bytes = 0ul;
+            victim.resident = false;
+            victim.generation = ++spill_->generation_;
+            if(! (victim.on_disk || victim.pending)) {
+              victim.pending.reset(new future(*victim.element));
+              writes.emplace_back(key, *victim.element);
+            }
+            victim.element.reset();
+          }
+        }
+
+        // Write the spilled elements with tasks, so the thread that assigned
+        // the element does not wait for the file
+        for(auto& write : writes)
+          get_world().taskq.add(& DistributedStorage_::store_element, spill_,
+              write.first, write.second);
+      }
+
+      /// Set an element that is already in the container
+
+      /// \param existing_f The element in the container
+      /// \param f The future for the element
+      static void set_existing(future existing_f, const future& f) {
+        // Check that the future has not been set already.
+#ifndef NDEBUG
+        if(existing_f.probe())
+          TA_EXCEPTION("Tile has already been assigned.");
+#endif // NDEBUG
+        // Set the future
+        existing_f.set(f);
+      }
 
-        // Return the local element.
-        const_accessor acc;
-        data_.insert(acc, i);
-        return acc->second;
+      future get_local(const size_type i) const {
+        if(spill_) {
+          bool inserted = false;
+          return get_spill_local(i, nullptr, inserted);
+        }
+
+        if(! slots_) {
+          // Return the local element.
+          const_accessor acc;
+          data_.insert(acc, i);
+          return acc->second;
+        }
+
+        std::atomic<future*>& s = slot(i);
+        future* element = s.load(std::memory_order_acquire);
+        if(! element) {
+          // Insert an unassigned element
+          element = new future();
+          fill_slot(s, element);
+        }
+
+        return *element;
       }
 
       void set_handler(const size_type i, const value_type& value) {
@@ -92,9 +521,170 @@ namespace TiledArray {
         remote_f.set(f);
       }
 
+      void batch_handler(const std::vector<key_type>& get_keys,
+          const std::vector<typename future::remote_refT>& get_refs,
+          const std::vector<key_type>& set_keys,
+          const std::vector<value_type>& set_values)
+      {
+        TA_ASSERT(get_keys.size() == get_refs.size());
+        TA_ASSERT(set_keys.size() == set_values.size());
+        for(std::size_t i = 0ul; i < set_keys.size(); ++i)
+          set_handler(set_keys[i], set_values[i]);
+        for(std::size_t i = 0ul; i < get_keys.size(); ++i)
+          get_handler(get_keys[i], get_refs[i]);
+      }
+
+      /// Send the buffered requests for a process
+
+      /// \param batch The requests to be sent
+      /// \param dest The process that will receive the requests
+      void send_batch(Batch& batch, const ProcessID dest) const {
+        if(batch.size() == 0ul)
+          return;
+        if(batch.size() == 1ul) {
+          // Send single requests without the batch overhead
+          if(batch.get_keys.size())
+            WorldObject_::task(dest, & DistributedStorage_::get_handler,
+                batch.get_keys.front(), batch.get_refs.front(),
+                madness::TaskAttributes::hipri());
+          else
+            WorldObject_::task(dest, & DistributedStorage_::set_handler,
+                batch.set_keys.front(), batch.set_values.front(),
+                madness::TaskAttributes::hipri());
+        } else {
+          WorldObject_::task(dest, & DistributedStorage_::batch_handler,
+              batch.get_keys, batch.get_refs, batch.set_keys, batch.set_values,
+              madness::TaskAttributes::hipri());
+        }
+      }
+
+      /// Remove the buffered requests for a process
+
+      /// The batch mutex must be locked.
+      /// \param dest The process
+      /// \return The buffered requests for \c dest
+      Batch take_batch(const ProcessID dest) const {
+        Batch batch;
+        std::swap(batch.get_keys, batches_[dest].get_keys);
+        std::swap(batch.get_refs, batches_[dest].get_refs);
+        std::swap(batch.set_keys, batches_[dest].set_keys);
+        std::swap(batch.set_values, batches_[dest].set_values);
+        std::swap(batch.bytes, batches_[dest].bytes);
+        return batch;
+      }
+
+      /// Flush task for the requests buffered for a process
+
+      /// This high priority task is submitted when the first request is added
+      /// to an empty batch, so requests do not wait in a batch behind the
+      /// tasks in the queue. Fences and futures that are waited on by the main thread
+      /// run this task, which ensures requests are always sent.
+      /// \param dest The process
+      void flush_task(const ProcessID dest) {
+        Batch batch;
+        {
+          std::lock_guard<std::mutex> lock(batch_mutex_);
+          batches_[dest].flush_pending = false;
+          batch = take_batch(dest);
+        }
+        send_batch(batch, dest);
+      }
+
+      /// Add a request to a batch and send the batch when it is full
+
+      /// \param dest The owner of the requested element
+      /// \param op The operation that adds the request to the batch
+      template <typename Op>
+      void add_to_batch(const ProcessID dest, const Op& op) const {
+        Batch batch;
+        bool submit_flush = false;
+        {
+          std::lock_guard<std::mutex> lock(batch_mutex_);
+          Batch& buffer = batches_[dest];
+          op(buffer);
+          if((buffer.size() >= max_batch_size_) || (buffer.bytes >= max_batch_bytes_)) {
+            batch = take_batch(dest);
+          } else if(! buffer.flush_pending) {
+            buffer.flush_pending = true;
+            submit_flush = true;
+          }
+        }
+
+        send_batch(batch, dest);
+        if(submit_flush)
+          WorldObject_::task(get_world().rank(),
+              & DistributedStorage_::flush_task, dest,
+              madness::TaskAttributes::hipri());
+      }
+
+      future get_remote(const size_type i) const {
+        // Send a request to the owner of i for the element.
+        future result;
+        if(max_batch_size_) {
+          const typename future::remote_refT ref = result.remote_ref(get_world());
+          add_to_batch(owner(i), [=] (Batch& batch) {
+            batch.get_keys.push_back(i);
+            batch.get_refs.push_back(ref);
+          });
+        } else {
+          WorldObject_::task(owner(i), & DistributedStorage_::get_handler, i,
+              result.remote_ref(get_world()), madness::TaskAttributes::hipri());
+        }
+
+        return result;
+      }
+
+      future get_cached(const size_type i) const {
+        std::size_t generation = 0ul;
+        future result;
+        {
+          std::lock_guard<std::mutex> lock(cache_->mutex_);
+          cache_->check_fence();
+
+          auto it = cache_->entries_.find(i);
+          if(it != cache_->entries_.end()) {
+            ++cache_->hits_;
+            cache_->lru_.splice(cache_->lru_.begin(), cache_->lru_, it->second.lru);
+            return it->second.value;
+          }
+
+          ++cache_->misses_;
+          result = get_remote(i);
+          generation = ++cache_->generation_;
+          cache_->lru_.push_front(i);
+          typename RemoteCache::Entry entry = { result, 0ul, generation,
+              cache_->lru_.begin() };
+          cache_->entries_.emplace(i, entry);
+        }
+
+        // The callback is registered after the cache is unlocked because it is
+        // called immediately when the element has already arrived.
+        result.register_callback(
+            new RemoteCacheArrival(cache_, i, generation, result));
+
+        return result;
+      }
+
+      void uncache(const size_type i) {
+        if(cache_) {
+          std::lock_guard<std::mutex> lock(cache_->mutex_);
+          auto it = cache_->entries_.find(i);
+          if(it != cache_->entries_.end())
+            cache_->erase(it);
+        }
+      }
+
       void set_remote(const size_type i, const value_type& value) {
-        WorldObject_::task(owner(i), & DistributedStorage_::set_handler,
-            i, value, madness::TaskAttributes::hipri());
+        if(max_batch_size_) {
+          add_to_batch(owner(i), [&] (Batch& batch) {
+            batch.set_keys.push_back(i);
+            batch.set_values.push_back(value);
+            batch.bytes += element_bytes(value, 0);
+          });
+        } else {
+          WorldObject_::task(owner(i), & DistributedStorage_::set_handler,
+              i, value, madness::TaskAttributes::hipri());
+        }
       }
 
       struct DelayedSet : public madness::CallbackInterface {
@@ -132,17 +722,33 @@ namespace TiledArray {
           const std::shared_ptr<pmap_interface>& pmap) :
         WorldObject_(world), max_size_(max_size),
         pmap_(pmap),
-        data_((max_size / world.size()) + 11)
+        data_(pmap->has_local_ordinal() ? 1 : (max_size / world.size()) + 11),
+        slots_(pmap->has_local_ordinal() ?
+            new std::atomic<future*>[pmap->local_size()] : nullptr),
+        size_(0ul),
+        spill_(), cache_(),
+        max_batch_size_(0ul), max_batch_bytes_(0ul), batch_mutex_(), batches_()
       {
         // Check that the process map is appropriate for this storage object
         TA_ASSERT(pmap_);
         TA_ASSERT(pmap_->size() == max_size);
         TA_ASSERT(pmap_->rank() == pmap_interface::size_type(world.rank()));
         TA_ASSERT(pmap_->procs() == pmap_interface::size_type(world.size()));
+        if(slots_)
+          for(size_type i = 0ul; i < pmap_->local_size(); ++i)
+            slots_[i].store(nullptr, std::memory_order_relaxed);
+        static const std::size_t max_batch_size = init_max_batch_size();
+        set_aggregation(max_batch_size);
+        static const std::size_t max_spill_bytes = init_max_spill_bytes();
+        set_spill(max_spill_bytes);
         WorldObject_::process_pending();
       }
 
-      virtual ~DistributedStorage() { }
+      virtual ~DistributedStorage() {
+        if(slots_)
+          for(size_type i = 0ul; i < pmap_->local_size(); ++i)
+            delete slots_[i].load(std::memory_order_relaxed);
+      }
 
       using WorldObject_::get_world;
 
@@ -178,7 +784,9 @@ namespace TiledArray {
       /// No communication.
       /// \return The number of local elements stored by the container.
       /// \throw nothing
-      size_type size() const { return data_.size(); }
+      size_type size() const {
+        return (slots_ || spill_ ? size_.load() : data_.size());
+      }
 
       /// Max size accessor
 
@@ -195,16 +803,12 @@ namespace TiledArray {
       /// \throw TiledArray::Exception If \c i is greater than or equal to \c max_size() .
       future get(size_type i) const {
         TA_ASSERT(i < max_size_);
-        if(is_local(i)) {
+        if(is_local(i))
           return get_local(i);
-        } else {
-          // Send a request to the owner of i for the element.
-          future result;
-          WorldObject_::task(owner(i), & DistributedStorage_::get_handler, i,
-              result.remote_ref(get_world()), madness::TaskAttributes::hipri());
-
-          return result;
-        }
+        else if(cache_)
+          return get_cached(i);
+        else
+          return get_remote(i);
       }
 
       /// Set element \c i with \c value
@@ -215,10 +819,12 @@ namespace TiledArray {
       /// \throw madness::MadnessException If \c i has already been set.
       void set(size_type i, const value_type& value) {
         TA_ASSERT(i < max_size_);
-        if(is_local(i))
+        if(is_local(i)) {
           set_handler(i, value);
-        else
+        } else {
+          uncache(i);
           set_remote(i, value);
+        }
       }
 
       /// Set element \c i with a \c Future \c f
@@ -233,21 +839,38 @@ namespace TiledArray {
       void set(size_type i, const future& f) {
         TA_ASSERT(i < max_size_);
         if(is_local(i)) {
-          const_accessor acc;
-          if(! data_.insert(acc, typename container_type::datumT(i, f))) {
-            // The element was already in the container, so set it with f.
-            future existing_f = acc->second;
-            acc.release();
+          if(spill_) {
+            bool inserted = false;
+            const future existing_f = get_spill_local(i, & f, inserted);
+            if(! inserted)
+              set_existing(existing_f, f);
+            return;
+          }
 
-            // Check that the future has not been set already.
-#ifndef NDEBUG
-            if(existing_f.probe())
-              TA_EXCEPTION("Tile has already been assigned.");
-#endif // NDEBUG
-            // Set the future
-            existing_f.set(f);
+          if(! slots_) {
+            const_accessor acc;
+            if(! data_.insert(acc, typename container_type::datumT(i, f))) {
+              // The element was already in the container, so set it with f.
+              const future existing_f = acc->second;
+              acc.release();
+              set_existing(existing_f, f);
+            }
+            return;
           }
+
+          std::atomic<future*>& s = slot(i);
+          future* element = s.load(std::memory_order_acquire);
+          if(! element) {
+            // Insert f into the container
+            element = new future(f);
+            if(fill_slot(s, element))
+              return;
+          }
+
+          // The element was already in the container, so set it with f.
+          set_existing(*element, f);
         } else {
+          uncache(i);
           if(f.probe()) {
             set_remote(i, f);
           } else {
@@ -257,6 +880,149 @@ namespace TiledArray {
         }
       }
 
+      /// Set the remote element cache
+
+      /// When the cache is enabled, remote elements returned by \c get() are
+      /// kept on this process, so repeated requests for the same element do
+      /// not communicate. The cache is read-only; cached elements are
+      /// discarded when they are set with \c set() from this process and at
+      /// the next fence, so elements that are modified between fences by
+      /// other processes must not be read through the cache. The least
+      /// recently used elements are discarded when the size of the cached
+      /// elements exceeds \c max_bytes . This function also discards the
+      /// cached elements and the cache counters, and it must not be called
+      /// while elements are being accessed by other threads.
+      /// \param max_bytes The maximum number of bytes of cached elements, or
+      /// zero to disable the cache
+      void set_remote_cache(const std::size_t max_bytes) {
+        if(max_bytes)
+          cache_ = std::make_shared<RemoteCache>(get_world(), max_bytes);
+        else
+          cache_.reset();
+      }
+
+      /// Remote cache hit counter
+
+      /// \return The number of remote elements found in the cache
+      std::size_t remote_cache_hits() const {
+        if(! cache_)
+          return 0ul;
+        std::lock_guard<std::mutex> lock(cache_->mutex_);
+        return cache_->hits_;
+      }
+
+      /// Remote cache miss counter
+
+      /// \return The number of remote elements that were requested from
+      /// their owner while the cache is enabled
+      std::size_t remote_cache_misses() const {
+        if(! cache_)
+          return 0ul;
+        std::lock_guard<std::mutex> lock(cache_->mutex_);
+        return cache_->misses_;
+      }
+
+      /// Set the aggregation of remote requests
+
+      /// When aggregation is enabled, requests for remote elements made with
+      /// \c get() and \c set() are buffered for each owner and sent together
+      /// in one message. A batch is sent when it holds \c max_batch_size
+      /// requests, when the assigned elements in it exceed \c max_batch_bytes ,
+      /// when the task that is submitted with the first request of the batch
+      /// runs, or when \c flush() is called. The default maximum batch size is
+      /// given by the \c TA_STORAGE_AGGREGATE environment variable, and
+      /// aggregation is disabled when it is not set. This function sends all
+      /// buffered requests, and it must not be called while elements are being
+      /// accessed by other threads.
+      /// \param max_batch_size The maximum number of requests in a batch, or
+      /// zero to disable aggregation
+      /// \param max_batch_bytes The maximum size of the assigned elements in a
+      /// batch
+      void set_aggregation(const std::size_t max_batch_size,
+          const std::size_t max_batch_bytes = 1048576ul)
+      {
+        flush();
+        max_batch_size_ = max_batch_size;
+        max_batch_bytes_ = max_batch_bytes;
+        if(max_batch_size_ && batches_.empty())
+          batches_.resize(get_world().size());
+      }
+
+      /// Send all buffered requests for remote elements
+      void flush() {
+        for(ProcessID dest = 0; dest < ProcessID(batches_.size()); ++dest) {
+          Batch batch;
+          {
+            std::lock_guard<std::mutex> lock(batch_mutex_);
+            batch = take_batch(dest);
+          }
+          send_batch(batch, dest);
+        }
+      }
+
+      /// Default spill directory
+
+      /// \return The value of the \c TA_SPILL_DIR or \c TMPDIR environment
+      /// variable, or \c /tmp if neither is set
+      static std::string spill_directory() {
+        const char* directory = getenv("TA_SPILL_DIR");
+        if(! directory)
+          directory = getenv("TMPDIR");
+        return (directory ? std::string(directory) : std::string("/tmp"));
+      }
+
+      /// Set the out-of-core storage of local elements
+
+      /// When spilling is enabled, local elements are kept in memory until
+      /// the total size of the assigned local elements exceeds \c max_bytes .
+      /// The least recently used elements are then written to a spill file in
+      /// \c directory and removed from memory, and they are read back by a
+      /// task when they are accessed again (see \c prefetch() ). Elements that
+      /// are still referenced elsewhere, for example by futures returned by
+      /// \c get(), remain in memory until those references are released.
+      /// Spilled elements are written to the file by tasks. Accessing local
+      /// elements locks a mutex when spilling is enabled. The default memory
+      /// budget is given by the \c TA_SPILL_MAX_BYTES environment variable,
+      /// and spilling is disabled when it is not set. This function must be
+      /// called before any local element is inserted.
+      /// \param max_bytes The memory budget for local elements in bytes, or
+      /// zero to disable spilling
+      /// \param directory The directory of the spill file (default is the
+      /// value of \c TA_SPILL_DIR or \c TMPDIR , or \c /tmp )
+      /// \throw TiledArray::Exception When the spill file cannot be created
+      void set_spill(const std::size_t max_bytes,
+          const std::string& directory = spill_directory())
+      {
+        TA_ASSERT(size() == 0ul);
+        if(max_bytes)
+          spill_ = std::make_shared<Spill>(max_bytes, directory);
+        else
+          spill_.reset();
+      }
+
+      /// Resident local element size
+
+      /// \return The size in bytes of the assigned local elements that are in
+      /// memory when spilling is enabled, otherwise zero
+      std::size_t resident_bytes() const {
+        if(! spill_)
+          return 0ul;
+        std::lock_guard<std::mutex> lock(spill_->mutex_);
+        return spill_->bytes_;
+      }
+
+      /// Prefetch a local element
+
+      /// Start reading element \c i from the spill file if it has been
+      /// spilled. This function does nothing when spilling is disabled or
+      /// \c i is not local.
+      /// \param i The element to prefetch
+      void prefetch(size_type i) const {
+        TA_ASSERT(i < max_size_);
+        if(spill_ && is_local(i))
+          get_local(i);
+      }
+
     }; // class DistributedStorage
 
   }  // namespace detail
@@ -226,6 +226,17 @@ namespace TiledArray {
         right_.print(os, vars_);
         os.dec();
       }
+
+      /// Expression plan
+
+      /// \tparam Plan The expression plan type
+      /// \param result The expression plan
+      template <typename Plan>
+      void plan(Plan& result) const {
+        left_.plan(result);
+        right_.plan(result);
+        ExprEngine_::plan_tiles(result, 1.0);
+      }
     }; // class BinaryEngine
 
   }  // namespace expressions
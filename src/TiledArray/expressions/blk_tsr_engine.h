@@ -260,6 +260,14 @@ namespace TiledArray {
         return ss.str();
       }
 
+      /// Expression plan
+
+      /// Block tiles are shifted copies of the array tiles.
+      /// \tparam Plan The expression plan type
+      /// \param result The expression plan
+      template <typename Plan>
+      void plan(Plan& result) const { ExprEngine_::plan_tiles(result, 0.0); }
+
     }; // class BlkTsrEngineBase
 
 
@@ -519,6 +527,13 @@ namespace TiledArray {
         return BlkTsrEngineBase_::make_tag() + ss.str();
       }
 
+      /// Expression plan
+
+      /// \tparam Plan The expression plan type
+      /// \param result The expression plan
+      template <typename Plan>
+      void plan(Plan& result) const { ExprEngine_::plan_tiles(result, 1.0); }
+
     }; // class ScalBlkTsrEngine
 
 
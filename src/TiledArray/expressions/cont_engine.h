@@ -27,6 +27,7 @@
 #define TILEDARRAY_EXPRESSIONS_CONT_ENGINE_H__INCLUDED
 
 #include <TiledArray/expressions/binary_engine.h>
+#include <TiledArray/expressions/cont_plan_cache.h>
 #include <TiledArray/dist_eval/contraction_eval.h>
 #include <TiledArray/tile_op/contract_reduce.h>
 #include <TiledArray/proc_grid.h>
@@ -91,6 +92,23 @@ namespace TiledArray {
         permute_to_no_trans = 3,
       } TensorOp;
 
+      template <typename T>
+      struct is_strided_tile : public std::false_type { };
+
+      template <typename T, typename A>
+      struct is_strided_tile<TiledArray::Tensor<T, A> > :
+          public TiledArray::detail::is_numeric<T> { };
+
+      /// Permuted argument tiles can be contracted without forming permuted
+      /// copies when both argument tiles are plain numeric tensors.
+      static constexpr bool strided_contraction =
+          is_strided_tile<typename eval_trait<typename left_type::value_type>::type>::value &&
+          is_strided_tile<typename eval_trait<typename right_type::value_type>::type>::value;
+
+      typedef ContPlanCache<trange_type, shape_type> plan_cache_type; ///< Contraction plan cache type
+      typedef typename plan_cache_type::Plan plan_type; ///< Contraction plan type
+      typedef typename plan_cache_type::Distribution distribution_type; ///< Contraction distribution type
+
     protected:
 
       scalar_type factor_; ///< Contraction scaling factor
@@ -104,6 +122,7 @@ namespace TiledArray {
       op_type op_; ///< Tile operation
       TiledArray::detail::ProcGrid proc_grid_; ///< Process grid for the contraction
       size_type K_; ///< Inner dimension size
+      std::shared_ptr<plan_type> plan_; ///< The contraction plan
 
 
       static unsigned int
@@ -116,6 +135,35 @@ namespace TiledArray {
         return i;
       }
 
+      /// Fused tile extents
+
+      /// \tparam TRange The tiled range type
+      /// \param trange The tiled range
+      /// \param first The first dimension that is fused
+      /// \param last One past the last dimension that is fused
+      /// \return The number of elements in each fused tile of dimensions
+      /// [first, last), in row-major order
+      template <typename TRange>
+      static std::vector<size_type>
+      fused_tile_sizes(const TRange& trange, const unsigned int first,
+          const unsigned int last)
+      {
+        std::vector<size_type> sizes(1ul, 1ul);
+        for(unsigned int d = first; d < last; ++d) {
+          const auto& trange1 = trange.data()[d];
+          std::vector<size_type> temp;
+          temp.reserve(sizes.size() * (trange1.tiles_range().second -
+              trange1.tiles_range().first));
+          for(const size_type size : sizes) {
+            for(auto t = trange1.tiles_range().first; t < trange1.tiles_range().second; ++t)
+              temp.push_back(size * (trange1.tile(t).second - trange1.tile(t).first));
+          }
+          sizes.swap(temp);
+        }
+
+        return sizes;
+      }
+
     public:
 
       /// Constructor
@@ -127,7 +175,7 @@ namespace TiledArray {
       ContEngine(const MultExpr<L, R>& expr) :
         BinaryEngine_(expr), factor_(1), left_vars_(), right_vars_(),
         left_op_(permute_to_no_trans), right_op_(permute_to_no_trans), op_(),
-        proc_grid_(), K_(1u)
+        proc_grid_(), K_(1u), plan_()
       { }
 
       /// Constructor
@@ -140,7 +188,7 @@ namespace TiledArray {
       ContEngine(const ScalMultExpr<L, R, S>& expr) :
         BinaryEngine_(expr), factor_(expr.factor()), left_vars_(), right_vars_(),
         left_op_(permute_to_no_trans), right_op_(permute_to_no_trans), op_(),
-        proc_grid_(), K_(1u)
+        proc_grid_(), K_(1u), plan_()
       { }
 
       // Pull base class functions into this class.
@@ -348,10 +396,25 @@ namespace TiledArray {
       /// for the result tensor as well as the tile operation.
       /// \param target_vars The target variable list for the result tensor
       void init_struct(const VariableList& target_vars) {
+        // Arguments that must be permuted are contracted with a strided kernel,
+        // when supported, instead of permuting the argument tiles.
+        if(strided_contraction) {
+          if(left_op_ == permute_to_no_trans)
+            left_.permute_tiles(false);
+          if(right_op_ == permute_to_no_trans)
+            right_.permute_tiles(false);
+        }
+
         // Initialize children
         left_.init_struct(left_vars_);
         right_.init_struct(right_vars_);
 
+        // The argument tile permutations that are applied by the contraction
+        const Permutation left_perm = (strided_contraction &&
+            (left_op_ == permute_to_no_trans) ? left_.perm() : Permutation());
+        const Permutation right_perm = (strided_contraction &&
+            (right_op_ == permute_to_no_trans) ? right_.perm() : Permutation());
+
         // Initialize the tile operation in this function because it is used to
         // evaluate the tiled range and shape.
 
@@ -361,21 +424,46 @@ namespace TiledArray {
             (right_op_ == trans ? madness::cblas::Trans : madness::cblas::NoTrans);
 
 
+        // Find the plan of an identical contraction, which holds the result
+        // tiled range and shape.
+        std::shared_ptr<plan_type> key = std::make_shared<plan_type>();
+        key->signature = left_vars_.string() + "*" + right_vars_.string() +
+            "=" + vars_.string() + "->" + target_vars.string();
+        key->abs_factor = std::abs(factor_);
+        key->threshold = detail::shape_threshold(left_.shape());
+        key->left_trange = left_.trange();
+        key->right_trange = right_.trange();
+        key->left_shape = detail::shape_fingerprint(left_.shape());
+        key->right_shape = detail::shape_fingerprint(right_.shape());
+        plan_ = plan_cache_type::find(*key);
+
         if(target_vars != vars_) {
           // Initialize permuted structure
           perm_ = ExprEngine_::make_perm(target_vars);
           op_ = op_type(left_op, right_op, factor_, vars_.dim(), left_vars_.dim(),
-              right_vars_.dim(), (permute_tiles_ ? perm_ : Permutation()));
-          trange_ = ContEngine_::make_trange(perm_);
-          shape_ = ContEngine_::make_shape(perm_);
+              right_vars_.dim(), (permute_tiles_ ? perm_ : Permutation()),
+              left_perm, right_perm);
+          if(! plan_) {
+            key->trange = ContEngine_::make_trange(perm_);
+            key->shape = ContEngine_::make_shape(perm_);
+          }
         } else {
           // Initialize non-permuted structure
           op_ = op_type(left_op, right_op, factor_, vars_.dim(), left_vars_.dim(),
-              right_vars_.dim());
-          trange_ = ContEngine_::make_trange();
-          shape_ = ContEngine_::make_shape();
+              right_vars_.dim(), Permutation(), left_perm, right_perm);
+          if(! plan_) {
+            key->trange = ContEngine_::make_trange();
+            key->shape = ContEngine_::make_shape();
+          }
         }
 
+        if(! plan_) {
+          plan_cache_type::insert(key);
+          plan_ = key;
+        }
+        trange_ = plan_->trange;
+        shape_ = plan_->shape;
+
         if(ExprEngine_::override_ptr_ && ExprEngine_::override_ptr_->shape){
             shape_ = shape_.mask(*ExprEngine_::override_ptr_->shape);
         } 
@@ -404,29 +492,61 @@ namespace TiledArray {
             right_.trange().elements_range().extent_data();
 
         // Compute the fused sizes of the contraction
-        size_type M = 1ul, m = 1ul, N = 1ul, n = 1ul;
+        size_type M = 1ul, m = 1ul, N = 1ul, n = 1ul, k = 1ul;
         unsigned int i = 0u;
         for(; i < left_outer_rank; ++i) {
           M *= left_tiles_size[i];
           m *= left_element_size[i];
         }
-        for(; i < left_rank; ++i)
+        for(; i < left_rank; ++i) {
           K_ *= left_tiles_size[i];
+          k *= left_element_size[i];
+        }
         for(i = inner_rank; i < right_rank; ++i) {
           N *= right_tiles_size[i];
           n *= right_element_size[i];
         }
 
-        // Construct the process grid.
-        proc_grid_ = TiledArray::detail::ProcGrid(*world, M, N, m, n);
+        // Reuse the process grid and process maps of the contraction plan when
+        // they were constructed for this world.
+        const unsigned int user_layers = (ExprEngine_::override_ptr_ ?
+            ExprEngine_::override_ptr_->summa_layers : 0u);
+        std::shared_ptr<const distribution_type> distribution =
+            plan_cache_type::get_distribution(*plan_, *world, user_layers);
+
+        if(! distribution) {
+          // Select the number of SUMMA process layers. The user defined value
+          // takes precedence over the memory bounded optimum.
+          size_type layers = 0ul;
+          if(user_layers)
+            layers = user_layers;
+          else
+            layers = TiledArray::detail::ProcGrid::optimal_layers(world->size(),
+                K_, m, n, k, sizeof(typename numeric_type<value_type>::type),
+                TiledArray::detail::Summa<typename left_type::dist_eval_type,
+                    typename right_type::dist_eval_type, op_type,
+                    typename Derived::policy>::max_memory());
+          layers = std::max<size_type>(1ul, std::min<size_type>(layers,
+              std::min<size_type>(K_, world->size())));
+
+          // Construct the process grid and process maps.
+          const TiledArray::detail::ProcGrid proc_grid(*world, M, N, m, n, layers);
+          distribution = std::make_shared<const distribution_type>(
+              distribution_type{ world->id(), user_layers, proc_grid,
+              proc_grid.make_row_phase_pmap(K_), proc_grid.make_col_phase_pmap(K_),
+              proc_grid.make_pmap() });
+          plan_cache_type::set_distribution(*plan_, distribution);
+        }
+
+        proc_grid_ = distribution->proc_grid;
 
         // Initialize children
-        left_.init_distribution(world, proc_grid_.make_row_phase_pmap(K_));
-        right_.init_distribution(world, proc_grid_.make_col_phase_pmap(K_));
+        left_.init_distribution(world, distribution->left_pmap);
+        right_.init_distribution(world, distribution->right_pmap);
 
         // Initialize the process map in not already defined
         if(! pmap)
-          pmap = proc_grid_.make_pmap();
+          pmap = distribution->pmap;
         ExprEngine_::init_distribution(world, pmap);
       }
 
@@ -553,6 +673,66 @@ namespace TiledArray {
         os.dec();
       }
 
+      /// Expression plan
+
+      /// The floating point operations are counted for each pair of
+      /// non-zero argument tiles, and argument tiles are broadcast to the
+      /// other processes of a process grid row or column.
+      /// \tparam Plan The expression plan type
+      /// \param result The expression plan
+      template <typename Plan>
+      void plan(Plan& result) const {
+        left_.plan(result);
+        right_.plan(result);
+
+        const unsigned int inner_rank = op_.gemm_helper().num_contract_ranks();
+        const unsigned int left_rank = op_.gemm_helper().left_rank();
+        const unsigned int right_rank = op_.gemm_helper().right_rank();
+        const unsigned int left_outer_rank = left_rank - inner_rank;
+
+        // Get the element extents of the fused argument tiles
+        const std::vector<size_type> m_sizes =
+            fused_tile_sizes(left_.trange(), 0u, left_outer_rank);
+        const std::vector<size_type> k_sizes =
+            fused_tile_sizes(left_.trange(), left_outer_rank, left_rank);
+        const std::vector<size_type> n_sizes =
+            fused_tile_sizes(right_.trange(), inner_rank, right_rank);
+        const size_type M = m_sizes.size(), N = n_sizes.size();
+        TA_ASSERT(k_sizes.size() == K_);
+
+        // Sum the outer extents of the non-zero argument tiles for each k
+        std::vector<double> left_k(K_, 0.0), right_k(K_, 0.0);
+        for(size_type i = 0ul, x = 0ul; i < M; ++i)
+          for(size_type k = 0ul; k < K_; ++k, ++x)
+            if(! left_.shape().is_zero(x))
+              left_k[k] += double(m_sizes[i]);
+        for(size_type k = 0ul, x = 0ul; k < K_; ++k)
+          for(size_type j = 0ul; j < N; ++j, ++x)
+            if(! right_.shape().is_zero(x))
+              right_k[k] += double(n_sizes[j]);
+
+        double left_elements = 0.0, right_elements = 0.0;
+        for(size_type k = 0ul; k < K_; ++k) {
+          result.flops += 2.0 * double(k_sizes[k]) * left_k[k] * right_k[k];
+          left_elements += double(k_sizes[k]) * left_k[k];
+          right_elements += double(k_sizes[k]) * right_k[k];
+        }
+
+        // Left tiles are broadcast along process rows and right tiles along
+        // process columns.
+        typedef typename numeric_type<typename eval_trait<
+            typename left_type::value_type>::type>::type left_numeric_type;
+        typedef typename numeric_type<typename eval_trait<
+            typename right_type::value_type>::type>::type right_numeric_type;
+        result.broadcast_bytes += std::size_t(
+            left_elements * double(sizeof(left_numeric_type)) *
+                double(proc_grid_.proc_cols() - 1ul) +
+            right_elements * double(sizeof(right_numeric_type)) *
+                double(proc_grid_.proc_rows() - 1ul));
+
+        ExprEngine_::plan_tiles(result, 0.0);
+      }
+
     }; // class ContEngine
 
   }  // namespace expressions
@@ -0,0 +1,330 @@
+/*
+ *  This file is a part of TiledArray.
+ *  Copyright (C) 2016  Virginia Tech
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef TILEDARRAY_EXPRESSIONS_CONT_PLAN_CACHE_H__INCLUDED
+#define TILEDARRAY_EXPRESSIONS_CONT_PLAN_CACHE_H__INCLUDED
+
+#include <TiledArray/proc_grid.h>
+#include <TiledArray/shape.h>
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+
+namespace TiledArray {
+  namespace expressions {
+    namespace detail {
+
+      /// Hash a block of memory
+
+      /// This is the 64-bit FNV-1a hash, which is used to fingerprint shape
+      /// data.
+      /// \param data A pointer to the first byte
+      /// \param size The number of bytes
+      /// \param seed The hash of preceding data
+      /// \return The hash of \c data combined with \c seed
+      inline std::uint64_t
+      hash_bytes(const void* const data, const std::size_t size,
+          std::uint64_t seed = 14695981039346656037ull)
+      {
+        const unsigned char* restrict const bytes =
+            static_cast<const unsigned char*>(data);
+        for(std::size_t i = 0ul; i < size; ++i) {
+          seed ^= bytes[i];
+          seed *= 1099511628211ull;
+        }
+        return seed;
+      }
+
+      /// Fingerprint of the shape of a contraction argument
+
+      /// Plans are keyed on the fingerprint of the argument shapes instead of
+      /// copies of the shapes, so a plan does not hold the data of argument
+      /// shapes that have changed. The fingerprint is a hash of the tile
+      /// norms; shapes with different norms have different fingerprints with
+      /// overwhelming probability.
+      /// \return The fingerprint of the shape
+      inline std::uint64_t shape_fingerprint(const DenseShape&) { return 0ull; }
+
+      template <typename T>
+      inline std::uint64_t shape_fingerprint(const SparseShape<T>& shape) {
+        if(shape.empty())
+          return 0ull;
+        const std::size_t size = shape.data().size();
+        return hash_bytes(shape.data().data(), size * sizeof(T),
+            hash_bytes(& size, sizeof(size)));
+      }
+
+      template <typename T>
+      inline std::uint64_t shape_fingerprint(const CompressedSparseShape<T>& shape) {
+        if(shape.empty())
+          return 0ull;
+        const std::vector<typename CompressedSparseShape<T>::size_type>& ordinals =
+            shape.nonzero_ordinals();
+        const std::vector<T>& norms = shape.nonzero_norms();
+        const std::size_t size = ordinals.size();
+        return hash_bytes(norms.data(), norms.size() * sizeof(T),
+            hash_bytes(ordinals.data(), size * sizeof(ordinals[0]),
+            hash_bytes(& size, sizeof(size))));
+      }
+
+      /// The zero tile threshold of a shape type
+
+      /// \return The threshold that is used to compute shapes
+      inline double shape_threshold(const DenseShape&) { return 0.0; }
+
+      template <typename T>
+      inline double shape_threshold(const SparseShape<T>&) {
+        return SparseShape<T>::threshold();
+      }
+
+      template <typename T>
+      inline double shape_threshold(const CompressedSparseShape<T>&) {
+        return CompressedSparseShape<T>::threshold();
+      }
+
+    } // namespace detail
+
+    /// Contraction plan cache
+
+    /// Iterative algorithms evaluate the same contraction expressions, with
+    /// the same tiled ranges and often the same argument shapes, many times.
+    /// A contraction plan holds the result tiled range and shape, which
+    /// requires a shape contraction, and the process grid and process maps
+    /// that are used to evaluate a contraction. Plans are keyed on the
+    /// variable lists of the contraction, the scaling factor, the tiled
+    /// ranges of the arguments, and fingerprints of the argument shapes, so a
+    /// plan is not used when an argument shape changes. A plan for a
+    /// contraction whose argument shapes have changed replaces the previous
+    /// plan of that contraction and keeps its distribution, which does not
+    /// depend on the shapes. The least recently used plans are discarded
+    /// when the cache is full.
+    ///
+    /// Distributions are keyed on the id of their world, which is not reused
+    /// by later worlds, and are released when their world no longer exists.
+    /// \tparam TRange The tiled range type
+    /// \tparam Shape The shape type
+    template <typename TRange, typename Shape>
+    class ContPlanCache {
+    public:
+      typedef TiledArray::detail::ProcGrid proc_grid_type; ///< Process grid type
+      typedef TiledArray::Pmap pmap_interface; ///< Process map interface type
+
+      /// The distribution of a contraction in a world
+      struct Distribution {
+        unsigned long world_id; ///< The id of the world of the process grid
+        unsigned int layers; ///< The requested number of process layers
+        proc_grid_type proc_grid; ///< The process grid
+        std::shared_ptr<pmap_interface> left_pmap; ///< The left-hand process map
+        std::shared_ptr<pmap_interface> right_pmap; ///< The right-hand process map
+        std::shared_ptr<pmap_interface> pmap; ///< The result process map
+      }; // struct Distribution
+
+      /// Contraction plan
+      struct Plan {
+        // Plan key
+        std::string signature; ///< The variable lists of the contraction
+        double abs_factor; ///< The absolute value of the scaling factor
+        double threshold; ///< The zero tile threshold of the shapes
+        TRange left_trange; ///< The left-hand argument tiled range
+        TRange right_trange; ///< The right-hand argument tiled range
+        std::uint64_t left_shape; ///< The left-hand argument shape fingerprint
+        std::uint64_t right_shape; ///< The right-hand argument shape fingerprint
+
+        // Result structure
+        TRange trange; ///< The result tiled range
+        Shape shape; ///< The result shape
+
+        /// The result distribution, which is set by the first evaluation in a
+        /// world (access with \c get_distribution() and
+        /// \c set_distribution() )
+        std::shared_ptr<const Distribution> distribution;
+
+        Plan() :
+          signature(), abs_factor(0.0), threshold(0.0), left_trange(),
+          right_trange(), left_shape(0ull), right_shape(0ull), trange(),
+          shape(), distribution()
+        { }
+
+        /// Compare the contraction of this plan with that of \c other
+
+        /// \param other The other plan
+        /// \return \c true if the plans have equal keys, except for the
+        /// argument shapes
+        bool is_same_contraction(const Plan& other) const {
+          return (signature == other.signature) &&
+              (abs_factor == other.abs_factor) &&
+              (threshold == other.threshold) &&
+              (left_trange == other.left_trange) &&
+              (right_trange == other.right_trange);
+        }
+
+        /// Compare the key of this plan with that of \c other
+
+        /// \param other The other plan
+        /// \return \c true if the plans are equal
+        bool is_same(const Plan& other) const {
+          return (left_shape == other.left_shape) &&
+              (right_shape == other.right_shape) &&
+              is_same_contraction(other);
+        }
+      }; // struct Plan
+
+    private:
+
+      std::mutex mutex_; ///< Cache mutex
+      std::list<std::shared_ptr<Plan> > plans_; ///< Plans, most recent first
+      std::size_t capacity_; ///< The maximum number of plans
+
+      ContPlanCache() : mutex_(), plans_(), capacity_(64ul) { }
+
+      static ContPlanCache& instance() {
+        static ContPlanCache cache;
+        return cache;
+      }
+
+      /// Release the distributions of worlds that have been destroyed
+
+      /// The cache mutex must be locked by the caller.
+      void release_distributions() {
+        for(const std::shared_ptr<Plan>& plan : plans_)
+          if(plan->distribution && ! (madness::initialized() &&
+              madness::World::world_from_id(plan->distribution->world_id)))
+            plan->distribution.reset();
+      }
+
+    public:
+
+      /// Find a plan
+
+      /// \param key A plan with the key members set
+      /// \return The cached plan equal to \c key, or a null pointer if there
+      /// is no such plan
+      static std::shared_ptr<Plan> find(const Plan& key) {
+        ContPlanCache& cache = instance();
+        std::lock_guard<std::mutex> lock(cache.mutex_);
+        for(auto it = cache.plans_.begin(); it != cache.plans_.end(); ++it) {
+          if((*it)->is_same(key)) {
+            // Move the plan to the front of the list
+            cache.plans_.splice(cache.plans_.begin(), cache.plans_, it);
+            return cache.plans_.front();
+          }
+        }
+
+        return std::shared_ptr<Plan>();
+      }
+
+      /// Insert a plan
+
+      /// \param plan The plan to be added to the cache
+      static void insert(const std::shared_ptr<Plan>& plan) {
+        ContPlanCache& cache = instance();
+        std::lock_guard<std::mutex> lock(cache.mutex_);
+        if(cache.capacity_ == 0ul)
+          return;
+
+        // Replace the plan of the same contraction with other argument shapes
+        for(auto it = cache.plans_.begin(); it != cache.plans_.end(); ++it) {
+          if((*it)->is_same_contraction(*plan)) {
+            if(! plan->distribution)
+              plan->distribution = (*it)->distribution;
+            cache.plans_.erase(it);
+            break;
+          }
+        }
+
+        cache.release_distributions();
+        cache.plans_.push_front(plan);
+        while(cache.plans_.size() > cache.capacity_)
+          cache.plans_.pop_back();
+      }
+
+      /// Set the distribution of a plan
+
+      /// \param plan The plan to be modified
+      /// \param distribution The distribution of the contraction
+      static void set_distribution(Plan& plan,
+          const std::shared_ptr<const Distribution>& distribution)
+      {
+        std::lock_guard<std::mutex> lock(instance().mutex_);
+        plan.distribution = distribution;
+      }
+
+      /// Get the distribution of a plan
+
+      /// \param plan The plan
+      /// \param world The world of the contraction
+      /// \param layers The requested number of process layers
+      /// \return The distribution of \c plan if it was set for \c world and
+      /// \c layers , otherwise a null pointer
+      static std::shared_ptr<const Distribution>
+      get_distribution(const Plan& plan, const World& world,
+          const unsigned int layers)
+      {
+        std::lock_guard<std::mutex> lock(instance().mutex_);
+        if(plan.distribution && (plan.distribution->world_id == world.id()) &&
+            (plan.distribution->layers == layers))
+          return plan.distribution;
+        return std::shared_ptr<const Distribution>();
+      }
+
+      /// Set the cache capacity
+
+      /// A capacity of zero disables the cache.
+      /// \param capacity The maximum number of cached plans
+      static void capacity(const std::size_t capacity) {
+        ContPlanCache& cache = instance();
+        std::lock_guard<std::mutex> lock(cache.mutex_);
+        cache.capacity_ = capacity;
+        while(cache.plans_.size() > cache.capacity_)
+          cache.plans_.pop_back();
+      }
+
+      /// Cache capacity accessor
+
+      /// \return The maximum number of cached plans
+      static std::size_t capacity() {
+        ContPlanCache& cache = instance();
+        std::lock_guard<std::mutex> lock(cache.mutex_);
+        return cache.capacity_;
+      }
+
+      /// The number of cached plans
+
+      /// \return The number of plans in the cache
+      static std::size_t size() {
+        ContPlanCache& cache = instance();
+        std::lock_guard<std::mutex> lock(cache.mutex_);
+        return cache.plans_.size();
+      }
+
+      /// Remove all plans from the cache
+      static void clear() {
+        ContPlanCache& cache = instance();
+        std::lock_guard<std::mutex> lock(cache.mutex_);
+        cache.plans_.clear();
+      }
+
+    }; // class ContPlanCache
+
+  }  // namespace expressions
+} // namespace TiledArray
+
+#endif // TILEDARRAY_EXPRESSIONS_CONT_PLAN_CACHE_H__INCLUDED
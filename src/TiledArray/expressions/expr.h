@@ -27,6 +27,7 @@
 #define TILEDARRAY_EXPRESSIONS_EXPR_H__INCLUDED
 
 #include <TiledArray/expressions/expr_engine.h>
+#include <TiledArray/expressions/expr_plan.h>
 #include <TiledArray/reduce_task.h>
 #include <TiledArray/tile_op/unary_reduction.h>
 #include <TiledArray/tile_op/binary_reduction.h>
@@ -46,7 +47,9 @@ namespace TiledArray {
     template <typename Engine>
     struct EngineParamOverride {
 
-      EngineParamOverride() : world(nullptr), pmap(), shape(nullptr) {}
+      EngineParamOverride() :
+        world(nullptr), pmap(), shape(nullptr), summa_layers(0u)
+      { }
 
       typedef typename EngineTrait<Engine>::policy policy; ///< The result policy type
       typedef typename EngineTrait<Engine>::shape_type shape_type; ///< Tensor shape type
@@ -55,6 +58,7 @@ namespace TiledArray {
        World* world;
        std::shared_ptr<pmap_interface> pmap;
        const shape_type* shape;
+       unsigned int summa_layers; ///< Number of SUMMA process layers (0 = automatic)
     };
 
     /// \brief type trait checks if T has array() member
@@ -129,6 +133,19 @@ namespace TiledArray {
         }
         return derived();
       }
+      /// \param layers The number of process layers used by the 2.5D SUMMA
+      /// algorithm to evaluate a contraction expression; \c 0 selects the
+      /// number of layers automatically, based on the SUMMA memory limit.
+      /// \note This parameter is ignored by non-contraction expressions.
+      Expr<Derived>& set_summa_layers(const unsigned int layers) {
+        if (override_ptr_) {
+          override_ptr_->summa_layers = layers;
+        } else {
+          override_ptr_ = std::make_shared<override_type>();
+          override_ptr_->summa_layers = layers;
+        }
+        return derived();
+      }
 
     private:
 
@@ -375,6 +392,44 @@ namespace TiledArray {
         result.swap(tsr.array());
       }
 
+      /// Plan the evaluation of this expression
+
+      /// The result tiled range, shape, and distribution are computed as they
+      /// would be by <tt>eval_to(tsr)</tt>, but no tiles are evaluated and
+      /// \c tsr is not modified. The shape algebra of the expression is
+      /// evaluated by every process, so this function does not communicate.
+      /// \tparam A The array type
+      /// \tparam Alias Tile alias flag
+      /// \param tsr The tensor that the expression would be assigned to
+      /// \return The predicted result structure and cost of the evaluation
+      template <typename A, bool Alias>
+      ExprPlan<typename EngineTrait<engine_type>::trange_type,
+          typename EngineTrait<engine_type>::shape_type>
+      plan(const TsrExpr<A, Alias>& tsr) const {
+        // Get the target world and process map as in eval_to()
+        const auto has_set_world = override_ptr_ && override_ptr_->world;
+        World& world = (tsr.array().is_initialized() ?
+            tsr.array().world() :
+            (has_set_world ? *override_ptr_->world : TiledArray::get_default_world()));
+
+        std::shared_ptr<typename TsrExpr<A, Alias>::array_type::pmap_interface> pmap;
+        if(tsr.array().is_initialized())
+          pmap = tsr.array().pmap();
+
+        // Construct and initialize the expression engine
+        engine_type engine(derived());
+        engine.init(world, pmap, VariableList(tsr.vars()));
+
+        ExprPlan<typename EngineTrait<engine_type>::trange_type,
+            typename EngineTrait<engine_type>::shape_type>
+        result(engine.world()->size());
+        engine.plan(result);
+        result.trange = engine.trange();
+        result.shape = engine.shape();
+
+        return result;
+      }
+
       /// Expression print
 
       /// \param os The output stream
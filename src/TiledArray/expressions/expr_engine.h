@@ -27,6 +27,7 @@
 #define TILEDARRAY_EXPRESSIONS_EXPR_ENGINE_H__INCLUDED
 
 #include <TiledArray/madness.h>
+#include <TiledArray/type_traits.h>
 #include <TiledArray/expressions/expr_trace.h>
 
 namespace TiledArray {
@@ -236,6 +237,40 @@ namespace TiledArray {
         }
       }
 
+      /// Add the result tiles of this expression to an expression plan
+
+      /// Each non-zero tile of the result is counted on the process that owns
+      /// it.
+      /// \tparam Plan The expression plan type
+      /// \param result The expression plan
+      /// \param flops_per_element The number of floating point operations
+      /// required to compute one element of the result
+      template <typename Plan>
+      void plan_tiles(Plan& result, const double flops_per_element) const {
+        const size_type element_bytes =
+            sizeof(typename numeric_type<value_type>::type);
+        const size_type volume = trange_.tiles_range().volume();
+        for(size_type i = 0ul; i < volume; ++i) {
+          if(shape_.is_zero(i))
+            continue;
+          const size_type tile_volume = trange_.make_tile_range(i).volume();
+          result.add_tile(pmap_->owner(i), tile_volume * element_bytes);
+          result.flops += flops_per_element * double(tile_volume);
+        }
+      }
+
+      /// Expression plan
+
+      /// Only permuted copies of the argument tiles are counted; derived
+      /// classes that compute new tiles provide their own implementation.
+      /// \tparam Plan The expression plan type
+      /// \param result The expression plan
+      template <typename Plan>
+      void plan(Plan& result) const {
+        if(perm_ && permute_tiles_)
+          plan_tiles(result, 0.0);
+      }
+
       /// Expression identification tag
 
       /// \return An expression tag used to identify this expression
@@ -0,0 +1,91 @@
+/*
+ *  This file is a part of TiledArray.
+ *  Copyright (C) 2016  Virginia Tech
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef TILEDARRAY_EXPRESSIONS_EXPR_PLAN_H__INCLUDED
+#define TILEDARRAY_EXPRESSIONS_EXPR_PLAN_H__INCLUDED
+
+#include <algorithm>
+#include <cstddef>
+#include <iostream>
+#include <vector>
+
+namespace TiledArray {
+  namespace expressions {
+
+    /// Predicted cost of an expression evaluation
+
+    /// An expression plan is computed from the tiled ranges, shapes, and
+    /// process maps of the expression graph without evaluating any tiles (see
+    /// \c Expr::plan() ). Memory is counted as the tiles that are created by
+    /// each node of the graph, i.e. the result tiles and permuted or scaled
+    /// copies of the arguments, on the process that owns them. All tiles of
+    /// the graph are counted as if they were held at the same time, so
+    /// \c memory is an upper bound.
+    /// \tparam TRange The tiled range type
+    /// \tparam Shape The shape type
+    template <typename TRange, typename Shape>
+    struct ExprPlan {
+      typedef TRange trange_type; ///< Tiled range type
+      typedef Shape shape_type; ///< Shape type
+
+      /// Constructor
+
+      /// \param nprocs The number of processes in the world of the expression
+      explicit ExprPlan(const std::size_t nprocs) :
+        trange(), shape(), flops(0.0), memory(0ul), broadcast_bytes(0ul),
+        rank_memory(nprocs, 0ul)
+      { }
+
+      trange_type trange; ///< The tiled range of the result
+      shape_type shape; ///< The predicted shape of the result
+      double flops; ///< Floating point operations summed over all processes
+      std::size_t memory; ///< The largest tile memory of one process in bytes
+      std::size_t broadcast_bytes; ///< Bytes of tiles broadcast by contractions
+      std::vector<std::size_t> rank_memory; ///< The tile memory of each process in bytes
+
+      /// Add a tile to the plan
+
+      /// \param owner The process that holds the tile
+      /// \param bytes The size of the tile data in bytes
+      void add_tile(const std::size_t owner, const std::size_t bytes) {
+        rank_memory[owner] += bytes;
+        memory = std::max(memory, rank_memory[owner]);
+      }
+
+    }; // struct ExprPlan
+
+    /// Expression plan output operator
+
+    /// \tparam TRange The tiled range type
+    /// \tparam Shape The shape type
+    /// \param os The output stream
+    /// \param plan The expression plan
+    /// \return A reference to the output stream
+    template <typename TRange, typename Shape>
+    inline std::ostream&
+    operator<<(std::ostream& os, const ExprPlan<TRange, Shape>& plan) {
+      os << "{ flops=" << plan.flops << " memory=" << plan.memory
+         << " broadcast_bytes=" << plan.broadcast_bytes << " }";
+      return os;
+    }
+
+  }  // namespace expressions
+} // namespace TiledArray
+
+#endif // TILEDARRAY_EXPRESSIONS_EXPR_PLAN_H__INCLUDED
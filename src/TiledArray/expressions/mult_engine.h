@@ -315,6 +315,18 @@ namespace TiledArray {
           return BinaryEngine_::print(os, target_vars);
       }
 
+      /// Expression plan
+
+      /// \tparam Plan The expression plan type
+      /// \param result The expression plan
+      template <typename Plan>
+      void plan(Plan& result) const {
+        if(contract_)
+          ContEngine_::plan(result);
+        else
+          BinaryEngine_::plan(result);
+      }
+
     }; // class MultEngine
 
 
@@ -532,6 +544,18 @@ namespace TiledArray {
           return BinaryEngine_::print(os, target_vars);
       }
 
+      /// Expression plan
+
+      /// \tparam Plan The expression plan type
+      /// \param result The expression plan
+      template <typename Plan>
+      void plan(Plan& result) const {
+        if(contract_)
+          ContEngine_::plan(result);
+        else
+          BinaryEngine_::plan(result);
+      }
+
     }; // class ScalMultEngine
 
   }  // namespace expressions
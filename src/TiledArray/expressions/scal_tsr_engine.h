@@ -141,6 +141,13 @@ namespace TiledArray {
         return ss.str();
       }
 
+      /// Expression plan
+
+      /// \tparam Plan The expression plan type
+      /// \param result The expression plan
+      template <typename Plan>
+      void plan(Plan& result) const { ExprEngine_::plan_tiles(result, 1.0); }
+
     }; // class ScalTsrEngine
 
   }  // namespace expressions
@@ -186,6 +186,16 @@ namespace TiledArray {
         os.dec();
       }
 
+      /// Expression plan
+
+      /// \tparam Plan The expression plan type
+      /// \param result The expression plan
+      template <typename Plan>
+      void plan(Plan& result) const {
+        arg_.plan(result);
+        ExprEngine_::plan_tiles(result, 1.0);
+      }
+
     }; // class UnaryEngine
 
   }  // namespace expressions
@@ -0,0 +1,135 @@
+/*
+ *  This file is a part of TiledArray.
+ *  Copyright (C) 2016  Virginia Tech
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef TILEDARRAY_FIXED_RANK_H__INCLUDED
+#define TILEDARRAY_FIXED_RANK_H__INCLUDED
+
+#include <TiledArray/config.h>
+#include <TiledArray/error.h>
+#include <type_traits>
+
+namespace TiledArray {
+  namespace detail {
+
+    /// The largest rank with compile-time specialized index kernels
+    constexpr unsigned int max_fixed_rank = 4u;
+
+    /// Unrolled loop over the dimensions of a fixed-rank index
+
+    /// \tparam I The first dimension of the loop
+    /// \tparam N The rank
+    template <unsigned int I, unsigned int N>
+    struct RankLoop {
+      template <typename Op>
+      static TILEDARRAY_FORCE_INLINE void forward(Op& op) {
+        op(I);
+        RankLoop<I + 1u, N>::forward(op);
+      }
+
+      template <typename Op>
+      static TILEDARRAY_FORCE_INLINE void reverse(Op& op) {
+        RankLoop<I + 1u, N>::reverse(op);
+        op(I);
+      }
+    }; // struct RankLoop
+
+    template <unsigned int N>
+    struct RankLoop<N, N> {
+      template <typename Op>
+      static TILEDARRAY_FORCE_INLINE void forward(Op&) { }
+
+      template <typename Op>
+      static TILEDARRAY_FORCE_INLINE void reverse(Op&) { }
+    }; // struct RankLoop
+
+    /// Loop over the dimensions of an index, <tt>i = 0, ..., rank - 1</tt>
+
+    /// \tparam N The rank known at compile time, where \c N is \c 0 for a
+    /// rank that is only known at run time. The loop is fully unrolled when
+    /// \c N is greater than zero.
+    /// \tparam Op The loop body type, with signature <tt>void(unsigned int)</tt>
+    /// \param rank The rank, which must be equal to \c N when \c N is not zero
+    /// \param op The loop body
+    template <unsigned int N, typename Op>
+    TILEDARRAY_FORCE_INLINE typename std::enable_if<N != 0u>::type
+    rank_for(const unsigned int rank, Op&& op) {
+      TA_ASSERT(rank == N);
+      RankLoop<0u, N>::forward(op);
+    }
+
+    template <unsigned int N, typename Op>
+    TILEDARRAY_FORCE_INLINE typename std::enable_if<N == 0u>::type
+    rank_for(const unsigned int rank, Op&& op) {
+      for(unsigned int i = 0u; i < rank; ++i)
+        op(i);
+    }
+
+    /// Loop over the dimensions of an index, <tt>i = rank - 1, ..., 0</tt>
+
+    /// \tparam N The rank known at compile time, or \c 0
+    /// \tparam Op The loop body type, with signature <tt>void(unsigned int)</tt>
+    /// \param rank The rank, which must be equal to \c N when \c N is not zero
+    /// \param op The loop body
+    template <unsigned int N, typename Op>
+    TILEDARRAY_FORCE_INLINE typename std::enable_if<N != 0u>::type
+    rank_for_reverse(const unsigned int rank, Op&& op) {
+      TA_ASSERT(rank == N);
+      RankLoop<0u, N>::reverse(op);
+    }
+
+    template <unsigned int N, typename Op>
+    TILEDARRAY_FORCE_INLINE typename std::enable_if<N == 0u>::type
+    rank_for_reverse(const unsigned int rank, Op&& op) {
+      for(int i = int(rank) - 1; i >= 0; --i)
+        op(i);
+    }
+
+    /// Evaluate an index kernel specialized for the rank
+
+    /// Index arithmetic that loops over the dimensions of a range is
+    /// dominated by loop overhead for the low ranks used in practice. This
+    /// function selects the specialization of \c Kernel for \c rank , where
+    /// the loops are fully unrolled, and falls back to the run-time rank
+    /// specialization, <tt>Kernel<0></tt>, for ranks greater than
+    /// \c max_fixed_rank . Since the rank of a given array does not change,
+    /// the branch is well predicted.
+    /// \tparam Kernel The kernel class template, which has a static function
+    /// <tt>eval(rank, args...)</tt>
+    /// \tparam Args The kernel argument types
+    /// \param rank The rank
+    /// \param args The kernel arguments
+    /// \return The result of \c Kernel<rank>::eval(rank,args...)
+    template <template <unsigned int> class Kernel, typename... Args>
+    TILEDARRAY_FORCE_INLINE auto
+    fixed_rank_eval(const unsigned int rank, const Args&... args) ->
+        decltype(Kernel<0u>::eval(rank, args...))
+    {
+      switch(rank) {
+        case 1u: return Kernel<1u>::eval(rank, args...);
+        case 2u: return Kernel<2u>::eval(rank, args...);
+        case 3u: return Kernel<3u>::eval(rank, args...);
+        case 4u: return Kernel<4u>::eval(rank, args...);
+        default: return Kernel<0u>::eval(rank, args...);
+      }
+    }
+
+  }  // namespace detail
+} // namespace TiledArray
+
+#endif // TILEDARRAY_FIXED_RANK_H__INCLUDED
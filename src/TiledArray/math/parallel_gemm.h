@@ -27,143 +27,164 @@
 #define TILEDARRAY_PARALLEL_GEMM_H__INCLUDED
 
 #include <TiledArray/madness.h>
-#include <TiledArray/vector_op.h>
-#include <TiledArray/blas.h>
+#include <TiledArray/error.h>
+#include <TiledArray/math/blas.h>
+#include <algorithm>
 
-#define TILEDARRAY_DYNAMIC_BLOCK_SIZE std::numeric_limits<std::size_t>::max();
+#ifdef HAVE_INTEL_TBB
+#include <tbb/blocked_range2d.h>
+#include <tbb/parallel_for.h>
+#endif // HAVE_INTEL_TBB
 
 namespace TiledArray {
   namespace math {
 
-//#ifdef HAVE_INTEL_TBB
-
-
-    template <typename T, integer Size>
-    class MatrixBlockTask : public tbb::task {
-
-      const integer rows_;
-      const integer cols_;
-      T* data_;
-      const integer ld_;
-      std::shared_ptr<T> result_;
-
-      /// Copy a \c Size^2 block from \c data to \c result
-
-      /// \param[out] result A pointer to the first element of the result block
-      /// \param[in] data A pointer to the first element of the block to be copied
-      /// \param[in] ld The leading dimension stride for the \c data block
-      void copy_block(T* result, const T* data, const integer ld) {
-        const T* const block_end = result + (TILEDARRAY_LOOP_UNWIND * Size);
-        for(; result < block_end; result += Size, data += ld)
-          TiledArray::math::copy_block(result, data);
-      }
-
-      /// Copy a rectangular \c m*n block from \c data to \c result
-
-      /// \param[in] m The number of rows to copy
-      /// \param[in] n The number of columns to copy
-      /// \param[out] result A pointer to the first element of the result block
-      /// \param[in] data A pointer to the first element of the block to be copied
-      /// \param[in] ld The leading dimension stride for the \c data block
-      void copy_block(const integer m, const integer n, T* result,
-          const T* data, const integer ld)
-      {
-        const T* const block_end = result + (m * Size);
-        for(; result < block_end; result += Size, data += ld)
-          TiledArray::math::copy_block(n, result, data);
-      }
-
-    public:
-      MatrixBlockTask(const integer rows, const integer cols,
-          const T* const data, const integer ld) :
-        rows_(rows), cols_(cols), data_(data), ld_(ld)
-      { }
-
-      /// Task body
-      virtual tbb::task* execut() {
-
-        // Compute block iteration limit
-        constexpr integer index_mask = ~integer(TILEDARRAY_LOOP_UNWIND - 1ul);
-        const integer mx = rows_ & index_mask; // = rows - rows % TILEDARRAY_LOOP_UNWIND
-        const integer nx = cols_ & index_mask; // = cols - cols % TILEDARRAY_LOOP_UNWIND
-        const integer m_tail = rows_ - mx;
-        const integer n_tail = cols_ - nx;
-
-        // Copy data into block_
-        integer i = 0ul;
-        T* result_i = result_.get();
-        const T* data_i = data_;
-        for(; i < mx; i += TILEDARRAY_LOOP_UNWIND, result_i += Size, data_i += ld_) {
-
-          integer j = 0ul;
-          for(; j < nx; j += TILEDARRAY_LOOP_UNWIND)
-            copy_block(result_i + j, data_i + j);
-
-          if(n_tail)
-            copy_block(TILEDARRAY_LOOP_UNWIND, n_tail, result_i + j, data_i + j);
+    /// The minimum number of multiply-add operations in a *GEMM that is
+    /// partitioned into parallel tasks by \c parallel_gemm
+    constexpr std::size_t parallel_gemm_min_volume = 16777216ul; // 256^3
+
+    /// The default edge length of the result blocks that are computed by one
+    /// \c parallel_gemm task
+    constexpr integer parallel_gemm_block_size = 256;
+
+    namespace detail {
+
+      /// Compute a rectangular block of a *GEMM result
+
+      /// Each block of the result matrix is computed with a serial *GEMM call
+      /// over the full inner dimension, so blocks are independent and may be
+      /// evaluated concurrently. Arguments are not copied; the block pointers
+      /// are offsets into the original row-major matrices.
+      /// \tparam S1 The type of \c alpha
+      /// \tparam T1 The element type of \c a
+      /// \tparam T2 The element type of \c b
+      /// \tparam S2 The type of \c beta
+      /// \tparam T3 The element type of \c c
+      template <typename S1, typename T1, typename T2, typename S2, typename T3>
+      class GemmBlockOp {
+        const madness::cblas::CBLAS_TRANSPOSE op_a_; ///< Left-hand operation
+        const madness::cblas::CBLAS_TRANSPOSE op_b_; ///< Right-hand operation
+        const integer k_; ///< The inner dimension size
+        const S1 alpha_; ///< Scaling factor for a * b
+        const T1* const a_; ///< Left-hand matrix
+        const integer lda_; ///< Leading dimension of a
+        const T2* const b_; ///< Right-hand matrix
+        const integer ldb_; ///< Leading dimension of b
+        const S2 beta_; ///< Scaling factor for c
+        T3* const c_; ///< Result matrix
+        const integer ldc_; ///< Leading dimension of c
+
+      public:
+
+        GemmBlockOp(madness::cblas::CBLAS_TRANSPOSE op_a,
+            madness::cblas::CBLAS_TRANSPOSE op_b, const integer k,
+            const S1 alpha, const T1* const a, const integer lda,
+            const T2* const b, const integer ldb, const S2 beta, T3* const c,
+            const integer ldc) :
+          op_a_(op_a), op_b_(op_b), k_(k), alpha_(alpha), a_(a), lda_(lda),
+          b_(b), ldb_(ldb), beta_(beta), c_(c), ldc_(ldc)
+        { }
+
+        /// Compute result block <tt>[i_first, i_last) x [j_first, j_last)</tt>
+
+        /// \param i_first The first row of the block
+        /// \param i_last The end of the block rows
+        /// \param j_first The first column of the block
+        /// \param j_last The end of the block columns
+        void operator()(const integer i_first, const integer i_last,
+            const integer j_first, const integer j_last) const
+        {
+          const T1* const a = a_ +
+              (op_a_ == madness::cblas::NoTrans ? i_first * lda_ : i_first);
+          const T2* const b = b_ +
+              (op_b_ == madness::cblas::NoTrans ? j_first : j_first * ldb_);
+
+          gemm(op_a_, op_b_, i_last - i_first, j_last - j_first, k_, alpha_,
+              a, lda_, b, ldb_, beta_, c_ + (i_first * ldc_ + j_first), ldc_);
         }
 
-        if(m_tail) {
-
-          integer j = 0ul;
-          for(; j < nx; j += TILEDARRAY_LOOP_UNWIND)
-            copy_block(m_tail, TILEDARRAY_LOOP_UNWIND, result_i + j, data_i + j);
-
-          if(n_tail)
-            copy_block(m_tail, n_tail, result_i + j, data_i + j);
-
+#ifdef HAVE_INTEL_TBB
+        void operator()(const tbb::blocked_range2d<integer>& range) const {
+          operator()(range.rows().begin(), range.rows().end(),
+              range.cols().begin(), range.cols().end());
         }
-
-        return nullptr;
+#endif // HAVE_INTEL_TBB
+
+      }; // class GemmBlockOp
+
+    } // namespace detail
+
+
+    /// Blocked *GEMM
+
+    /// Compute <tt>c = alpha * op_a(a) * op_b(b) + beta * c</tt>, where the
+    /// result is partitioned into <tt>block_size x block_size</tt> blocks that
+    /// are computed by independent *GEMM calls. With Intel TBB the blocks are
+    /// evaluated in parallel, otherwise they are evaluated in order. All
+    /// matrices are row-major, as with \c gemm .
+    /// \param op_a The operation applied to \c a
+    /// \param op_b The operation applied to \c b
+    /// \param m The number of rows in the result
+    /// \param n The number of columns in the result
+    /// \param k The size of the inner dimension
+    /// \param alpha Scaling factor for <tt>op_a(a) * op_b(b)</tt>
+    /// \param a The left-hand matrix
+    /// \param lda The leading dimension of \c a
+    /// \param b The right-hand matrix
+    /// \param ldb The leading dimension of \c b
+    /// \param beta Scaling factor for \c c
+    /// \param c The result matrix
+    /// \param ldc The leading dimension of \c c
+    /// \param block_size The edge length of the result blocks
+    template <typename S1, typename T1, typename T2, typename S2, typename T3>
+    inline void blocked_gemm(madness::cblas::CBLAS_TRANSPOSE op_a,
+        madness::cblas::CBLAS_TRANSPOSE op_b, const integer m, const integer n,
+        const integer k, const S1 alpha, const T1* a, const integer lda,
+        const T2* b, const integer ldb, const S2 beta, T3* c, const integer ldc,
+        const integer block_size = parallel_gemm_block_size)
+    {
+      TA_ASSERT(block_size > 0);
+
+      const detail::GemmBlockOp<S1, T1, T2, S2, T3>
+          block_op(op_a, op_b, k, alpha, a, lda, b, ldb, beta, c, ldc);
+
+#ifdef HAVE_INTEL_TBB
+      tbb::parallel_for(tbb::blocked_range2d<integer>(0, m, block_size,
+          0, n, block_size), block_op, tbb::simple_partitioner());
+#else
+      for(integer i = 0; i < m; i += block_size) {
+        const integer i_last = std::min(i + block_size, m);
+        for(integer j = 0; j < n; j += block_size)
+          block_op(i, i_last, j, std::min(j + block_size, n));
       }
-
-      std::shared_ptr<T> result() {
-        constexpr integer size = Size * Size;
-        constexpr integer bytes = size * sizeof(T);
-
-        T* result_ptr = nullptr;
-        if(! posix_memalign(result_ptr, TILEARRAY_ALIGNMENT, bytes))
-          throw std::bad_alloc();
-
-        result_.reset(result_ptr);
-
-        return result_;
-      }
-
-    }; // class MatrixBlockTask
-
-
-    template <integer Size, typename C, typename A = C, typename B = C, typename Alpha = C, typename Beta = C>
-    class GemmTask : public tbb::task {
-      const madness::cblas::CBLAS_TRANSPOSE op_a_, op_b_;
-      const integer m_, n_, k_;
-      const Alpha alpha_;
-      std::shared_ptr<A> a_;
-      constexpr integer lda_ = Size;
-      std::shared_ptr<B> b_;
-      const Beta beta_;
-      std::shared_ptr<C> c_;
-      const integer ldc_;
-
-    public:
-
-
-      GemmTask(madness::cblas::CBLAS_TRANSPOSE op_a,
-          madness::cblas::CBLAS_TRANSPOSE op_b, const integer m, const integer n,
-          const integer k, const Alpha alpha, const std::shared_ptr<A>& a,
-          const std::shared_ptr<B>& b, const Beta beta,
-          const std::shared_ptr<C>& c, const integer ldc) :
-            op_a_(op_a), op_b_(op_b), m_(m), n_(n), k_(k), alpha_(alpha), a_(a),
-            b_(b), beta_(beta), c_(c), ldc_(c)
-      { }
-
-      virtual tbb::task execute() {
-        gemm(op_a_, op_b_, m_, n_, k_, alpha_, a_.get(), Size, b_.get(), Size, c_, ldc_);
+#endif // HAVE_INTEL_TBB
+    }
+
+
+    /// Intra-tile parallel *GEMM
+
+    /// Large products are computed with \c blocked_gemm , so that the work of
+    /// a single very large tile contraction is shared by the thread pool; this
+    /// matters when each process owns only a few large tiles. Small products,
+    /// or any product when Intel TBB is not available, are computed with a
+    /// single serial \c gemm call. The arguments are the same as \c gemm .
+    template <typename S1, typename T1, typename T2, typename S2, typename T3>
+    inline void parallel_gemm(madness::cblas::CBLAS_TRANSPOSE op_a,
+        madness::cblas::CBLAS_TRANSPOSE op_b, const integer m, const integer n,
+        const integer k, const S1 alpha, const T1* a, const integer lda,
+        const T2* b, const integer ldb, const S2 beta, T3* c, const integer ldc)
+    {
+#ifdef HAVE_INTEL_TBB
+      if(((m > parallel_gemm_block_size) || (n > parallel_gemm_block_size)) &&
+          ((std::size_t(m) * std::size_t(n) * std::size_t(k)) >= parallel_gemm_min_volume))
+      {
+        blocked_gemm(op_a, op_b, m, n, k, alpha, a, lda, b, ldb, beta, c, ldc);
+        return;
       }
+#endif // HAVE_INTEL_TBB
 
-    }; // class GemmTask
-
-//#endif // HAVE_INTEL_TBB
+      gemm(op_a, op_b, m, n, k, alpha, a, lda, b, ldb, beta, c, ldc);
+    }
 
   }  // namespace math
 } // namespace TiledArray
@@ -0,0 +1,149 @@
+/*
+ *  This file is a part of TiledArray.
+ *  Copyright (C) 2016  Virginia Tech
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef TILEDARRAY_MATH_STRIDED_GEMM_H__INCLUDED
+#define TILEDARRAY_MATH_STRIDED_GEMM_H__INCLUDED
+
+#include <TiledArray/config.h>
+#include <TiledArray/math/blas.h>
+#include <algorithm>
+#include <vector>
+
+namespace TiledArray {
+  namespace math {
+
+    /// The edge length of the argument panels packed by \c strided_gemm
+    constexpr integer strided_gemm_block_size = 256;
+
+    /// Compute the memory offsets of the elements in a fused dimension
+
+    /// The fused dimension is composed of \c rank dimensions, where the last
+    /// dimension is the fastest running index of the fused dimension. The
+    /// memory layout of the dimensions is arbitrary.
+    /// \tparam Index The extent and stride type
+    /// \param[in] rank The number of fused dimensions
+    /// \param[in] extent The extents of the fused dimensions
+    /// \param[in] stride The memory strides of the fused dimensions
+    /// \param[out] offset The memory offset of each element of the fused
+    /// dimension, in fused index order
+    template <typename Index>
+    inline void fused_offsets(const unsigned int rank, const Index* const extent,
+        const Index* const stride, std::vector<integer>& offset)
+    {
+      integer size = 1;
+      for(unsigned int d = 0u; d < rank; ++d)
+        size *= extent[d];
+      offset.resize(size);
+
+      // Expand the offsets one dimension at a time, from the slowest to the
+      // fastest running dimension.
+      offset[0] = 0;
+      integer n = 1;
+      for(unsigned int d = 0u; d < rank; ++d) {
+        const integer extent_d = extent[d];
+        const integer stride_d = stride[d];
+        for(integer i = n; i > 0; --i) {
+          const integer base = offset[i - 1];
+          integer* restrict const offset_i = offset.data() + (i - 1) * extent_d;
+          for(integer x = extent_d; x > 0; --x)
+            offset_i[x - 1] = base + (x - 1) * stride_d;
+        }
+        n *= extent_d;
+      }
+    }
+
+    /// Strided *GEMM
+
+    /// Compute <tt>c = alpha * a * b + beta * c</tt>, where the elements of
+    /// the \c m x \c k matrix \c a and the \c k x \c n matrix \c b are
+    /// addressed by row and column offset tables, i.e.
+    /// <tt>a(i,x) = a[a_row[i] + a_col[x]]</tt>. This allows the arguments to
+    /// have an arbitrary (e.g. permuted) tensor layout. Panels of \c a and \c b are packed into contiguous buffers and
+    /// multiplied with \c gemm , so a permuted copy of the arguments is never
+    /// formed; the additional memory is bounded by the panel sizes.
+    /// \param m The number of rows in \c a and \c c
+    /// \param n The number of columns in \c b and \c c
+    /// \param k The number of columns in \c a and rows in \c b
+    /// \param alpha The scaling factor for <tt>a * b</tt>
+    /// \param a The left-hand tensor data
+    /// \param a_row The offsets of the rows of \c a
+    /// \param a_col The offsets of the columns of \c a
+    /// \param b The right-hand tensor data
+    /// \param b_row The offsets of the rows of \c b
+    /// \param b_col The offsets of the columns of \c b
+    /// \param beta The scaling factor for \c c . When \c beta is zero, \c c
+    /// may be uninitialized on entry.
+    /// \param c The row-major result matrix
+    /// \param ldc The leading dimension of \c c
+    template <typename S, typename T1, typename T2, typename T3>
+    inline void strided_gemm(const integer m, const integer n, const integer k,
+        const S alpha, const T1* const a, const integer* const a_row,
+        const integer* const a_col, const T2* const b, const integer* const b_row,
+        const integer* const b_col, const T3 beta, T3* const c,
+        const integer ldc)
+    {
+      if(k == 0) {
+        // There is no product to add, so only scale c.
+        for(integer i = 0; i < m; ++i) {
+          T3* restrict const c_i = c + i * ldc;
+          for(integer j = 0; j < n; ++j)
+            c_i[j] = (beta == T3(0) ? T3(0) : c_i[j] * beta);
+        }
+        return;
+      }
+
+      const integer kc = std::min(k, strided_gemm_block_size);
+      const integer mc = std::min(m, strided_gemm_block_size);
+      std::vector<T1> a_panel(mc * kc);
+      std::vector<T2> b_panel(kc * n);
+
+      for(integer p = 0; p < k; p += kc) {
+        const integer kb = std::min(kc, k - p);
+
+        // Pack rows [p, p + kb) of b
+        for(integer x = 0; x < kb; ++x) {
+          const T2* restrict const b_x = b + b_row[p + x];
+          T2* restrict const panel_x = b_panel.data() + x * n;
+          for(integer j = 0; j < n; ++j)
+            panel_x[j] = b_x[b_col[j]];
+        }
+
+        for(integer i = 0; i < m; i += mc) {
+          const integer mb = std::min(mc, m - i);
+
+          // Pack block [i, i + mb) x [p, p + kb) of a
+          for(integer r = 0; r < mb; ++r) {
+            const T1* restrict const a_r = a + a_row[i + r];
+            T1* restrict const panel_r = a_panel.data() + r * kb;
+            for(integer x = 0; x < kb; ++x)
+              panel_r[x] = a_r[a_col[p + x]];
+          }
+
+          // Apply beta with the first panel and accumulate the others.
+          gemm(madness::cblas::NoTrans, madness::cblas::NoTrans, mb, n, kb,
+              alpha, a_panel.data(), kb, b_panel.data(), n,
+              (p == 0 ? beta : T3(1)), c + i * ldc, ldc);
+        }
+      }
+    }
+
+  }  // namespace math
+} // namespace TiledArray
+
+#endif // TILEDARRAY_MATH_STRIDED_GEMM_H__INCLUDED
@@ -0,0 +1,208 @@
+/*
+ *  This file is a part of TiledArray.
+ *  Copyright (C) 2016  Virginia Tech
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "transpose.h"
+#include "vector_simd.h"
+
+// The block kernels are compiled with the target attribute of their
+// instruction set, and each entry point is compiled for the same instruction
+// set with all calls inlined, so the kernels are inlined into the cache
+// blocking loops. The instruction set is selected at run time with the
+// vector kernels (see simd::isa()).
+#if (defined(__GNUC__) || defined(__clang__)) && defined(__x86_64__)
+#include <immintrin.h>
+#define TILEDARRAY_TRANSPOSE_X86 1
+#define TILEDARRAY_TRANSPOSE_TARGET(isa) __attribute__((target(isa)))
+#define TILEDARRAY_TRANSPOSE_ENTRY(isa) __attribute__((target(isa), flatten))
+#endif
+
+namespace TiledArray {
+  namespace math {
+    namespace {
+
+#ifdef TILEDARRAY_TRANSPOSE_X86
+
+      /// 8x8 \c double block transpose with AVX-512
+      struct TransposeKernelAvx512D {
+        static constexpr std::size_t size = 8ul;
+
+        TILEDARRAY_TRANSPOSE_TARGET("avx512f") static void
+        transpose(const double* restrict const arg, const std::size_t arg_stride,
+            double* restrict const result, const std::size_t result_stride)
+        {
+          // Interleave pairs of rows
+          const __m512d t0 = _mm512_unpacklo_pd(_mm512_loadu_pd(arg), _mm512_loadu_pd(arg + arg_stride));
+          const __m512d t1 = _mm512_unpackhi_pd(_mm512_loadu_pd(arg), _mm512_loadu_pd(arg + arg_stride));
+          const __m512d t2 = _mm512_unpacklo_pd(_mm512_loadu_pd(arg + 2ul * arg_stride), _mm512_loadu_pd(arg + 3ul * arg_stride));
+          const __m512d t3 = _mm512_unpackhi_pd(_mm512_loadu_pd(arg + 2ul * arg_stride), _mm512_loadu_pd(arg + 3ul * arg_stride));
+          const __m512d t4 = _mm512_unpacklo_pd(_mm512_loadu_pd(arg + 4ul * arg_stride), _mm512_loadu_pd(arg + 5ul * arg_stride));
+          const __m512d t5 = _mm512_unpackhi_pd(_mm512_loadu_pd(arg + 4ul * arg_stride), _mm512_loadu_pd(arg + 5ul * arg_stride));
+          const __m512d t6 = _mm512_unpacklo_pd(_mm512_loadu_pd(arg + 6ul * arg_stride), _mm512_loadu_pd(arg + 7ul * arg_stride));
+          const __m512d t7 = _mm512_unpackhi_pd(_mm512_loadu_pd(arg + 6ul * arg_stride), _mm512_loadu_pd(arg + 7ul * arg_stride));
+
+          // Gather the even and odd 128-bit lanes of four rows
+          const __m512d u0 = _mm512_shuffle_f64x2(t0, t2, 0x88);
+          const __m512d u1 = _mm512_shuffle_f64x2(t1, t3, 0x88);
+          const __m512d u2 = _mm512_shuffle_f64x2(t0, t2, 0xdd);
+          const __m512d u3 = _mm512_shuffle_f64x2(t1, t3, 0xdd);
+          const __m512d u4 = _mm512_shuffle_f64x2(t4, t6, 0x88);
+          const __m512d u5 = _mm512_shuffle_f64x2(t5, t7, 0x88);
+          const __m512d u6 = _mm512_shuffle_f64x2(t4, t6, 0xdd);
+          const __m512d u7 = _mm512_shuffle_f64x2(t5, t7, 0xdd);
+
+          // Combine the upper and lower rows
+          _mm512_storeu_pd(result,                      _mm512_shuffle_f64x2(u0, u4, 0x88));
+          _mm512_storeu_pd(result + result_stride,      _mm512_shuffle_f64x2(u1, u5, 0x88));
+          _mm512_storeu_pd(result + 2ul * result_stride, _mm512_shuffle_f64x2(u2, u6, 0x88));
+          _mm512_storeu_pd(result + 3ul * result_stride, _mm512_shuffle_f64x2(u3, u7, 0x88));
+          _mm512_storeu_pd(result + 4ul * result_stride, _mm512_shuffle_f64x2(u0, u4, 0xdd));
+          _mm512_storeu_pd(result + 5ul * result_stride, _mm512_shuffle_f64x2(u1, u5, 0xdd));
+          _mm512_storeu_pd(result + 6ul * result_stride, _mm512_shuffle_f64x2(u2, u6, 0xdd));
+          _mm512_storeu_pd(result + 7ul * result_stride, _mm512_shuffle_f64x2(u3, u7, 0xdd));
+        }
+      }; // struct TransposeKernelAvx512D
+
+      /// 4x4 \c double block transpose with AVX
+      struct TransposeKernelAvxD {
+        static constexpr std::size_t size = 4ul;
+
+        TILEDARRAY_TRANSPOSE_TARGET("avx") static void
+        transpose(const double* restrict const arg, const std::size_t arg_stride,
+            double* restrict const result, const std::size_t result_stride)
+        {
+          const __m256d r0 = _mm256_loadu_pd(arg);
+          const __m256d r1 = _mm256_loadu_pd(arg + arg_stride);
+          const __m256d r2 = _mm256_loadu_pd(arg + 2ul * arg_stride);
+          const __m256d r3 = _mm256_loadu_pd(arg + 3ul * arg_stride);
+
+          // Interleave pairs of rows
+          const __m256d t0 = _mm256_unpacklo_pd(r0, r1);
+          const __m256d t1 = _mm256_unpackhi_pd(r0, r1);
+          const __m256d t2 = _mm256_unpacklo_pd(r2, r3);
+          const __m256d t3 = _mm256_unpackhi_pd(r2, r3);
+
+          // Combine the 128-bit lanes
+          _mm256_storeu_pd(result,                      _mm256_permute2f128_pd(t0, t2, 0x20));
+          _mm256_storeu_pd(result + result_stride,      _mm256_permute2f128_pd(t1, t3, 0x20));
+          _mm256_storeu_pd(result + 2ul * result_stride, _mm256_permute2f128_pd(t0, t2, 0x31));
+          _mm256_storeu_pd(result + 3ul * result_stride, _mm256_permute2f128_pd(t1, t3, 0x31));
+        }
+      }; // struct TransposeKernelAvxD
+
+      /// 8x8 \c float block transpose with AVX
+      struct TransposeKernelAvxF {
+        static constexpr std::size_t size = 8ul;
+
+        TILEDARRAY_TRANSPOSE_TARGET("avx") static void
+        transpose(const float* restrict const arg, const std::size_t arg_stride,
+            float* restrict const result, const std::size_t result_stride)
+        {
+          // Interleave pairs of rows
+          const __m256 t0 = _mm256_unpacklo_ps(_mm256_loadu_ps(arg), _mm256_loadu_ps(arg + arg_stride));
+          const __m256 t1 = _mm256_unpackhi_ps(_mm256_loadu_ps(arg), _mm256_loadu_ps(arg + arg_stride));
+          const __m256 t2 = _mm256_unpacklo_ps(_mm256_loadu_ps(arg + 2ul * arg_stride), _mm256_loadu_ps(arg + 3ul * arg_stride));
+          const __m256 t3 = _mm256_unpackhi_ps(_mm256_loadu_ps(arg + 2ul * arg_stride), _mm256_loadu_ps(arg + 3ul * arg_stride));
+          const __m256 t4 = _mm256_unpacklo_ps(_mm256_loadu_ps(arg + 4ul * arg_stride), _mm256_loadu_ps(arg + 5ul * arg_stride));
+          const __m256 t5 = _mm256_unpackhi_ps(_mm256_loadu_ps(arg + 4ul * arg_stride), _mm256_loadu_ps(arg + 5ul * arg_stride));
+          const __m256 t6 = _mm256_unpacklo_ps(_mm256_loadu_ps(arg + 6ul * arg_stride), _mm256_loadu_ps(arg + 7ul * arg_stride));
+          const __m256 t7 = _mm256_unpackhi_ps(_mm256_loadu_ps(arg + 6ul * arg_stride), _mm256_loadu_ps(arg + 7ul * arg_stride));
+
+          // Interleave pairs of pairs
+          const __m256 u0 = _mm256_shuffle_ps(t0, t2, _MM_SHUFFLE(1, 0, 1, 0));
+          const __m256 u1 = _mm256_shuffle_ps(t0, t2, _MM_SHUFFLE(3, 2, 3, 2));
+          const __m256 u2 = _mm256_shuffle_ps(t1, t3, _MM_SHUFFLE(1, 0, 1, 0));
+          const __m256 u3 = _mm256_shuffle_ps(t1, t3, _MM_SHUFFLE(3, 2, 3, 2));
+          const __m256 u4 = _mm256_shuffle_ps(t4, t6, _MM_SHUFFLE(1, 0, 1, 0));
+          const __m256 u5 = _mm256_shuffle_ps(t4, t6, _MM_SHUFFLE(3, 2, 3, 2));
+          const __m256 u6 = _mm256_shuffle_ps(t5, t7, _MM_SHUFFLE(1, 0, 1, 0));
+          const __m256 u7 = _mm256_shuffle_ps(t5, t7, _MM_SHUFFLE(3, 2, 3, 2));
+
+          // Combine the 128-bit lanes
+          _mm256_storeu_ps(result,                      _mm256_permute2f128_ps(u0, u4, 0x20));
+          _mm256_storeu_ps(result + result_stride,      _mm256_permute2f128_ps(u1, u5, 0x20));
+          _mm256_storeu_ps(result + 2ul * result_stride, _mm256_permute2f128_ps(u2, u6, 0x20));
+          _mm256_storeu_ps(result + 3ul * result_stride, _mm256_permute2f128_ps(u3, u7, 0x20));
+          _mm256_storeu_ps(result + 4ul * result_stride, _mm256_permute2f128_ps(u0, u4, 0x31));
+          _mm256_storeu_ps(result + 5ul * result_stride, _mm256_permute2f128_ps(u1, u5, 0x31));
+          _mm256_storeu_ps(result + 6ul * result_stride, _mm256_permute2f128_ps(u2, u6, 0x31));
+          _mm256_storeu_ps(result + 7ul * result_stride, _mm256_permute2f128_ps(u3, u7, 0x31));
+        }
+      }; // struct TransposeKernelAvxF
+
+      template <typename T>
+      TILEDARRAY_TRANSPOSE_ENTRY("avx2") void
+      transpose_copy_avx2(const std::size_t m, const std::size_t n,
+          const std::size_t result_stride, T* const result,
+          const std::size_t arg_stride, const T* const arg)
+      {
+        typedef typename std::conditional<std::is_same<T, double>::value,
+            TransposeKernelAvxD, TransposeKernelAvxF>::type kernel_type;
+        detail::transpose_copy<kernel_type>(m, n, result_stride, result,
+            arg_stride, arg);
+      }
+
+      template <typename T>
+      TILEDARRAY_TRANSPOSE_ENTRY("avx512f") void
+      transpose_copy_avx512(const std::size_t m, const std::size_t n,
+          const std::size_t result_stride, T* const result,
+          const std::size_t arg_stride, const T* const arg)
+      {
+        typedef typename std::conditional<std::is_same<T, double>::value,
+            TransposeKernelAvx512D, TransposeKernelAvxF>::type kernel_type;
+        detail::transpose_copy<kernel_type>(m, n, result_stride, result,
+            arg_stride, arg);
+      }
+
+#endif // TILEDARRAY_TRANSPOSE_X86
+
+      /// Select the transpose kernel for the instruction set of the vector kernels
+      template <typename T>
+      void transpose_copy_dispatch(const std::size_t m, const std::size_t n,
+          const std::size_t result_stride, T* const result,
+          const std::size_t arg_stride, const T* const arg)
+      {
+        switch(simd::isa()) {
+#ifdef TILEDARRAY_TRANSPOSE_X86
+          case simd::Isa::avx512:
+            transpose_copy_avx512(m, n, result_stride, result, arg_stride, arg);
+            break;
+          case simd::Isa::avx2:
+            transpose_copy_avx2(m, n, result_stride, result, arg_stride, arg);
+            break;
+#endif // TILEDARRAY_TRANSPOSE_X86
+          default:
+            detail::transpose_copy<TransposeKernel<T> >(m, n, result_stride,
+                result, arg_stride, arg);
+        }
+      }
+
+    }  // namespace
+
+    void transpose_copy(const std::size_t m, const std::size_t n,
+        const std::size_t result_stride, double* const result,
+        const std::size_t arg_stride, const double* const arg)
+    { transpose_copy_dispatch(m, n, result_stride, result, arg_stride, arg); }
+
+    void transpose_copy(const std::size_t m, const std::size_t n,
+        const std::size_t result_stride, float* const result,
+        const std::size_t arg_stride, const float* const arg)
+    { transpose_copy_dispatch(m, n, result_stride, result, arg_stride, arg); }
+
+  }  // namespace math
+} // namespace TiledArray
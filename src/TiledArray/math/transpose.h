@@ -28,6 +28,7 @@
 
 #include <TiledArray/error.h>
 #include <TiledArray/math/vector_op.h>
+#include <algorithm>
 
 namespace TiledArray {
   namespace math {
@@ -222,6 +223,158 @@ namespace TiledArray {
       }
     }
 
+    /// The edge length of the level 1 cache blocks used by \c transpose_copy
+    constexpr std::size_t transpose_l1_block_size = 32ul;
+
+    /// The edge length of the level 2 cache blocks used by \c transpose_copy
+    constexpr std::size_t transpose_l2_block_size = 256ul;
+
+    /// Square block transpose
+
+    /// The generic kernel transposes a \c size x \c size block element by
+    /// element. The \c float and \c double overloads of \c transpose_copy
+    /// use kernels that transpose the block in SIMD registers instead.
+    /// \tparam T The element type
+    template <typename T>
+    struct TransposeKernel {
+      static constexpr std::size_t size = TILEDARRAY_LOOP_UNWIND;
+
+      /// Transpose a square block
+
+      /// \param[in] arg A pointer to the first element of the argument block
+      /// \param[in] arg_stride The stride between argument rows
+      /// \param[out] result A pointer to the first element of the result block
+      /// \param[in] result_stride The stride between result rows
+      static TILEDARRAY_FORCE_INLINE void
+      transpose(const T* restrict const arg, const std::size_t arg_stride,
+          T* restrict const result, const std::size_t result_stride)
+      {
+        for(std::size_t i = 0ul; i < size; ++i) {
+          const T* restrict const arg_i = arg + i * arg_stride;
+          for(std::size_t j = 0ul; j < size; ++j)
+            result[j * result_stride + i] = arg_i[j];
+        }
+      }
+    }; // struct TransposeKernel
+
+    namespace detail {
+
+      /// Transpose a level 1 cache block
+
+      /// \tparam Kernel The square block transpose kernel type
+      /// \tparam T The element type
+      /// \param[in] m The number of rows in the argument block
+      /// \param[in] n The number of columns in the argument block
+      /// \param[in] result_stride The stride between result rows
+      /// \param[out] result A pointer to the first element of the result block
+      /// \param[in] arg_stride The stride between argument rows
+      /// \param[in] arg A pointer to the first element of the argument block
+      template <typename Kernel, typename T>
+      inline void transpose_copy_block(const std::size_t m, const std::size_t n,
+          const std::size_t result_stride, T* restrict const result,
+          const std::size_t arg_stride, const T* restrict const arg)
+      {
+        constexpr std::size_t size = Kernel::size;
+
+        std::size_t i = 0ul;
+        for(; (i + size) <= m; i += size) {
+          const T* restrict const arg_i = arg + i * arg_stride;
+          T* restrict const result_i = result + i;
+
+          std::size_t j = 0ul;
+          for(; (j + size) <= n; j += size)
+            Kernel::transpose(arg_i + j, arg_stride,
+                result_i + j * result_stride, result_stride);
+
+          // Column tail
+          for(; j < n; ++j) {
+            T* restrict const result_ij = result_i + j * result_stride;
+            for(std::size_t x = 0ul; x < size; ++x)
+              result_ij[x] = arg_i[x * arg_stride + j];
+          }
+        }
+
+        // Row tail
+        for(; i < m; ++i) {
+          const T* restrict const arg_i = arg + i * arg_stride;
+          for(std::size_t j = 0ul; j < n; ++j)
+            result[j * result_stride + i] = arg_i[j];
+        }
+      }
+
+      /// Cache blocked matrix transpose copy with a square block kernel
+
+      /// \tparam Kernel The square block transpose kernel type
+      /// \tparam T The element type
+      /// \param[in] m The number of rows in the argument matrix
+      /// \param[in] n The number of columns in the argument matrix
+      /// \param[in] result_stride The stride between result rows
+      /// \param[out] result A pointer to the first element of the result matrix
+      /// \param[in] arg_stride The stride between argument rows
+      /// \param[in] arg A pointer to the first element of the argument matrix
+      template <typename Kernel, typename T>
+      inline void transpose_copy(const std::size_t m, const std::size_t n,
+          const std::size_t result_stride, T* const result,
+          const std::size_t arg_stride, const T* const arg)
+      {
+        for(std::size_t i2 = 0ul; i2 < m; i2 += transpose_l2_block_size) {
+          const std::size_t m2 = std::min(transpose_l2_block_size, m - i2);
+          for(std::size_t j2 = 0ul; j2 < n; j2 += transpose_l2_block_size) {
+            const std::size_t n2 = std::min(transpose_l2_block_size, n - j2);
+
+            for(std::size_t i1 = i2; i1 < (i2 + m2); i1 += transpose_l1_block_size) {
+              const std::size_t m1 = std::min(transpose_l1_block_size, i2 + m2 - i1);
+              for(std::size_t j1 = j2; j1 < (j2 + n2); j1 += transpose_l1_block_size) {
+                const std::size_t n1 = std::min(transpose_l1_block_size, j2 + n2 - j1);
+                transpose_copy_block<Kernel>(m1, n1, result_stride,
+                    result + (j1 * result_stride + i1), arg_stride,
+                    arg + (i1 * arg_stride + j1));
+              }
+            }
+          }
+        }
+      }
+
+    }  // namespace detail
+
+    /// Cache blocked matrix transpose copy
+
+    /// This function copies the transpose of a row-major argument matrix into
+    /// the result matrix, i.e. <tt>result[j * result_stride + i] =
+    /// arg[i * arg_stride + j]</tt>. It is equivalent to \c transpose with
+    /// identity input and output operations, but the matrix is partitioned
+    /// into level 2 and level 1 cache blocks, which are transposed with
+    /// square block kernels.
+    /// \tparam T The element type, which must be trivially copyable
+    /// \param[in] m The number of rows in the argument matrix
+    /// \param[in] n The number of columns in the argument matrix
+    /// \param[in] result_stride The stride between result rows
+    /// \param[out] result A pointer to the first element of the result matrix
+    /// \param[in] arg_stride The stride between argument rows
+    /// \param[in] arg A pointer to the first element of the argument matrix
+    template <typename T>
+    void transpose_copy(const std::size_t m, const std::size_t n,
+        const std::size_t result_stride, T* const result,
+        const std::size_t arg_stride, const T* const arg)
+    {
+      static_assert(std::is_trivially_copyable<T>::value,
+          "transpose_copy requires a trivially copyable element type");
+
+      detail::transpose_copy<TransposeKernel<T> >(m, n, result_stride, result,
+          arg_stride, arg);
+    }
+
+    // In-register (SIMD) implementations. The block kernels are compiled for
+    // AVX2 and AVX-512 on x86-64 and are selected with the instruction set of
+    // the vector kernels, see \c simd::isa() .
+
+    void transpose_copy(const std::size_t m, const std::size_t n,
+        const std::size_t result_stride, double* const result,
+        const std::size_t arg_stride, const double* const arg);
+    void transpose_copy(const std::size_t m, const std::size_t n,
+        const std::size_t result_stride, float* const result,
+        const std::size_t arg_stride, const float* const arg);
+
   }  // namespace math
 } // namespace TiledArray
 
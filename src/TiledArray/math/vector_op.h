@@ -43,6 +43,10 @@ namespace TiledArray {
     typedef std::integral_constant<std::size_t, TILEDARRAY_CACHELINE_SIZE / sizeof(double)> LoopUnwind;
     typedef std::integral_constant<std::size_t, ~std::size_t(TILEDARRAY_LOOP_UNWIND - 1ul)> index_mask;
 
+    /// The minimum number of elements in a vector reduction that is
+    /// partitioned into parallel tasks
+    constexpr std::size_t reduce_op_min_volume = 32768ul;
+
     template <std::size_t> struct VectorOpUnwind;
 
     /// Vector loop unwind helper class
@@ -647,13 +651,28 @@ namespace TiledArray {
     };
 #endif
 
+    /// Vector reduction
+
+    /// Reductions of at least \c reduce_op_min_volume elements are
+    /// partitioned into parallel tasks with Intel TBB; the partial results
+    /// are combined with \c join_op . Smaller reductions, or any reduction
+    /// when TBB is not available, are evaluated serially.
+    /// \tparam ReduceOp The element-wise reduction operation type
+    /// \tparam JoinOp The partial result join operation type
+    /// \tparam Result The result type
+    /// \tparam Args The argument element types
+    /// \param reduce_op The element-wise reduction operation
+    /// \param join_op The partial result join operation
+    /// \param identity The initial value of the partial results
+    /// \param n The number of elements in the vectors
+    /// \param[in,out] result The reduction result
+    /// \param args The argument vectors
     template <typename ReduceOp, typename JoinOp, typename Result, typename... Args>
     void reduce_op(ReduceOp&& reduce_op, JoinOp&& join_op, const Result& identity, const std::size_t n, Result& result,
                    const Args* const... args)
     {
-      //TODO implement reduce operation with TBB
       #ifdef HAVE_INTEL_TBB
-//      std::cout << "TBB_Reduce_OP" << std::endl;
+      if(n >= reduce_op_min_volume) {
         SizeTRange range(0, n);
 
         auto apply_reduce_op = ApplyReduceOp<ReduceOp,JoinOp,Result,Args...>(reduce_op, join_op, identity, result, args...);
@@ -661,9 +680,10 @@ namespace TiledArray {
         tbb::parallel_reduce(range,apply_reduce_op, tbb::auto_partitioner());
 
         result = apply_reduce_op.result();
-      #else
-        reduce_op_serial(reduce_op,n,result,args...);
+        return;
+      }
       #endif
+      reduce_op_serial(reduce_op,n,result,args...);
     }
 
     template <typename Arg, typename Result>
@@ -0,0 +1,450 @@
+/*
+ *  This file is a part of TiledArray.
+ *  Copyright (C) 2016  Virginia Tech
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "vector_simd.h"
+#include <TiledArray/madness.h>
+#include <TiledArray/config.h>
+#include <atomic>
+#include <cstring>
+
+#ifdef HAVE_INTEL_TBB
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+#include <tbb/parallel_reduce.h>
+#endif // HAVE_INTEL_TBB
+
+// The kernels are written with the GCC vector extensions, which are also
+// supported by Clang and the Intel compiler. Each instruction set has an entry
+// point compiled with the matching target attribute; the generic kernels are
+// inlined into the entry points and compiled for that target.
+#if (defined(__GNUC__) || defined(__clang__)) && defined(__x86_64__)
+#define TILEDARRAY_SIMD_X86 1
+#define TILEDARRAY_SIMD_TARGET(isa) __attribute__((target(isa)))
+#if defined(__GNUC__) && ! defined(__clang__)
+// The vector helpers are always inlined into the instruction set entry
+// points, so the ABI of wide vector arguments is irrelevant.
+#pragma GCC diagnostic ignored "-Wpsabi"
+#endif
+#endif
+
+namespace TiledArray {
+  namespace math {
+    namespace simd {
+      namespace {
+
+        /// The minimum number of elements in one parallel task
+        constexpr std::size_t grain_size = 16384ul;
+
+#ifdef TILEDARRAY_SIMD_X86
+
+        /// Vector register types
+        template <typename T, std::size_t Bytes> struct VectorType;
+
+        template <> struct VectorType<double, 16ul> { typedef double type __attribute__((vector_size(16))); };
+        template <> struct VectorType<double, 32ul> { typedef double type __attribute__((vector_size(32))); };
+        template <> struct VectorType<double, 64ul> { typedef double type __attribute__((vector_size(64))); };
+        template <> struct VectorType<float, 16ul> { typedef float type __attribute__((vector_size(16))); };
+        template <> struct VectorType<float, 32ul> { typedef float type __attribute__((vector_size(32))); };
+        template <> struct VectorType<float, 64ul> { typedef float type __attribute__((vector_size(64))); };
+
+        template <typename V, typename T>
+        TILEDARRAY_FORCE_INLINE V load(const T* const p) {
+          V v;
+          std::memcpy(&v, p, sizeof(V));
+          return v;
+        }
+
+        template <typename V, typename T>
+        TILEDARRAY_FORCE_INLINE void store(T* const p, const V& v) {
+          std::memcpy(p, &v, sizeof(V));
+        }
+
+        template <typename V>
+        TILEDARRAY_FORCE_INLINE V vmax(const V a, const V b) {
+          typedef decltype(a > b) mask_type;
+          const mask_type m = a > b;
+          return V((m & mask_type(a)) | (~m & mask_type(b)));
+        }
+
+#endif // TILEDARRAY_SIMD_X86
+
+        TILEDARRAY_FORCE_INLINE double vmax(const double a, const double b) { return std::max(a, b); }
+        TILEDARRAY_FORCE_INLINE float vmax(const float a, const float b) { return std::max(a, b); }
+
+        // Element-wise operations. They are applied to both vector registers
+        // and scalars.
+
+        template <typename T>
+        struct ScaleOp {
+          const T factor;
+          template <typename V>
+          TILEDARRAY_FORCE_INLINE void operator()(V& result) const { result *= factor; }
+        };
+
+        struct AddOp {
+          template <typename V>
+          TILEDARRAY_FORCE_INLINE void operator()(V& result, const V arg) const { result += arg; }
+        };
+
+        template <typename T>
+        struct ScalAddOp {
+          const T factor;
+          template <typename V>
+          TILEDARRAY_FORCE_INLINE void operator()(V& result, const V arg) const
+          { result = (result + arg) * factor; }
+        };
+
+        struct SubtOp {
+          template <typename V>
+          TILEDARRAY_FORCE_INLINE void operator()(V& result, const V arg) const { result -= arg; }
+        };
+
+        template <typename T>
+        struct ScalSubtOp {
+          const T factor;
+          template <typename V>
+          TILEDARRAY_FORCE_INLINE void operator()(V& result, const V arg) const
+          { result = (result - arg) * factor; }
+        };
+
+        struct MultOp {
+          template <typename V>
+          TILEDARRAY_FORCE_INLINE void operator()(V& result, const V arg) const { result *= arg; }
+        };
+
+        template <typename T>
+        struct ScalMultOp {
+          const T factor;
+          template <typename V>
+          TILEDARRAY_FORCE_INLINE void operator()(V& result, const V arg) const
+          { result = (result * arg) * factor; }
+        };
+
+        // Reduction operations. The identity is the initial value of each
+        // accumulator, and join combines two accumulators.
+
+        struct SquaredNormOp {
+          static constexpr int identity = 0;
+          template <typename V>
+          TILEDARRAY_FORCE_INLINE void operator()(V& result, const V arg) const { result += arg * arg; }
+          template <typename V>
+          TILEDARRAY_FORCE_INLINE void join(V& result, const V arg) const { result += arg; }
+        };
+
+        struct DotOp {
+          static constexpr int identity = 0;
+          template <typename V>
+          TILEDARRAY_FORCE_INLINE void operator()(V& result, const V left, const V right) const
+          { result += left * right; }
+          template <typename V>
+          TILEDARRAY_FORCE_INLINE void join(V& result, const V arg) const { result += arg; }
+        };
+
+        struct AbsMaxOp {
+          static constexpr int identity = 0;
+          template <typename V>
+          TILEDARRAY_FORCE_INLINE void operator()(V& result, const V arg) const
+          { result = vmax(result, vmax(arg, -arg)); }
+          template <typename V>
+          TILEDARRAY_FORCE_INLINE void join(V& result, const V arg) const { result = vmax(result, arg); }
+        };
+
+#ifdef TILEDARRAY_SIMD_X86
+
+        /// Apply an element-wise operation with vector registers of type \c V
+        template <typename V, typename Op, typename T, typename... Args>
+        TILEDARRAY_FORCE_INLINE void
+        for_each_kernel(const Op& op, const std::size_t n, T* const result,
+            const Args* const... args)
+        {
+          constexpr std::size_t width = sizeof(V) / sizeof(T);
+
+          std::size_t i = 0ul;
+          for(; (i + width) <= n; i += width) {
+            V result_i = load<V>(result + i);
+            op(result_i, load<V>(args + i)...);
+            store(result + i, result_i);
+          }
+          for(; i < n; ++i)
+            op(result[i], args[i]...);
+        }
+
+        /// Reduce vectors with vector registers of type \c V
+
+        /// Four independent accumulators are used to hide the latency of the
+        /// vector operations.
+        template <typename V, typename Op, typename T, typename... Args>
+        TILEDARRAY_FORCE_INLINE T
+        reduce_kernel(const Op& op, const std::size_t n, const T* const arg,
+            const Args* const... args)
+        {
+          constexpr std::size_t width = sizeof(V) / sizeof(T);
+
+          V acc0 = V{} + T(Op::identity);
+          V acc1 = acc0, acc2 = acc0, acc3 = acc0;
+
+          std::size_t i = 0ul;
+          for(; (i + 4ul * width) <= n; i += 4ul * width) {
+            op(acc0, load<V>(arg + i), load<V>(args + i)...);
+            op(acc1, load<V>(arg + i + width), load<V>(args + i + width)...);
+            op(acc2, load<V>(arg + i + 2ul * width), load<V>(args + i + 2ul * width)...);
+            op(acc3, load<V>(arg + i + 3ul * width), load<V>(args + i + 3ul * width)...);
+          }
+          for(; (i + width) <= n; i += width)
+            op(acc0, load<V>(arg + i), load<V>(args + i)...);
+
+          op.join(acc0, acc1);
+          op.join(acc2, acc3);
+          op.join(acc0, acc2);
+
+          T result = acc0[0];
+          for(std::size_t x = 1ul; x < width; ++x)
+            op.join(result, T(acc0[x]));
+          for(; i < n; ++i)
+            op(result, arg[i], args[i]...);
+
+          return result;
+        }
+
+        // Instruction set entry points
+
+        template <typename Op, typename T, typename... Args>
+        TILEDARRAY_SIMD_TARGET("sse2") void
+        for_each_sse2(const Op& op, const std::size_t n, T* const result,
+            const Args* const... args)
+        { for_each_kernel<typename VectorType<T, 16ul>::type>(op, n, result, args...); }
+
+        template <typename Op, typename T, typename... Args>
+        TILEDARRAY_SIMD_TARGET("avx2,fma") void
+        for_each_avx2(const Op& op, const std::size_t n, T* const result,
+            const Args* const... args)
+        { for_each_kernel<typename VectorType<T, 32ul>::type>(op, n, result, args...); }
+
+        template <typename Op, typename T, typename... Args>
+        TILEDARRAY_SIMD_TARGET("avx512f") void
+        for_each_avx512(const Op& op, const std::size_t n, T* const result,
+            const Args* const... args)
+        { for_each_kernel<typename VectorType<T, 64ul>::type>(op, n, result, args...); }
+
+        template <typename Op, typename T, typename... Args>
+        TILEDARRAY_SIMD_TARGET("sse2") T
+        reduce_sse2(const Op& op, const std::size_t n, const T* const arg,
+            const Args* const... args)
+        { return reduce_kernel<typename VectorType<T, 16ul>::type>(op, n, arg, args...); }
+
+        template <typename Op, typename T, typename... Args>
+        TILEDARRAY_SIMD_TARGET("avx2,fma") T
+        reduce_avx2(const Op& op, const std::size_t n, const T* const arg,
+            const Args* const... args)
+        { return reduce_kernel<typename VectorType<T, 32ul>::type>(op, n, arg, args...); }
+
+        template <typename Op, typename T, typename... Args>
+        TILEDARRAY_SIMD_TARGET("avx512f") T
+        reduce_avx512(const Op& op, const std::size_t n, const T* const arg,
+            const Args* const... args)
+        { return reduce_kernel<typename VectorType<T, 64ul>::type>(op, n, arg, args...); }
+
+        /// The fastest instruction set supported by the host CPU
+        Isa host_isa() {
+          __builtin_cpu_init();
+          if(__builtin_cpu_supports("avx512f"))
+            return Isa::avx512;
+          if(__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma"))
+            return Isa::avx2;
+          if(__builtin_cpu_supports("sse2"))
+            return Isa::sse2;
+          return Isa::generic;
+        }
+
+#else
+
+        Isa host_isa() { return Isa::generic; }
+
+#endif // TILEDARRAY_SIMD_X86
+
+        /// The instruction set of the vector kernels
+        std::atomic<Isa>& current_isa() {
+          static std::atomic<Isa> isa(host_isa());
+          return isa;
+        }
+
+        /// Apply an element-wise operation to a vector range
+        template <typename Op, typename T, typename... Args>
+        void for_each_serial(const Op& op, const std::size_t n, T* const result,
+            const Args* const... args)
+        {
+          switch(current_isa().load(std::memory_order_relaxed)) {
+#ifdef TILEDARRAY_SIMD_X86
+            case Isa::avx512:
+              for_each_avx512(op, n, result, args...);
+              break;
+            case Isa::avx2:
+              for_each_avx2(op, n, result, args...);
+              break;
+            case Isa::sse2:
+              for_each_sse2(op, n, result, args...);
+              break;
+#endif // TILEDARRAY_SIMD_X86
+            default:
+              for(std::size_t i = 0ul; i < n; ++i)
+                op(result[i], args[i]...);
+          }
+        }
+
+        /// Reduce a vector range
+        template <typename Op, typename T, typename... Args>
+        T reduce_serial(const Op& op, const std::size_t n, const T* const arg,
+            const Args* const... args)
+        {
+          switch(current_isa().load(std::memory_order_relaxed)) {
+#ifdef TILEDARRAY_SIMD_X86
+            case Isa::avx512:
+              return reduce_avx512(op, n, arg, args...);
+            case Isa::avx2:
+              return reduce_avx2(op, n, arg, args...);
+            case Isa::sse2:
+              return reduce_sse2(op, n, arg, args...);
+#endif // TILEDARRAY_SIMD_X86
+            default:
+              {
+                T result = T(Op::identity);
+                for(std::size_t i = 0ul; i < n; ++i)
+                  op(result, arg[i], args[i]...);
+                return result;
+              }
+          }
+        }
+
+        /// Apply an element-wise operation, in parallel with Intel TBB
+        template <typename Op, typename T, typename... Args>
+        void for_each(const Op& op, const std::size_t n, T* const result,
+            const Args* const... args)
+        {
+#ifdef HAVE_INTEL_TBB
+          if(n > grain_size) {
+            tbb::parallel_for(tbb::blocked_range<std::size_t>(0ul, n, grain_size),
+                [&] (const tbb::blocked_range<std::size_t>& range) {
+                  for_each_serial(op, range.size(), result + range.begin(),
+                      (args + range.begin())...);
+                });
+            return;
+          }
+#endif // HAVE_INTEL_TBB
+          for_each_serial(op, n, result, args...);
+        }
+
+        /// Reduce a vector, in parallel with Intel TBB
+        template <typename Op, typename T, typename... Args>
+        T reduce(const Op& op, const std::size_t n, const T* const arg,
+            const Args* const... args)
+        {
+#ifdef HAVE_INTEL_TBB
+          if(n > grain_size) {
+            return tbb::parallel_reduce(
+                tbb::blocked_range<std::size_t>(0ul, n, grain_size), T(Op::identity),
+                [&] (const tbb::blocked_range<std::size_t>& range, T result) -> T {
+                  op.join(result, reduce_serial(op, range.size(),
+                      arg + range.begin(), (args + range.begin())...));
+                  return result;
+                },
+                [&] (T left, const T right) -> T {
+                  op.join(left, right);
+                  return left;
+                });
+          }
+#endif // HAVE_INTEL_TBB
+          return reduce_serial(op, n, arg, args...);
+        }
+
+      }  // namespace
+
+      Isa isa() { return current_isa().load(); }
+
+      Isa set_isa(const Isa i) {
+        const Isa host = host_isa();
+        const Isa result = (static_cast<int>(i) <= static_cast<int>(host) ? i : host);
+        current_isa().store(result);
+        return result;
+      }
+
+      const char* isa_name(const Isa i) {
+        switch(i) {
+          case Isa::sse2:   return "SSE2";
+          case Isa::avx2:   return "AVX2";
+          case Isa::avx512: return "AVX-512";
+          default:          return "generic";
+        }
+      }
+
+      void scale_to(const std::size_t n, const double factor, double* const result)
+      { for_each(ScaleOp<double>{factor}, n, result); }
+      void scale_to(const std::size_t n, const float factor, float* const result)
+      { for_each(ScaleOp<float>{factor}, n, result); }
+
+      void add_to(const std::size_t n, double* const result, const double* const arg)
+      { for_each(AddOp(), n, result, arg); }
+      void add_to(const std::size_t n, float* const result, const float* const arg)
+      { for_each(AddOp(), n, result, arg); }
+      void add_to(const std::size_t n, double* const result, const double* const arg,
+          const double factor)
+      { for_each(ScalAddOp<double>{factor}, n, result, arg); }
+      void add_to(const std::size_t n, float* const result, const float* const arg,
+          const float factor)
+      { for_each(ScalAddOp<float>{factor}, n, result, arg); }
+
+      void subt_to(const std::size_t n, double* const result, const double* const arg)
+      { for_each(SubtOp(), n, result, arg); }
+      void subt_to(const std::size_t n, float* const result, const float* const arg)
+      { for_each(SubtOp(), n, result, arg); }
+      void subt_to(const std::size_t n, double* const result, const double* const arg,
+          const double factor)
+      { for_each(ScalSubtOp<double>{factor}, n, result, arg); }
+      void subt_to(const std::size_t n, float* const result, const float* const arg,
+          const float factor)
+      { for_each(ScalSubtOp<float>{factor}, n, result, arg); }
+
+      void mult_to(const std::size_t n, double* const result, const double* const arg)
+      { for_each(MultOp(), n, result, arg); }
+      void mult_to(const std::size_t n, float* const result, const float* const arg)
+      { for_each(MultOp(), n, result, arg); }
+      void mult_to(const std::size_t n, double* const result, const double* const arg,
+          const double factor)
+      { for_each(ScalMultOp<double>{factor}, n, result, arg); }
+      void mult_to(const std::size_t n, float* const result, const float* const arg,
+          const float factor)
+      { for_each(ScalMultOp<float>{factor}, n, result, arg); }
+
+      double squared_norm(const std::size_t n, const double* const arg)
+      { return reduce(SquaredNormOp(), n, arg); }
+      float squared_norm(const std::size_t n, const float* const arg)
+      { return reduce(SquaredNormOp(), n, arg); }
+
+      double dot(const std::size_t n, const double* const left, const double* const right)
+      { return reduce(DotOp(), n, left, right); }
+      float dot(const std::size_t n, const float* const left, const float* const right)
+      { return reduce(DotOp(), n, left, right); }
+
+      double abs_max(const std::size_t n, const double* const arg)
+      { return reduce(AbsMaxOp(), n, arg); }
+      float abs_max(const std::size_t n, const float* const arg)
+      { return reduce(AbsMaxOp(), n, arg); }
+
+    }  // namespace simd
+  }  // namespace math
+} // namespace TiledArray
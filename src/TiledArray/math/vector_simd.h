@@ -0,0 +1,186 @@
+/*
+ *  This file is a part of TiledArray.
+ *  Copyright (C) 2016  Virginia Tech
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef TILEDARRAY_MATH_VECTOR_SIMD_H__INCLUDED
+#define TILEDARRAY_MATH_VECTOR_SIMD_H__INCLUDED
+
+#include <cstddef>
+#include <cmath>
+#include <algorithm>
+#include <type_traits>
+
+namespace TiledArray {
+  namespace math {
+
+    /// Test for element types with explicitly vectorized kernels
+    template <typename T>
+    struct is_simd_type :
+        public std::integral_constant<bool, std::is_same<T, double>::value
+                                         || std::is_same<T, float>::value>
+    { };
+
+    /// Explicitly vectorized vector kernels
+
+    /// The \c float and \c double overloads are compiled for several
+    /// instruction sets (SSE2, AVX2, and AVX-512 on x86-64), and the fastest
+    /// instruction set supported by the host CPU is selected at run time, so
+    /// a single binary uses the full vector width of any node. The function
+    /// templates are generic, element-wise implementations for all other
+    /// types.
+    namespace simd {
+
+      /// Instruction sets of the vector kernels
+      enum class Isa { generic, sse2, avx2, avx512 };
+
+      /// The instruction set used by the vector kernels
+
+      /// \return The instruction set that was selected for the host CPU
+      Isa isa();
+
+      /// Override the instruction set used by the vector kernels
+
+      /// \param i The instruction set to be used. If \c i is not supported by
+      /// the host CPU, the fastest supported instruction set is used.
+      /// \return The instruction set that is used
+      Isa set_isa(const Isa i);
+
+      /// The name of an instruction set
+
+      /// \param i An instruction set
+      /// \return The name of \c i
+      const char* isa_name(const Isa i);
+
+      // Generic implementations
+
+      /// Scale a vector: <tt>result[i] *= factor</tt>
+      template <typename T>
+      inline void scale_to(const std::size_t n, const T factor, T* const result) {
+        for(std::size_t i = 0ul; i < n; ++i)
+          result[i] *= factor;
+      }
+
+      /// Add a vector: <tt>result[i] += arg[i]</tt>
+      template <typename T, typename U>
+      inline void add_to(const std::size_t n, T* const result, const U* const arg) {
+        for(std::size_t i = 0ul; i < n; ++i)
+          result[i] += arg[i];
+      }
+
+      /// Add and scale a vector: <tt>result[i] = (result[i] + arg[i]) * factor</tt>
+      template <typename T, typename U>
+      inline void add_to(const std::size_t n, T* const result, const U* const arg,
+          const T factor)
+      {
+        for(std::size_t i = 0ul; i < n; ++i)
+          (result[i] += arg[i]) *= factor;
+      }
+
+      /// Subtract a vector: <tt>result[i] -= arg[i]</tt>
+      template <typename T, typename U>
+      inline void subt_to(const std::size_t n, T* const result, const U* const arg) {
+        for(std::size_t i = 0ul; i < n; ++i)
+          result[i] -= arg[i];
+      }
+
+      /// Subtract and scale a vector: <tt>result[i] = (result[i] - arg[i]) * factor</tt>
+      template <typename T, typename U>
+      inline void subt_to(const std::size_t n, T* const result, const U* const arg,
+          const T factor)
+      {
+        for(std::size_t i = 0ul; i < n; ++i)
+          (result[i] -= arg[i]) *= factor;
+      }
+
+      /// Hadamard product: <tt>result[i] *= arg[i]</tt>
+      template <typename T, typename U>
+      inline void mult_to(const std::size_t n, T* const result, const U* const arg) {
+        for(std::size_t i = 0ul; i < n; ++i)
+          result[i] *= arg[i];
+      }
+
+      /// Scaled Hadamard product: <tt>result[i] = result[i] * arg[i] * factor</tt>
+      template <typename T, typename U>
+      inline void mult_to(const std::size_t n, T* const result, const U* const arg,
+          const T factor)
+      {
+        for(std::size_t i = 0ul; i < n; ++i)
+          (result[i] *= arg[i]) *= factor;
+      }
+
+      /// Sum of squares of a real vector
+      template <typename T>
+      inline T squared_norm(const std::size_t n, const T* const arg) {
+        T result(0);
+        for(std::size_t i = 0ul; i < n; ++i)
+          result += arg[i] * arg[i];
+        return result;
+      }
+
+      /// Dot product of two vectors
+      template <typename T, typename U>
+      inline T dot(const std::size_t n, const T* const left, const U* const right) {
+        T result(0);
+        for(std::size_t i = 0ul; i < n; ++i)
+          result += left[i] * right[i];
+        return result;
+      }
+
+      /// Maximum absolute value of a vector
+      template <typename T>
+      inline T abs_max(const std::size_t n, const T* const arg) {
+        T result(0);
+        for(std::size_t i = 0ul; i < n; ++i)
+          result = std::max(result, T(std::abs(arg[i])));
+        return result;
+      }
+
+      // Explicitly vectorized implementations
+
+      void scale_to(const std::size_t n, const double factor, double* const result);
+      void scale_to(const std::size_t n, const float factor, float* const result);
+      void add_to(const std::size_t n, double* const result, const double* const arg);
+      void add_to(const std::size_t n, float* const result, const float* const arg);
+      void add_to(const std::size_t n, double* const result, const double* const arg,
+          const double factor);
+      void add_to(const std::size_t n, float* const result, const float* const arg,
+          const float factor);
+      void subt_to(const std::size_t n, double* const result, const double* const arg);
+      void subt_to(const std::size_t n, float* const result, const float* const arg);
+      void subt_to(const std::size_t n, double* const result, const double* const arg,
+          const double factor);
+      void subt_to(const std::size_t n, float* const result, const float* const arg,
+          const float factor);
+      void mult_to(const std::size_t n, double* const result, const double* const arg);
+      void mult_to(const std::size_t n, float* const result, const float* const arg);
+      void mult_to(const std::size_t n, double* const result, const double* const arg,
+          const double factor);
+      void mult_to(const std::size_t n, float* const result, const float* const arg,
+          const float factor);
+      double squared_norm(const std::size_t n, const double* const arg);
+      float squared_norm(const std::size_t n, const float* const arg);
+      double dot(const std::size_t n, const double* const left, const double* const right);
+      float dot(const std::size_t n, const float* const left, const float* const right);
+      double abs_max(const std::size_t n, const double* const arg);
+      float abs_max(const std::size_t n, const float* const arg);
+
+    }  // namespace simd
+  }  // namespace math
+} // namespace TiledArray
+
+#endif // TILEDARRAY_MATH_VECTOR_SIMD_H__INCLUDED
@@ -41,6 +41,26 @@ namespace TiledArray {
                              ///< output weights (or strides).
       unsigned int ndim_; ///< The number of dimensions in the coordinate index space
 
+      /// Permute an ordinal index
+
+      /// \tparam N The rank, or \c 0 when the rank is only known at run time
+      template <unsigned int N>
+      struct Kernel {
+        static TILEDARRAY_FORCE_INLINE std::size_t
+        eval(const unsigned int ndim, std::size_t index,
+            const std::size_t* restrict const input_weight,
+            const std::size_t* restrict const output_weight)
+        {
+          std::size_t perm_index = 0ul;
+          rank_for<N>(ndim, [&] (const unsigned int i) {
+            const std::size_t input_weight_i = input_weight[i];
+            perm_index += index / input_weight_i * output_weight[i];
+            index %= input_weight_i;
+          });
+          return perm_index;
+        }
+      }; // struct Kernel
+
     public:
 
       /// Default constructor
@@ -146,21 +166,11 @@ namespace TiledArray {
         TA_ASSERT(ndim_);
         TA_ASSERT(weights_);
 
-        // Construct restricted pointers to data
-        const std::size_t* restrict const input_weight = weights_;
-        const std::size_t* restrict const output_weight = weights_ + ndim_;
-
-        // create result index
-        std::size_t perm_index = 0ul;
-
-        for(unsigned int i = 0u; i < ndim_; ++i) {
-          const std::size_t input_weight_i = input_weight[i];
-          const std::size_t output_weight_i = output_weight[i];
-          perm_index += index / input_weight_i * output_weight_i;
-          index %= input_weight_i;
-        }
+        // Construct pointers to data
+        const std::size_t* const input_weight = weights_;
+        const std::size_t* const output_weight = weights_ + ndim_;
 
-        return perm_index;
+        return fixed_rank_eval<Kernel>(ndim_, index, input_weight, output_weight);
       }
 
       // Check for valid permutation
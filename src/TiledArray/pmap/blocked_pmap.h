@@ -100,6 +100,20 @@ namespace TiledArray {
       virtual bool is_local(const size_type tile) const {
         return ((tile >= local_first_) && (tile < local_last_));
       }
+
+      /// Local tile ordinal
+
+      /// \param tile A local tile
+      /// \return The position of \c tile in the local tile list
+      virtual size_type local_ordinal(const size_type tile) const {
+        TA_ASSERT(BlockedPmap::is_local(tile));
+        return tile - local_first_;
+      }
+
+      /// Direct local ordinal query
+
+      /// \return \c true
+      virtual bool has_local_ordinal() const { return true; }
     }; // class BlockedPmap
 
   }  // namespace detail
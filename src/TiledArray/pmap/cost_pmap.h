@@ -0,0 +1,219 @@
+/*
+ *  This file is a part of TiledArray.
+ *  Copyright (C) 2016  Virginia Tech
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef TILEDARRAY_PMAP_COST_PMAP_H__INCLUDED
+#define TILEDARRAY_PMAP_COST_PMAP_H__INCLUDED
+
+#include <TiledArray/pmap/pmap.h>
+#include <TiledArray/range.h>
+#include <algorithm>
+#include <cstdint>
+#include <memory>
+#include <utility>
+
+namespace TiledArray {
+  namespace detail {
+
+    /// A cost balanced process map
+
+    /// Tiles are ordered along a Z-order (Morton) curve through the tile
+    /// coordinates, and the curve is split into one contiguous segment per
+    /// process such that the total cost of each segment is approximately
+    /// equal. Tiles that are close to each other in the tile range tend to be
+    /// mapped to the same process. Unlike the other process maps, the owner
+    /// and local ordinal of every tile are stored, so the memory requirement
+    /// is O(tiles). All processes must construct the map with the same costs.
+    class CostPmap : public Pmap {
+    protected:
+
+      // Import Pmap protected variables
+      using Pmap::rank_; ///< The rank of this process
+      using Pmap::procs_; ///< The number of processes
+      using Pmap::size_; ///< The number of tiles mapped among all processes
+      using Pmap::local_; ///< A list of local tiles
+
+    private:
+
+      std::vector<unsigned int> owners_; ///< The owner of each tile
+      std::vector<unsigned int> ordinals_; ///< The local ordinal of each tile on its owner
+
+      /// Compute the tile owners
+
+      /// \param range The tile range
+      /// \param costs The cost of each tile
+      void init(const Range& range, const std::vector<double>& costs) {
+        TA_ASSERT(range.volume() == size_);
+        TA_ASSERT(costs.size() == size_);
+
+        const unsigned int rank = range.rank();
+        const Range::size_type* restrict const extent = range.extent_data();
+
+        // The number of coordinate bits in the curve key
+        unsigned int bits = 0u;
+        for(unsigned int d = 0u; d < rank; ++d)
+          while((bits < 64u) && ((Range::size_type(1) << bits) < extent[d]))
+            ++bits;
+        bits = std::min(bits, 64u / std::max(rank, 1u));
+
+        // Compute the position of each tile on the curve
+        std::vector<std::pair<std::uint64_t, size_type> > curve;
+        curve.reserve(size_);
+        std::vector<Range::size_type> index(rank, 0ul);
+        for(size_type ord = 0ul; ord < size_; ++ord) {
+          std::uint64_t key = 0ul;
+          for(unsigned int b = bits; b > 0u; --b)
+            for(unsigned int d = 0u; d < rank; ++d)
+              key = (key << 1) | ((index[d] >> (b - 1u)) & 1ul);
+          curve.emplace_back(key, ord);
+
+          // Increment the row-major tile index
+          for(unsigned int d = rank; d > 0u; --d) {
+            if(++index[d - 1u] < extent[d - 1u])
+              break;
+            index[d - 1u] = 0ul;
+          }
+        }
+        std::sort(curve.begin(), curve.end());
+
+        // Sum the costs. Equal costs are used when all costs are zero.
+        double total = 0.0;
+        for(const double cost : costs) {
+          TA_ASSERT(cost >= 0.0);
+          total += cost;
+        }
+        const bool uniform = ! (total > 0.0);
+        if(uniform)
+          total = double(size_);
+
+        // Assign each tile to the segment that contains the midpoint of its
+        // cost along the curve.
+        owners_.resize(size_);
+        double prefix = 0.0;
+        for(const auto& tile : curve) {
+          const double cost = (uniform ? 1.0 : costs[tile.second]);
+          const double position = (prefix + 0.5 * cost) * double(procs_) / total;
+          owners_[tile.second] = std::min<size_type>(size_type(position), procs_ - 1ul);
+          prefix += cost;
+        }
+
+        // Construct a list of local tiles and the local ordinals of all tiles
+        ordinals_.resize(size_);
+        std::vector<unsigned int> local_sizes(procs_, 0u);
+        for(size_type ord = 0ul; ord < size_; ++ord) {
+          ordinals_[ord] = local_sizes[owners_[ord]]++;
+          if(owners_[ord] == rank_)
+            local_.push_back(ord);
+        }
+      }
+
+    public:
+      typedef Pmap::size_type size_type; ///< Key type
+
+      /// Construct a cost balanced map
+
+      /// \param world The world where the tiles will be mapped
+      /// \param range The tile range
+      /// \param costs The non-negative cost of each tile, in ordinal order
+      CostPmap(World& world, const Range& range, const std::vector<double>& costs) :
+        Pmap(world, range.volume()), owners_(), ordinals_()
+      {
+        init(range, costs);
+      }
+
+      /// Construct a cost balanced map with a cost function
+
+      /// \tparam Op The cost function type
+      /// \param world The world where the tiles will be mapped
+      /// \param range The tile range
+      /// \param op The cost function, with signature
+      /// <tt>double(size_type)</tt>, that returns the non-negative cost of
+      /// the tile with the given ordinal index
+      template <typename Op>
+      CostPmap(World& world, const Range& range, const Op& op) :
+        Pmap(world, range.volume()), owners_(), ordinals_()
+      {
+        std::vector<double> costs;
+        costs.reserve(size_);
+        for(size_type ord = 0ul; ord < size_; ++ord)
+          costs.push_back(op(ord));
+        init(range, costs);
+      }
+
+      virtual ~CostPmap() { }
+
+      /// Maps \c tile to the processor that owns it
+
+      /// \param tile The tile to be queried
+      /// \return Processor that logically owns \c tile
+      virtual size_type owner(const size_type tile) const {
+        TA_ASSERT(tile < size_);
+        return owners_[tile];
+      }
+
+
+      /// Check that the tile is owned by this process
+
+      /// \param tile The tile to be checked
+      /// \return \c true if \c tile is owned by this process, otherwise \c false .
+      virtual bool is_local(const size_type tile) const {
+        return (CostPmap::owner(tile) == rank_);
+      }
+
+      /// Local tile ordinal
+
+      /// \param tile A local tile
+      /// \return The position of \c tile in the local tile list
+      virtual size_type local_ordinal(const size_type tile) const {
+        TA_ASSERT(CostPmap::is_local(tile));
+        return ordinals_[tile];
+      }
+
+      /// Direct local ordinal query
+
+      /// \return \c true
+      virtual bool has_local_ordinal() const { return true; }
+    }; // class CostPmap
+
+    /// Construct a cost balanced process map for an array
+
+    /// The cost of a tile is the number of elements in the tile, or zero when
+    /// the tile is zero in \c shape . The result may be used to construct a
+    /// \c DistArray or as the result process map of an expression (see
+    /// \c Expr::set_pmap() ).
+    /// \tparam TRange The tiled range type
+    /// \tparam Shape The shape type
+    /// \param world The world where the tiles will be mapped
+    /// \param trange The tiled range of the array
+    /// \param shape The shape of the array
+    /// \return A shared pointer to the process map
+    template <typename TRange, typename Shape>
+    inline std::shared_ptr<Pmap>
+    make_cost_pmap(World& world, const TRange& trange, const Shape& shape) {
+      return std::make_shared<CostPmap>(world, trange.tiles_range(),
+          [&] (const Pmap::size_type ord) -> double {
+            return (shape.is_zero(ord) ? 0.0 :
+                double(trange.make_tile_range(ord).volume()));
+          });
+    }
+
+  }  // namespace detail
+}  // namespace TiledArray
+
+
+#endif // TILEDARRAY_PMAP_COST_PMAP_H__INCLUDED
@@ -151,6 +151,23 @@ namespace TiledArray {
         return (CyclicPmap::owner(tile) == rank_);
       }
 
+      /// Local tile ordinal
+
+      /// \param tile A local tile
+      /// \return The position of \c tile in the local tile list
+      virtual size_type local_ordinal(const size_type tile) const {
+        TA_ASSERT(CyclicPmap::is_local(tile));
+        // The number of local tiles in each local row
+        const size_type local_cols =
+            (cols_ - (rank_ % proc_cols_) + proc_cols_ - 1ul) / proc_cols_;
+        return ((tile / cols_) / proc_rows_) * local_cols + (tile % cols_) / proc_cols_;
+      }
+
+      /// Direct local ordinal query
+
+      /// \return \c true
+      virtual bool has_local_ordinal() const { return true; }
+
     }; // class CyclicPmap
 
   }  // namespace detail
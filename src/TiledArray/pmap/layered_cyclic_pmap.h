@@ -0,0 +1,238 @@
+/*
+ *  This file is a part of TiledArray.
+ *  Copyright (C) 2016  Virginia Tech
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef TILEDARRAY_PMAP_LAYERED_CYCLIC_PMAP_H__INCLUDED
+#define TILEDARRAY_PMAP_LAYERED_CYCLIC_PMAP_H__INCLUDED
+
+#include <TiledArray/pmap/pmap.h>
+
+namespace TiledArray {
+  namespace detail {
+
+    /// Maps cyclically a sequence of indices onto a 3-d grid of processes
+
+    /// The processes are organized into \f$ L \f$ layers, where each layer is
+    /// a \f$ P_{\rm row} \times P_{\rm col} \f$ matrix of processes, and
+    /// process \f$ p \equiv \{ p_{\rm layer}, p_{\rm row}, p_{\rm col} \} \f$
+    /// has rank \f$ p_{\rm layer} P_{\rm row} P_{\rm col} + p_{\rm row} P_{\rm col} + p_{\rm col} \f$.
+    /// The tile indices are organized into a row-major matrix, as in
+    /// \c CyclicPmap . Either the rows or the columns of the tile matrix
+    /// (the layer dimension) are partitioned into \f$ L \f$ contiguous blocks,
+    /// and all tiles in block \f$ l \f$ are mapped to layer \f$ l \f$. Within
+    /// a layer, tile \f$ \{ k_{\rm row}, k_{\rm col} \} \f$ is mapped
+    /// cyclically to process
+    /// \f$ \{ k_{\rm row} \% P_{\rm row}, k_{\rm col} \% P_{\rm col} \} \f$.
+    /// This is the argument distribution used by the 2.5D SUMMA algorithm,
+    /// where the layer dimension is the inner (contracted) dimension.
+    ///
+    /// \note This class is used to map <em>tile</em> indices to processes.
+    class LayeredCyclicPmap : public Pmap {
+    protected:
+
+      // Import Pmap protected variables
+      using Pmap::rank_; ///< The rank of this process
+      using Pmap::procs_; ///< The number of processes
+      using Pmap::size_; ///< The number of tiles mapped among all processes
+      using Pmap::local_; ///< A list of local tiles
+
+    private:
+
+      const size_type rows_; ///< Number of tile rows to be mapped
+      const size_type cols_; ///< Number of tile columns to be mapped
+      const size_type proc_cols_; ///< Number of process columns
+      const size_type proc_rows_; ///< Number of process rows
+      const size_type layers_; ///< Number of process layers
+      const bool layer_cols_; ///< Layer dimension flag (\c true == columns)
+      size_type local_row_begin_; ///< The first local tile row
+      size_type local_col_begin_; ///< The first local tile column
+      size_type local_cols_; ///< The number of local tiles in each local row
+
+    public:
+      typedef Pmap::size_type size_type; ///< Size type
+
+      /// Compute the first index of a layer block
+
+      /// The \c extent indices of the layer dimension are partitioned into
+      /// \c layers contiguous blocks, where the first <tt>extent % layers</tt>
+      /// blocks contain one extra index.
+      /// \param layer The layer index
+      /// \param extent The number of rows or columns in the layer dimension
+      /// \param layers The number of layers
+      /// \return The first row or column of the block owned by \c layer
+      static size_type layer_begin(const size_type layer, const size_type extent,
+          const size_type layers)
+      {
+        TA_ASSERT(layer <= layers);
+        return layer * (extent / layers) + std::min(layer, extent % layers);
+      }
+
+      /// Compute the layer that owns a row or column
+
+      /// \param index The row or column index in the layer dimension
+      /// \param extent The number of rows or columns in the layer dimension
+      /// \param layers The number of layers
+      /// \return The layer that owns \c index
+      static size_type layer_owner(const size_type index, const size_type extent,
+          const size_type layers)
+      {
+        TA_ASSERT(index < extent);
+        const size_type block = extent / layers;
+        const size_type rem = extent % layers;
+        const size_type big_end = rem * (block + 1ul);
+        return (index < big_end ? index / (block + 1ul) :
+            rem + (index - big_end) / block);
+      }
+
+      /// Construct process map
+
+      /// \param world The world where the tiles will be mapped
+      /// \param rows The number of tile rows to be mapped
+      /// \param cols The number of tile columns to be mapped
+      /// \param proc_rows The number of process rows in each layer
+      /// \param proc_cols The number of process columns in each layer
+      /// \param layers The number of process layers
+      /// \param layer_cols If \c true, the tile columns are partitioned among
+      /// the process layers, otherwise the tile rows are partitioned.
+      /// \throw TiledArray::Exception When <tt>proc_rows * proc_cols * layers > world.size()</tt>
+      /// \throw TiledArray::Exception When \c layers is greater than the
+      /// number of rows or columns in the layer dimension.
+      LayeredCyclicPmap(World& world, size_type rows, size_type cols,
+          size_type proc_rows, size_type proc_cols, size_type layers,
+          bool layer_cols) :
+        Pmap(world, rows * cols), rows_(rows), cols_(cols),
+        proc_cols_(proc_cols), proc_rows_(proc_rows), layers_(layers),
+        layer_cols_(layer_cols), local_row_begin_(0ul), local_col_begin_(0ul),
+        local_cols_(0ul)
+      {
+        // Check that the size is non-zero
+        TA_ASSERT(rows_ >= 1ul);
+        TA_ASSERT(cols_ >= 1ul);
+
+        // Check limits of process rows, columns, and layers
+        TA_ASSERT(proc_rows_ >= 1ul);
+        TA_ASSERT(proc_cols_ >= 1ul);
+        TA_ASSERT(layers_ >= 1ul);
+        TA_ASSERT(layers_ <= (layer_cols_ ? cols_ : rows_));
+        TA_ASSERT((proc_rows_ * proc_cols_ * layers_) <= procs_);
+
+        // Initialize local tile list
+        const size_type layer_size = proc_rows_ * proc_cols_;
+        if(rank_ < (layer_size * layers_)) {
+          // Compute rank coordinates
+          const size_type rank_layer = rank_ / layer_size;
+          const size_type rank_row = (rank_ % layer_size) / proc_cols_;
+          const size_type rank_col = rank_ % proc_cols_;
+
+          // Compute the tile row and column limits of this layer
+          size_type row_begin = 0ul, row_end = rows_, col_begin = 0ul, col_end = cols_;
+          if(layer_cols_) {
+            col_begin = layer_begin(rank_layer, cols_, layers_);
+            col_end = layer_begin(rank_layer + 1ul, cols_, layers_);
+          } else {
+            row_begin = layer_begin(rank_layer, rows_, layers_);
+            row_end = layer_begin(rank_layer + 1ul, rows_, layers_);
+          }
+
+          // Move the iteration limits to the first local row and column
+          row_begin += (proc_rows_ - ((row_begin + proc_rows_ - rank_row) % proc_rows_)) % proc_rows_;
+          col_begin += (proc_cols_ - ((col_begin + proc_cols_ - rank_col) % proc_cols_)) % proc_cols_;
+
+          local_row_begin_ = row_begin;
+          local_col_begin_ = col_begin;
+          if(col_begin < col_end)
+            local_cols_ = (col_end - col_begin + proc_cols_ - 1ul) / proc_cols_;
+
+          // Iterate over local tiles
+          for(size_type i = row_begin; i < row_end; i += proc_rows_) {
+            for(size_type j = col_begin; j < col_end; j += proc_cols_) {
+              const size_type tile = i * cols_ + j;
+              TA_ASSERT(LayeredCyclicPmap::owner(tile) == rank_);
+              local_.push_back(tile);
+            }
+          }
+        }
+      }
+
+      virtual ~LayeredCyclicPmap() { }
+
+      /// Access number of rows in the tile index matrix
+      size_type nrows() const { return rows_; }
+      /// Access number of columns in the tile index matrix
+      size_type ncols() const { return cols_; }
+      /// Access number of rows in the process matrix of each layer
+      size_type nrows_proc() const { return proc_rows_; }
+      /// Access number of columns in the process matrix of each layer
+      size_type ncols_proc() const { return proc_cols_; }
+      /// Access number of process layers
+      size_type nlayers() const { return layers_; }
+
+      /// Maps \c tile to the processor that owns it
+
+      /// \param tile The tile to be queried
+      /// \return Processor that logically owns \c tile
+      virtual size_type owner(const size_type tile) const {
+        TA_ASSERT(tile < size_);
+        // Compute tile coordinate in tile grid
+        const size_type tile_row = tile / cols_;
+        const size_type tile_col = tile % cols_;
+        // Compute process coordinate of tile in the process grid
+        const size_type proc_layer = (layer_cols_ ?
+            layer_owner(tile_col, cols_, layers_) :
+            layer_owner(tile_row, rows_, layers_));
+        const size_type proc_row = tile_row % proc_rows_;
+        const size_type proc_col = tile_col % proc_cols_;
+        // Compute the process that owns tile
+        const size_type proc = (proc_layer * proc_rows_ + proc_row) * proc_cols_ + proc_col;
+
+        TA_ASSERT(proc < procs_);
+
+        return proc;
+      }
+
+
+      /// Check that the tile is owned by this process
+
+      /// \param tile The tile to be checked
+      /// \return \c true if \c tile is owned by this process, otherwise \c false .
+      virtual bool is_local(const size_type tile) const {
+        return (LayeredCyclicPmap::owner(tile) == rank_);
+      }
+
+      /// Local tile ordinal
+
+      /// \param tile A local tile
+      /// \return The position of \c tile in the local tile list
+      virtual size_type local_ordinal(const size_type tile) const {
+        TA_ASSERT(LayeredCyclicPmap::is_local(tile));
+        return ((tile / cols_ - local_row_begin_) / proc_rows_) * local_cols_ +
+            (tile % cols_ - local_col_begin_) / proc_cols_;
+      }
+
+      /// Direct local ordinal query
+
+      /// \return \c true
+      virtual bool has_local_ordinal() const { return true; }
+
+    }; // class LayeredCyclicPmap
+
+  }  // namespace detail
+}  // namespace TiledArray
+
+
+#endif // TILEDARRAY_PMAP_LAYERED_CYCLIC_PMAP_H__INCLUDED
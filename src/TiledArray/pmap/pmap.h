@@ -28,6 +28,7 @@
 
 #include <TiledArray/madness.h>
 #include <TiledArray/error.h>
+#include <algorithm>
 
 namespace TiledArray {
 
@@ -42,7 +43,8 @@ namespace TiledArray {
   /// algorithms that need to iterate over local tiles can do so without
   /// computing the owner of all tiles. The algorithm to generate the cached
   /// list of local tiles and the memory requirement should scale as
-  /// O(tiles/processes), if possible.
+  /// O(tiles/processes), if possible. The list of local tiles is sorted in
+  /// ascending order.
   class Pmap {
   public:
     typedef std::size_t size_type; ///< Size type
@@ -85,6 +87,32 @@ namespace TiledArray {
     /// \return \c true if \c tile is owned by this process, otherwise \c false .
     virtual bool is_local(const size_type tile) const = 0;
 
+    /// Local tile ordinal
+
+    /// The local ordinal is the position of a local tile in the local tile
+    /// list, which may be used to index local data directly. The default
+    /// implementation searches the local tile list, which must be sorted;
+    /// derived classes may provide an O(1) implementation (see
+    /// \c has_local_ordinal() ).
+    /// \param tile A local tile
+    /// \return The position of \c tile in the local tile list
+    virtual size_type local_ordinal(const size_type tile) const {
+      TA_ASSERT(is_local(tile));
+      const const_iterator it = std::lower_bound(local_.begin(), local_.end(), tile);
+      TA_ASSERT((it != local_.end()) && (*it == tile));
+      return it - local_.begin();
+    }
+
+    /// Direct local ordinal query
+
+    /// Process maps that return \c true guarantee that the local tile list
+    /// contains every local tile in ascending order, and that
+    /// \c local_ordinal() is O(1). Storage objects index local data directly
+    /// only for such process maps.
+    /// \return \c true if \c local_ordinal() is O(1) and the local tile list
+    /// is complete and sorted, otherwise \c false
+    virtual bool has_local_ordinal() const { return false; }
+
     /// Size accessor
 
     /// \return The number of elements
@@ -84,6 +84,20 @@ namespace TiledArray {
         return true;
       }
 
+      /// Local tile ordinal
+
+      /// \param tile A tile
+      /// \return The position of \c tile in the local tile list
+      virtual size_type local_ordinal(const size_type tile) const {
+        TA_ASSERT(tile < size_);
+        return tile;
+      }
+
+      /// Direct local ordinal query
+
+      /// \return \c true
+      virtual bool has_local_ordinal() const { return true; }
+
       /// Replicated array status
 
       /// \return \c true if the array is replicated, and false otherwise
@@ -27,6 +27,7 @@
 #define TILEDARRAY_GRID_H__INCLUDED
 
 #include <TiledArray/pmap/cyclic_pmap.h>
+#include <TiledArray/pmap/layered_cyclic_pmap.h>
 #include <TiledArray/math/eigen.h>
 
 namespace TiledArray {
@@ -56,6 +57,14 @@ namespace TiledArray {
     /// \f]
     /// where the positive, real root of \f$P_{\rm{row}}\f$ give the optimal
     /// optimal communication time.
+    ///
+    /// The process grid may also be replicated over \f$c\f$ process layers,
+    /// which forms a 3D process grid for the communication-avoiding (2.5D)
+    /// SUMMA algorithm. Each layer is a 2D process grid of (approximately)
+    /// \f$P/c\f$ processes, and it evaluates the contraction for a
+    /// contiguous block of the inner dimension. The 2D grid dimensions are
+    /// optimized as described above, where the number of available processes
+    /// is \f$P/c\f$.
     class ProcGrid {
     public:
       typedef uint_fast32_t size_type;
@@ -69,8 +78,10 @@ namespace TiledArray {
       size_type proc_cols_; ///< Number of columns in the process grid
       size_type proc_size_; ///< Number of processes in the process grid. This
                          ///<  may be less than the number of processes in world.
+      size_type proc_layers_; ///< Number of process grid layers
       ProcessID rank_row_; ///< This process's row in the process grid
       ProcessID rank_col_; ///< This process's column in the process grid
+      ProcessID rank_layer_; ///< This process's layer in the process grid
       size_type local_rows_; ///< The number of local element rows
       size_type local_cols_; ///< The number of local element columns
       size_type local_size_; ///< Number of local elements
@@ -172,77 +183,72 @@ namespace TiledArray {
 
       /// This function initializes the member variables with with the optimal
       /// sizes.
+      /// \param rank The rank of this process
+      /// \param nprocs The number of available processes
+      /// \param row_size The number of element rows
+      /// \param col_size The number of element columns
+      /// \param layers The number of process layers
       void init(const size_type rank, const size_type nprocs,
-          const std::size_t row_size, const std::size_t col_size)
+          const std::size_t row_size, const std::size_t col_size,
+          const size_type layers)
       {
+        TA_ASSERT(layers >= 1u);
+        TA_ASSERT(layers <= nprocs);
+
+        // Each layer is a 2D process grid of at most nprocs / layers processes
+        const size_type layer_nprocs = nprocs / layers;
+        proc_layers_ = layers;
+
         // Check for the simple cases first ...
-        if(nprocs == 1u) { // Only one process
+        if(layer_nprocs == 1u) { // Only one process
 
           // Set process grid sizes
           proc_rows_ = 1u;
           proc_cols_ = 1u;
           proc_size_ = 1u;
 
-          // Set this process rank
-          rank_row_ = 0;
-          rank_col_ = 0;
-
-          // Set local counts
-          local_rows_ = rows_;
-          local_cols_ = cols_;
-          local_size_ = size_;
-
-        } else if(size_ <= nprocs) { // Max one tile per process
+        } else if(size_ <= layer_nprocs) { // Max one tile per process
 
           // Set process grid sizes
           proc_rows_ = rows_;
           proc_cols_ = cols_;
           proc_size_ = size_;
 
-          if(rank < proc_size_) {
-            // Set this process rank
-            rank_row_ = rank / proc_cols_;
-            rank_col_ = rank % proc_cols_;
-
-            // Set local counts
-            local_rows_ = 1u;
-            local_cols_ = 1u;
-            local_size_ = 1u;
-          }
-
         } else { // The not so simple case
 
           // Compute the limits for process rows
           const size_type min_proc_rows =
-              std::max<size_type>(((nprocs + cols_ - 1ul) / cols_), 1ul);
-          const size_type max_proc_rows = std::min<size_type>(nprocs, rows_);
+              std::max<size_type>(((layer_nprocs + cols_ - 1ul) / cols_), 1ul);
+          const size_type max_proc_rows = std::min<size_type>(layer_nprocs, rows_);
 
           // Compute optimal the number of process rows and columns in terms of
           // communication time.
           proc_rows_ = std::max<size_type>(min_proc_rows,
-              std::min<size_type>(optimal_proc_row(nprocs, row_size, col_size),
+              std::min<size_type>(optimal_proc_row(layer_nprocs, row_size, col_size),
                   max_proc_rows));
-          proc_cols_ = nprocs / proc_rows_;
+          proc_cols_ = layer_nprocs / proc_rows_;
 
           if((proc_rows_ > min_proc_rows) && (proc_rows_ < max_proc_rows)) {
             // Search for the values of proc_rows_ and proc_cols_ that minimizes
             // the number of unused processes in the process grid.
-            minimize_unused_procs(proc_rows_, proc_cols_, nprocs,
+            minimize_unused_procs(proc_rows_, proc_cols_, layer_nprocs,
                 min_proc_rows, max_proc_rows);
           }
 
           proc_size_ = proc_rows_ * proc_cols_;
+        }
 
-          if(rank < proc_size_) {
-            // Set this process rank
-            rank_row_ = rank / proc_cols_;
-            rank_col_ = rank % proc_cols_;
+        if(rank < (proc_size_ * proc_layers_)) {
+          // Set this process rank
+          const size_type layer_rank = rank % proc_size_;
+          rank_layer_ = rank / proc_size_;
+          rank_row_ = layer_rank / proc_cols_;
+          rank_col_ = layer_rank % proc_cols_;
 
-            // Set local counts
-            local_rows_ = (rows_ / proc_rows_) + (size_type(rank_row_) < (rows_ % proc_rows_) ? 1u : 0u);
-            local_cols_ = (cols_ / proc_cols_) + (size_type(rank_col_) < (cols_ % proc_cols_) ? 1u : 0u);
-            local_size_ = local_rows_ * local_cols_;
-          }
+          // Set local counts
+          local_rows_ = (rows_ / proc_rows_) + (size_type(rank_row_) < (rows_ % proc_rows_) ? 1u : 0u);
+          local_cols_ = (cols_ / proc_cols_) + (size_type(rank_col_) < (cols_ % proc_cols_) ? 1u : 0u);
+          local_size_ = local_rows_ * local_cols_;
         }
       }
 
@@ -252,8 +258,9 @@ namespace TiledArray {
       /// All sizes are initialized to zero.
       ProcGrid() :
         world_(NULL), rows_(0u), cols_(0u), size_(0u), proc_rows_(0u),
-        proc_cols_(0u), proc_size_(0u), rank_row_(0), rank_col_(0),
-        local_rows_(0u), local_cols_(0u), local_size_(0u)
+        proc_cols_(0u), proc_size_(0u), proc_layers_(1u), rank_row_(0),
+        rank_col_(0), rank_layer_(0), local_rows_(0u), local_cols_(0u),
+        local_size_(0u)
       { }
 
       /// Construct a process grid
@@ -266,11 +273,13 @@ namespace TiledArray {
       /// \param cols The number of tile columns
       /// \param row_size The number of element rows
       /// \param col_size The number of element columns
+      /// \param layers The number of process layers [ default = 1 ]
       ProcGrid(World& world, const size_type rows, const size_type cols,
-          const std::size_t row_size, const std::size_t col_size) :
+          const std::size_t row_size, const std::size_t col_size,
+          const size_type layers = 1u) :
         world_(&world), rows_(rows), cols_(cols), size_(rows_ * cols_),
-        proc_rows_(0ul), proc_cols_(0ul), proc_size_(0ul),
-        rank_row_(-1), rank_col_(-1),
+        proc_rows_(0ul), proc_cols_(0ul), proc_size_(0ul), proc_layers_(0ul),
+        rank_row_(-1), rank_col_(-1), rank_layer_(-1),
         local_rows_(0ul), local_cols_(0ul), local_size_(0ul)
       {
         // Check for non-zero sizes
@@ -279,7 +288,7 @@ namespace TiledArray {
         TA_ASSERT(row_size >= 1ul);
         TA_ASSERT(col_size >= 1ul);
 
-        init(world_->rank(), world_->size(), row_size, col_size);
+        init(world_->rank(), world_->size(), row_size, col_size, layers);
       }
 
 #ifdef TILEDARRAY_ENABLE_TEST_PROC_GRID
@@ -300,12 +309,15 @@ namespace TiledArray {
       /// \param cols The number of tile columns
       /// \param row_size The number of element rows
       /// \param col_size The number of element columns
+      /// \param layers The number of process layers [ default = 1 ]
       ProcGrid(World& world, const size_type test_rank, size_type test_nprocs,
           const size_type rows, const size_type cols,
-          const std::size_t row_size, const std::size_t col_size) :
+          const std::size_t row_size, const std::size_t col_size,
+          const size_type layers = 1u) :
         world_(&world), rows_(rows), cols_(cols), size_(rows_ * cols_),
-        proc_rows_(0u), proc_cols_(0u), proc_size_(0u), rank_row_(-1),
-        rank_col_(-1), local_rows_(0u), local_cols_(0u), local_size_(0u)
+        proc_rows_(0u), proc_cols_(0u), proc_size_(0u), proc_layers_(0u),
+        rank_row_(-1), rank_col_(-1), rank_layer_(-1), local_rows_(0u),
+        local_cols_(0u), local_size_(0u)
       {
         // Check for non-zero sizes
         TA_ASSERT(rows >= 1u);
@@ -314,7 +326,7 @@ namespace TiledArray {
         TA_ASSERT(col_size >= 1u);
         TA_ASSERT(test_rank < test_nprocs);
 
-        init(test_rank, test_nprocs, row_size, col_size);
+        init(test_rank, test_nprocs, row_size, col_size, layers);
       }
 #endif // TILEDARRAY_ENABLE_TEST_PROC_GRID
 
@@ -328,7 +340,8 @@ namespace TiledArray {
         world_(other.world_), rows_(other.rows_), cols_(other.cols_),
         size_(other.size_), proc_rows_(other.proc_rows_),
         proc_cols_(other.proc_cols_), proc_size_(other.proc_size_),
-        rank_row_(other.rank_row_), rank_col_(other.rank_col_),
+        proc_layers_(other.proc_layers_), rank_row_(other.rank_row_),
+        rank_col_(other.rank_col_), rank_layer_(other.rank_layer_),
         local_rows_(other.local_rows_), local_cols_(other.local_cols_),
         local_size_(other.local_size_)
       { }
@@ -344,8 +357,10 @@ namespace TiledArray {
         proc_rows_ = other.proc_rows_;
         proc_cols_ = other.proc_cols_;
         proc_size_ = other.proc_size_;
+        proc_layers_ = other.proc_layers_;
         rank_row_ = other.rank_row_;
         rank_col_ = other.rank_col_;
+        rank_layer_ = other.rank_layer_;
         local_rows_ = other.local_rows_;
         local_cols_ = other.local_cols_;
         local_size_ = other.local_size_;
@@ -393,6 +408,11 @@ namespace TiledArray {
       /// \return The column of this process in the process grid
       ProcessID rank_col() const { return rank_col_; }
 
+      /// Rank layer accessor
+
+      /// \return The layer of this process in the process grid
+      ProcessID rank_layer() const { return rank_layer_; }
+
       /// Process row count accessor
 
       /// \return The number of rows in the process grid
@@ -405,10 +425,98 @@ namespace TiledArray {
 
       /// Process grid size accessor
 
-      /// \return The number of processes included in the process grid (may be
-      /// less than the number of process in world).
+      /// \return The number of processes included in each layer of the
+      /// process grid (may be less than the number of process in world).
       size_type proc_size() const { return proc_size_; }
 
+      /// Process layer count accessor
+
+      /// \return The number of layers in the process grid
+      size_type proc_layers() const { return proc_layers_; }
+
+      /// Layer offset accessor
+
+      /// \return The rank of the first process in this process's layer
+      ProcessID layer_offset() const {
+        return (rank_layer_ > 0 ? rank_layer_ * proc_size_ : 0);
+      }
+
+      /// The first inner dimension tile of this process's layer
+
+      /// The inner dimension of the contraction is partitioned into contiguous
+      /// blocks, one for each process layer.
+      /// \param k The number of tiles in the inner dimension
+      /// \return The first inner dimension tile evaluated by this layer, or
+      /// \c 0 if this process is not included in the process grid.
+      size_type layer_k_begin(const size_type k) const {
+        if(rank_layer_ < 0) return 0ul;
+        return LayeredCyclicPmap::layer_begin(rank_layer_, k, proc_layers_);
+      }
+
+      /// The end of the inner dimension tile range of this process's layer
+
+      /// \param k The number of tiles in the inner dimension
+      /// \return The end of the inner dimension tile range evaluated by this
+      /// layer, or \c 0 if this process is not included in the process grid.
+      size_type layer_k_end(const size_type k) const {
+        if(rank_layer_ < 0) return 0ul;
+        return LayeredCyclicPmap::layer_begin(rank_layer_ + 1, k, proc_layers_);
+      }
+
+
+      /// Compute the number of process layers for a 2.5D SUMMA
+
+      /// The number of layers, \f$c\f$, is selected such that the estimated
+      /// communication volume per process,
+      /// \f[
+      ///   V = \frac{MmKk + KkNn}{\sqrt{cP}} + \frac{c(c-1)MmNn}{P} ,
+      /// \f]
+      /// is minimized, where the first term is the volume of the argument
+      /// broadcasts and the second term is the volume of the reduction of the
+      /// partial results held by each layer. The additional memory required
+      /// to store the \f$c-1\f$ copies of the partial results, which is
+      /// \f$(c-1)MmNn/P\f$ elements per process, is limited to half of
+      /// \c max_memory . If \c max_memory is zero, no layers are used.
+      /// \param nprocs The number of available processes
+      /// \param k The number of tiles in the inner dimension
+      /// \param row_size The number of element rows (\f$Mm\f$)
+      /// \param col_size The number of element columns (\f$Nn\f$)
+      /// \param inner_size The number of elements in the inner dimension (\f$Kk\f$)
+      /// \param element_size The size of an element in bytes
+      /// \param max_memory The memory available per process in bytes
+      /// \return The number of process layers
+      static size_type optimal_layers(const size_type nprocs, const size_type k,
+          const std::size_t row_size, const std::size_t col_size,
+          const std::size_t inner_size, const std::size_t element_size,
+          const std::size_t max_memory)
+      {
+        if(max_memory == 0ul)
+          return 1u;
+
+        const double P = nprocs;
+        const double Mm = row_size, Nn = col_size, Kk = inner_size;
+        const double bcast_volume = Mm * Kk + Kk * Nn;
+        const double result_volume = Mm * Nn / P;
+        const double max_layer_memory = 0.5 * double(max_memory);
+        const size_type max_layers = std::min(nprocs, k);
+
+        size_type layers = 1u;
+        double min_volume = bcast_volume / std::sqrt(P);
+        for(size_type c = 2u; c <= max_layers; ++c) {
+          // Check that the partial results fit in memory.
+          if((double(c - 1u) * result_volume * double(element_size)) > max_layer_memory)
+            break;
+
+          const double volume = bcast_volume / std::sqrt(double(c) * P)
+              + double(c * (c - 1u)) * result_volume;
+          if(volume < min_volume) {
+            min_volume = volume;
+            layers = c;
+          }
+        }
+
+        return layers;
+      }
 
       /// Construct a row group
 
@@ -425,7 +533,7 @@ namespace TiledArray {
           proc_list.reserve(proc_cols_);
 
           // Populate the row process list
-          size_type p = rank_row_ * proc_cols_;
+          size_type p = layer_offset() + rank_row_ * proc_cols_;
           const size_type row_end = p + proc_cols_;
           for(; p < row_end; ++p)
             proc_list.push_back(p);
@@ -452,8 +560,9 @@ namespace TiledArray {
           proc_list.reserve(proc_rows_);
 
           // Populate the column process list
+          const size_type offset = layer_offset();
           for(size_type p = rank_col_; p < proc_size_; p += proc_cols_)
-            proc_list.push_back(p);
+            proc_list.push_back(p + offset);
 
           // Construct the group
           if(proc_list.size() != 0)
@@ -469,7 +578,7 @@ namespace TiledArray {
       /// \return The process the corresponds to the process coordinate \c (row,rank_col)
       ProcessID map_row(const size_type row) const {
         TA_ASSERT(row < proc_rows_);
-        return rank_col_ + row * proc_cols_;
+        return layer_offset() + rank_col_ + row * proc_cols_;
       }
 
       /// Map a column to the process in this process's row
@@ -478,12 +587,13 @@ namespace TiledArray {
       /// \return The process the corresponds to the process coordinate \c (rank_row,col)
       ProcessID map_col(const size_type col) const {
         TA_ASSERT(col < proc_cols_);
-        return rank_row_ * proc_cols_ + col;
+        return layer_offset() + rank_row_ * proc_cols_ + col;
       }
 
       /// Construct a cyclic process
 
       /// Construct a cyclic process map with the same phase as the process grid.
+      /// The tiles are mapped to the first layer of the process grid.
       /// \return Cyclic process map
       std::shared_ptr<Pmap> make_pmap() const {
         TA_ASSERT(world_);
@@ -495,11 +605,17 @@ namespace TiledArray {
 
       /// Construct a cyclic process map where the column phase of the process
       /// matches that of this process grid.
+      /// When the process grid has more than one layer, the rows of the
+      /// process map are partitioned among the process layers.
       /// \param rows The number of rows in the process map
       /// \return Cyclic process map with matching column phase
       std::shared_ptr<Pmap> make_col_phase_pmap(const size_type rows) const {
         TA_ASSERT(world_);
 
+        if(proc_layers_ > 1u)
+          return std::shared_ptr<Pmap>(new LayeredCyclicPmap(*world_, rows,
+              cols_, proc_rows_, proc_cols_, proc_layers_, false));
+
         return std::shared_ptr<Pmap>(new CyclicPmap(*world_, rows, cols_, proc_rows_, proc_cols_));
       }
 
@@ -507,11 +623,17 @@ namespace TiledArray {
 
       /// Construct a cyclic process map where the column phase of the process
       /// matches that of this process grid.
+      /// When the process grid has more than one layer, the columns of the
+      /// process map are partitioned among the process layers.
       /// \param cols The number of columns in the process map
       /// \return Cyclic process map with matching column phase
       std::shared_ptr<Pmap> make_row_phase_pmap(const size_type cols) const {
         TA_ASSERT(world_);
 
+        if(proc_layers_ > 1u)
+          return std::shared_ptr<Pmap>(new LayeredCyclicPmap(*world_, rows_,
+              cols, proc_rows_, proc_cols_, proc_layers_, true));
+
         return std::shared_ptr<Pmap>(new CyclicPmap(*world_, rows_, cols, proc_rows_, proc_cols_));
       }
     }; // class Grid
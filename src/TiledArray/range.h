@@ -20,6 +20,7 @@
 #ifndef TILEDARRAY_RANGE_H__INCLUDED
 #define TILEDARRAY_RANGE_H__INCLUDED
 
+#include <TiledArray/fixed_rank.h>
 #include <TiledArray/range_iterator.h>
 #include <TiledArray/permutation.h>
 #include <TiledArray/size_array.h>
@@ -48,6 +49,9 @@ namespace TiledArray {
     typedef detail::RangeIterator<size_type, Range_> const_iterator; ///< Coordinate iterator
     friend class detail::RangeIterator<size_type, Range_>;
 
+    /// The maximum rank of ranges that store their data without heap allocation
+    static constexpr unsigned int max_inline_rank = 6u;
+
   protected:
 
     size_type* data_ = nullptr;
@@ -62,6 +66,60 @@ namespace TiledArray {
     size_type offset_ = 0ul; ///< Ordinal index offset correction
     size_type volume_ = 0ul; ///< Total number of elements
     unsigned int rank_ = 0u; ///< The rank (or number of dimensions) in the range
+    size_type inline_data_[max_inline_rank << 2]; ///< Storage for \c data_ when
+                      ///< <tt>rank_ <= max_inline_rank</tt>
+
+    /// Allocate the range data array
+
+    /// After this call \c data_ holds <tt>4*n</tt> uninitialized elements
+    /// and \c rank_ is equal to \c n . Ranges with a rank of
+    /// \c max_inline_rank or less use \c inline_data_ , so only ranges of a
+    /// higher rank allocate memory.
+    /// \param n The rank of the range
+    /// \throw std::bad_alloc When memory allocation fails.
+    void alloc_data(const unsigned int n) {
+      if(n != rank_) {
+        free_data();
+        if(n > max_inline_rank)
+          data_ = new size_type[n << 2];
+        else if(n > 0u)
+          data_ = inline_data_;
+        rank_ = n;
+      }
+    }
+
+    /// Free the range data array
+
+    /// \post \c data_ is \c nullptr and \c rank_ is zero
+    void free_data() {
+      if(data_ != inline_data_)
+        delete [] data_;
+      data_ = nullptr;
+      rank_ = 0u;
+    }
+
+    /// Take the data of another range
+
+    /// \pre This range has no data
+    /// \param other The range whose data is moved to this range
+    /// \post \c other is a rank zero range
+    void move_data(Range_& other) {
+      if(other.data_ == other.inline_data_) {
+        data_ = inline_data_;
+        std::memcpy(inline_data_, other.inline_data_,
+            (sizeof(size_type) << 2) * other.rank_);
+      } else {
+        data_ = other.data_;
+      }
+      offset_ = other.offset_;
+      volume_ = other.volume_;
+      rank_ = other.rank_;
+
+      other.data_ = nullptr;
+      other.offset_ = 0ul;
+      other.volume_ = 0ul;
+      other.rank_ = 0u;
+    }
 
   private:
 
@@ -215,8 +273,7 @@ namespace TiledArray {
       TA_ASSERT(n == detail::size(upper_bound));
       if(n) {
         // Initialize array memory
-        data_ = new size_type[n << 2];
-        rank_ = n;
+        alloc_data(n);
         init_range_data(lower_bound, upper_bound);
       }
     }
@@ -237,8 +294,7 @@ namespace TiledArray {
       TA_ASSERT(n == detail::size(upper_bound));
       if(n) {
         // Initialize array memory
-        data_ = new size_type[n << 2];
-        rank_ = n;
+        alloc_data(n);
         init_range_data(lower_bound, upper_bound);
       }
     }
@@ -256,8 +312,7 @@ namespace TiledArray {
       const size_type n = detail::size(extent);
       if(n) {
         // Initialize array memory
-        data_ = new size_type[n << 2];
-        rank_ = n;
+        alloc_data(n);
         init_range_data(extent);
       }
     }
@@ -272,8 +327,7 @@ namespace TiledArray {
       const size_type n = detail::size(extent);
       if(n) {
         // Initialize array memory
-        data_ = new size_type[n << 2];
-        rank_ = n;
+        alloc_data(n);
         init_range_data(extent);
       }
     }
@@ -296,27 +350,18 @@ namespace TiledArray {
     /// \throw std::bad_alloc When memory allocation fails.
     Range(const Range_& other) {
       if(other.rank_ > 0ul) {
-        data_ = new size_type[other.rank_ << 2];
+        alloc_data(other.rank_);
         offset_ = other.offset_;
         volume_ = other.volume_;
-        rank_ = other.rank_;
         memcpy(data_, other.data_, (sizeof(size_type) << 2) * other.rank_);
       }
     }
 
-    /// Copy Constructor
+    /// Move Constructor
 
-    /// \param other The range to be copied
-    /// \throw std::bad_alloc When memory allocation fails.
-    Range(Range_&& other) :
-      data_(other.data_), offset_(other.offset_), volume_(other.volume_),
-      rank_(other.rank_)
-    {
-      other.data_ = nullptr;
-      other.offset_ = 0ul;
-      other.volume_ = 0ul;
-      other.rank_ = 0u;
-    }
+    /// \param other The range to be moved
+    /// \throw nothing
+    Range(Range_&& other) { move_data(other); }
 
     /// Permuting copy constructor
 
@@ -327,8 +372,7 @@ namespace TiledArray {
       TA_ASSERT(perm.dim() == other.rank_);
 
       if(other.rank_ > 0ul) {
-        data_ = new size_type[other.rank_ << 2];
-        rank_ = other.rank_;
+        alloc_data(other.rank_);
 
         if(perm) {
           init_range_data(perm, other.data_, other.data_ + rank_);
@@ -342,7 +386,7 @@ namespace TiledArray {
     }
 
     /// Destructor
-    ~Range() { delete [] data_; }
+    ~Range() { free_data(); }
 
     /// Copy assignment operator
 
@@ -350,11 +394,7 @@ namespace TiledArray {
     /// \return A reference to this object
     /// \throw std::bad_alloc When memory allocation fails.
     Range_& operator=(const Range_& other) {
-      if(rank_ != other.rank_) {
-        delete [] data_;
-        data_ = (other.rank_ > 0ul ? new size_type[other.rank_ << 2] : nullptr);
-        rank_ = other.rank_;
-      }
+      alloc_data(other.rank_);
       memcpy(data_, other.data_, (sizeof(size_type) << 2) * rank_);
       offset_ = other.offset_;
       volume_ = other.volume_;
@@ -368,15 +408,10 @@ namespace TiledArray {
     /// \return A reference to this object
     /// \throw nothing
     Range_& operator=(Range_&& other) {
-      data_ = other.data_;
-      offset_ = other.offset_;
-      volume_ = other.volume_;
-      rank_ = other.rank_;
-
-      other.data_ = nullptr;
-      other.offset_ = 0ul;
-      other.volume_ = 0ul;
-      other.rank_ = 0u;
+      if(this != &other) {
+        free_data();
+        move_data(other);
+      }
 
       return *this;
     }
@@ -566,11 +601,7 @@ namespace TiledArray {
       TA_ASSERT(n == detail::size(upper_bound));
 
       // Reallocate memory for range arrays
-      if(rank_ != n) {
-        delete [] data_;
-        data_ = (n > 0ul ? new size_type[n << 2] : nullptr);
-        rank_ = n;
-      }
+      alloc_data(n);
       if(n > 0ul)
         init_range_data(lower_bound, upper_bound);
       else
@@ -675,7 +706,17 @@ namespace TiledArray {
         typename std::enable_if<(sizeof...(Index) > 1ul)>::type* = nullptr>
     size_type ordinal(const Index&... index) const {
       const size_type temp_index[sizeof...(Index)] = { static_cast<size_type>(index)... };
-      return ordinal(temp_index);
+      TA_ASSERT(sizeof...(Index) == rank_);
+      TA_ASSERT(includes(temp_index));
+
+      // The rank is known at compile time, so the loop is unrolled.
+      const size_type* restrict const stride = data_ + rank_ + rank_ + rank_;
+      size_type result = 0ul;
+      detail::rank_for<sizeof...(Index)>(rank_, [&] (const unsigned int i) {
+        result += temp_index[i] * stride[i];
+      });
+
+      return result - offset_;
     }
 
     /// calculate the coordinate index of the ordinal index, \c index.
@@ -735,11 +776,7 @@ namespace TiledArray {
 
       // Reallocate the array
       const unsigned int four_x_rank = rank << 2;
-      if(rank_ != rank) {
-        delete [] data_;
-        data_ = (rank > 0u ? new size_type[four_x_rank] : nullptr);
-        rank_ = rank;
-      }
+      alloc_data(rank);
 
       // Get range data
       ar & madness::archive::wrap(data_, four_x_rank) & offset_ & volume_;
@@ -752,11 +789,11 @@ namespace TiledArray {
     }
 
     void swap(Range_& other) {
-      // Get temp data
-      std::swap(data_, other.data_);
-      std::swap(offset_, other.offset_);
-      std::swap(volume_, other.volume_);
-      std::swap(rank_, other.rank_);
+      // Inline data cannot be exchanged by swapping pointers, so move the
+      // data through a temporary range.
+      Range_ temp(std::move(other));
+      other.move_data(*this);
+      move_data(temp);
     }
 
   private:
@@ -843,14 +880,17 @@ namespace TiledArray {
     TA_ASSERT(perm.dim() == rank_);
     if(rank_ > 1ul) {
       // Copy the lower and upper bound data into a temporary array
-      size_type* restrict const temp_lower = new size_type[rank_ << 1];
+      size_type temp_buffer[max_inline_rank << 1];
+      size_type* restrict const temp_lower = (rank_ > max_inline_rank ?
+          new size_type[rank_ << 1] : temp_buffer);
       const size_type* restrict const temp_upper = temp_lower + rank_;
       std::memcpy(temp_lower, data_, (sizeof(size_type) << 1) * rank_);
 
       init_range_data(perm, temp_lower, temp_upper);
 
       // Cleanup old memory.
-      delete[] temp_lower;
+      if(temp_lower != temp_buffer)
+        delete[] temp_lower;
     }
     return *this;
   }
@@ -0,0 +1,239 @@
+/*
+ *  This file is a part of TiledArray.
+ *  Copyright (C) 2016  Virginia Tech
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef TILEDARRAY_REDISTRIBUTOR_H__INCLUDED
+#define TILEDARRAY_REDISTRIBUTOR_H__INCLUDED
+
+#include <TiledArray/madness.h>
+#include <madness/world/buffer_archive.h>
+
+namespace TiledArray {
+  namespace detail {
+
+    /// Redistribute an \c Array object
+
+    /// This object moves the tiles of an array to an array with the same
+    /// tiled range and shape but a different process map. Each process
+    /// computes which of its local non-zero tiles are owned by each process
+    /// in the new map; tiles that remain on this process are moved without
+    /// communication. The remaining tiles are grouped by destination, with
+    /// destinations visited in the order <tt>rank + 1, rank + 2, ...</tt> so
+    /// processes do not send to the same destination at the same time, and
+    /// split into chunks of at most \c max_chunk_bytes bytes. At most
+    /// \c max_chunks_in_flight chunks of each process are in flight, and the
+    /// next chunk is sent when a destination acknowledges a chunk, so the
+    /// memory used by messages is bounded. Sent tiles are released by this
+    /// object.
+    /// \tparam A The array type
+    template <typename A>
+    class Redistributor : public madness::WorldObject<Redistributor<A> >, private madness::Spinlock {
+    private:
+      typedef Redistributor<A> Redistributor_; ///< This object type
+      typedef madness::WorldObject<Redistributor_> wobj_type; ///< The base object type
+      typedef typename A::size_type size_type; ///< Size type
+      typedef typename A::value_type value_type; ///< Tile type
+
+      /// The maximum size of a chunk message in bytes
+
+      /// A chunk contains at least one tile, so a tile that is larger than
+      /// this limit is sent in its own message.
+      static constexpr std::size_t max_chunk_bytes = 1048576ul;
+
+      /// The maximum number of unacknowledged chunks of this process
+      static constexpr std::size_t max_chunks_in_flight = 4ul;
+
+      /// A range of tiles that is sent to one process
+      struct Chunk {
+        ProcessID dest; ///< The destination process
+        std::size_t first; ///< The first tile of the chunk
+        std::size_t last; ///< One past the last tile of the chunk
+      }; // struct Chunk
+
+      A destination_; ///< The redistributed array
+      std::vector<ProcessID> owners_; ///< The new owner of each remote tile
+      std::vector<size_type> indices_; ///< Remote tile indices, grouped by owner
+      std::vector<Future<value_type> > data_; ///< Remote tiles, grouped by owner
+      std::vector<Chunk> chunks_; ///< Chunks in the order they are sent
+      std::size_t next_chunk_; ///< The next chunk to be sent
+      World& world_;
+
+      /// Task that will start sending when all remote tiles are ready
+      class DelaySend : public madness::TaskInterface {
+      private:
+        Redistributor_& parent_; ///< The parent redistributor operation
+
+      public:
+
+        /// Constructor
+        DelaySend(Redistributor_& parent) :
+          madness::TaskInterface(madness::TaskAttributes::hipri()),
+          parent_(parent)
+        {
+          typename std::vector<Future<value_type> >::iterator it =
+              parent_.data_.begin();
+          typename std::vector<Future<value_type> >::iterator end =
+              parent_.data_.end();
+          for(; it != end; ++it) {
+            if(! it->probe()) {
+              madness::DependencyInterface::inc();
+              it->register_callback(this);
+            }
+          }
+        }
+
+        /// Virtual destructor
+        virtual ~DelaySend() { }
+
+        /// Task send task function
+        virtual void run(const madness::TaskThreadEnv&) { parent_.send(); }
+
+      }; // class DelaySend
+
+      /// Partition the remote tiles into chunks and send the first chunks
+      void send() {
+        std::size_t first = 0ul;
+        std::size_t chunk_bytes = 0ul;
+        for(std::size_t i = 0ul; i < data_.size(); ++i) {
+          madness::archive::BufferOutputArchive count;
+          count & data_[i].get();
+          if((i > first) && ((owners_[i] != owners_[first]) ||
+              (chunk_bytes + count.size() > max_chunk_bytes)))
+          {
+            chunks_.push_back(Chunk{ owners_[first], first, i });
+            first = i;
+            chunk_bytes = 0ul;
+          }
+          chunk_bytes += count.size();
+        }
+        if(first < data_.size())
+          chunks_.push_back(Chunk{ owners_[first], first, data_.size() });
+
+        // Start the pipeline
+        std::size_t nchunks = 0ul;
+        {
+          madness::ScopedMutex<madness::Spinlock> locker(this);
+          next_chunk_ = (chunks_.size() < max_chunks_in_flight ?
+              chunks_.size() : max_chunks_in_flight);
+          nchunks = next_chunk_;
+        }
+        for(std::size_t c = 0ul; c < nchunks; ++c)
+          send_chunk(c);
+      }
+
+      /// Send a chunk to its destination and release its tiles
+
+      /// \param c The chunk to be sent
+      void send_chunk(const std::size_t c) {
+        const Chunk& chunk = chunks_[c];
+        std::vector<size_type> indices(indices_.begin() + chunk.first,
+            indices_.begin() + chunk.last);
+        std::vector<value_type> tiles;
+        tiles.reserve(indices.size());
+        for(std::size_t i = chunk.first; i < chunk.last; ++i) {
+          tiles.push_back(data_[i].get());
+          data_[i] = Future<value_type>();
+        }
+
+        wobj_type::task(chunk.dest, & Redistributor_::receive_handler,
+            world_.rank(), indices, tiles, madness::TaskAttributes::hipri());
+      }
+
+      /// Store the tiles of a chunk and acknowledge it
+
+      /// \param source The process that sent the chunk
+      /// \param indices The tile indices of the chunk
+      /// \param tiles The tiles of the chunk
+      void receive_handler(const ProcessID source,
+          const std::vector<size_type>& indices,
+          const std::vector<value_type>& tiles)
+      {
+        for(std::size_t i = 0ul; i < indices.size(); ++i)
+          destination_.set(indices[i], tiles[i]);
+
+        wobj_type::task(source, & Redistributor_::ack_handler,
+            madness::TaskAttributes::hipri());
+      }
+
+      /// Send the next chunk when a chunk has been received
+      void ack_handler() {
+        std::size_t c = 0ul;
+        {
+          madness::ScopedMutex<madness::Spinlock> locker(this);
+          if(next_chunk_ == chunks_.size())
+            return;
+          c = next_chunk_++;
+        }
+        send_chunk(c);
+      }
+
+    public:
+
+      /// Constructor
+
+      /// \param source The array to be redistributed
+      /// \param destination An array with the tiled range and shape of
+      /// \c source , which has not been assigned any tiles
+      Redistributor(const A& source, const A destination) :
+        wobj_type(source.world()), madness::Spinlock(),
+        destination_(destination), owners_(), indices_(), data_(), chunks_(),
+        next_chunk_(0ul), world_(source.world())
+      {
+        const ProcessID rank = world_.rank();
+        const ProcessID nproc = world_.size();
+        const bool replicated = source.pmap()->is_replicated();
+
+        // Sort the local non-zero tiles by their new owner
+        std::vector<std::vector<size_type> > send_lists(nproc);
+        typename A::pmap_interface::const_iterator end = source.pmap()->end();
+        typename A::pmap_interface::const_iterator it = source.pmap()->begin();
+        for(; it != end; ++it) {
+          if(source.is_zero(*it))
+            continue;
+
+          const ProcessID owner = destination_.owner(*it);
+          if(owner == rank)
+            destination_.set(*it, source.find(*it));
+          else if(! replicated)
+            // Tiles of replicated arrays are set by their new owner
+            send_lists[owner].push_back(*it);
+        }
+
+        for(ProcessID p = 1; p < nproc; ++p) {
+          const ProcessID owner = (rank + p) % nproc;
+          for(const size_type index : send_lists[owner]) {
+            owners_.push_back(owner);
+            indices_.push_back(index);
+            data_.push_back(source.find(index));
+          }
+        }
+
+        // Send the tiles to the other processes when they are ready
+        world_.taskq.add(new DelaySend(*this));
+
+        // Process any pending messages
+        wobj_type::process_pending();
+      }
+
+    }; // class Redistributor
+
+  }  // namespace detail
+}  // namespace TiledArray
+
+
+#endif // TILEDARRAY_REDISTRIBUTOR_H__INCLUDED
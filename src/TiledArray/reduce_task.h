@@ -41,6 +41,73 @@ namespace TiledArray {
       typedef std::pair<Future<T>, Future<U> > type;
     }; // struct ArgumentHelper
 
+    /// Reduce a batch of arguments with a batched reduction operation
+
+    /// \tparam Op The reduction operation type
+    /// \tparam Result The reduction result type
+    /// \tparam Arg The reduction argument type
+    /// \param op The reduction operation
+    /// \param result The reduction target
+    /// \param args The arguments to be reduced
+    template <typename Op, typename Result, typename Arg>
+    inline auto reduce_batch(Op& op, Result& result,
+        const std::vector<const Arg*>& args, int) -> decltype(op(result, args), void())
+    { op(result, args); }
+
+    /// Reduce a batch of arguments one at a time
+
+    /// This overload is used when \c Op does not support batched reductions.
+    /// \tparam Op The reduction operation type
+    /// \tparam Result The reduction result type
+    /// \tparam Arg The reduction argument type
+    /// \param op The reduction operation
+    /// \param result The reduction target
+    /// \param args The arguments to be reduced
+    template <typename Op, typename Result, typename Arg>
+    inline void reduce_batch(Op& op, Result& result,
+        const std::vector<const Arg*>& args, long)
+    {
+      for(const Arg* arg : args)
+        op(result, *arg);
+    }
+
+    /// Reduce a batch of argument pairs with a batched reduction operation
+
+    /// \tparam Op The pair reduction operation type
+    /// \tparam Result The reduction result type
+    /// \tparam Left The left-hand argument type
+    /// \tparam Right The right-hand argument type
+    /// \param op The pair reduction operation
+    /// \param result The reduction target
+    /// \param left The left-hand arguments to be reduced
+    /// \param right The right-hand arguments to be reduced
+    template <typename Op, typename Result, typename Left, typename Right>
+    inline auto reduce_pair_batch(const Op& op, Result& result,
+        const std::vector<const Left*>& left,
+        const std::vector<const Right*>& right, int) ->
+        decltype(op(result, left, right), void())
+    { op(result, left, right); }
+
+    /// Reduce a batch of argument pairs one pair at a time
+
+    /// This overload is used when \c Op does not support batched reductions.
+    /// \tparam Op The pair reduction operation type
+    /// \tparam Result The reduction result type
+    /// \tparam Left The left-hand argument type
+    /// \tparam Right The right-hand argument type
+    /// \param op The pair reduction operation
+    /// \param result The reduction target
+    /// \param left The left-hand arguments to be reduced
+    /// \param right The right-hand arguments to be reduced
+    template <typename Op, typename Result, typename Left, typename Right>
+    inline void reduce_pair_batch(const Op& op, Result& result,
+        const std::vector<const Left*>& left,
+        const std::vector<const Right*>& right, long)
+    {
+      for(std::size_t i = 0ul; i < left.size(); ++i)
+        op(result, *left[i], *right[i]);
+    }
+
     /// Wrapper that to convert a pair-wise reduction into a standard reduction
 
     /// \tparam opT The pair-wise reduction operation to be reduced
@@ -111,6 +178,26 @@ namespace TiledArray {
         op_(result, arg.first, arg.second);
       }
 
+      /// Reduce a batch of argument pairs
+
+      /// All pairs are passed to the pair reduction operation together, when
+      /// it supports batched reductions (e.g. a contraction that coalesces
+      /// the pairs into one GEMM), otherwise the pairs are reduced one at a
+      /// time.
+      /// \param[out] result The object that will hold the result of this reduction
+      /// \param[in] args The argument pairs to be reduced
+      void operator()(result_type& result, const std::vector<const argument_type*>& args) const {
+        std::vector<const first_argument_type*> left;
+        std::vector<const second_argument_type*> right;
+        left.reserve(args.size());
+        right.reserve(args.size());
+        for(const argument_type* arg : args) {
+          left.push_back(& arg->first.get());
+          right.push_back(& arg->second.get());
+        }
+        reduce_pair_batch(op_, result, left, right, 0);
+      }
+
     }; // class ReducePairOpWrapper
 
 
@@ -125,7 +212,10 @@ namespace TiledArray {
     /// order. This is much faster than a simple binary tree reduction since the
     /// reduction tasks do not have to wait for specific pairs of data. Though
     /// data that is not stored in a future can be used, it may not be the best
-    /// choice in that case.
+    /// choice in that case. Arguments that become ready while a reduction is
+    /// in progress are collected and reduced together, in one call to the
+    /// reduction operation, if it provides the optional batched reduction
+    /// function (see below).
     ///
     /// The reduction operation must have the following form:
     /// \code
@@ -153,6 +243,10 @@ namespace TiledArray {
     ///     // Reduce an argument
     ///     void operator()(result_type&, const argument_type&) const;
     ///
+    ///     // Reduce a batch of arguments (optional)
+    ///     void operator()(result_type&,
+    ///         const std::vector<const argument_type*>&) const;
+    ///
     /// }; // struct ReductionOp
     /// \endcode
     ///
@@ -217,6 +311,7 @@ namespace TiledArray {
           typename ArgumentHelper<argument_type>::type arg_; ///< The reduction argument
           madness::CallbackInterface* callback_; ///< Reduction callback
           madness::AtomicInt count_; ///< Dependency counter
+          ReduceObject* next_; ///< The next object in the ready list
 
           /// Register a future as a dependency
 
@@ -258,7 +353,7 @@ namespace TiledArray {
           /// \param callback The callback to invoke when this argument has been reduced
           template <typename Arg>
           ReduceObject(ReduceTaskImpl* parent, const Arg& arg, madness::CallbackInterface* callback) :
-          parent_(parent), arg_(arg), callback_(callback)
+          parent_(parent), arg_(arg), callback_(callback), next_(nullptr)
           {
             MADNESS_ASSERT(parent_);
             register_callbacks(arg_);
@@ -274,6 +369,16 @@ namespace TiledArray {
           /// \return A const reference to the reduction argument
           const argument_type& arg() const { return arg_; }
 
+          /// Ready list link accessor
+
+          /// \return The next object in the ready list
+          ReduceObject* next() const { return next_; }
+
+          /// Set the ready list link
+
+          /// \param next The next object in the ready list
+          void next(ReduceObject* next) { next_ = next; }
+
           /// Destroy the \c object
 
           /// This function will invoke the callback and delete object.
@@ -301,18 +406,18 @@ namespace TiledArray {
         void reduce(std::shared_ptr<result_type>& result) {
           while(result) {
             lock_.lock(); // <<< Begin critical section
-            if(ready_object_) {
-              // Get the ready argument
-              ReduceObject* ready_object = const_cast<ReduceObject*>(ready_object_);
-              ready_object_ = nullptr;
+            if(ready_objects_) {
+              // Get the ready arguments, which includes a partial batch that
+              // was waiting for this result object
+              ReduceObject* ready_objects = ready_objects_;
+              ready_objects_ = nullptr;
+              ready_count_ = 0ul;
               lock_.unlock(); // <<< End critical section
 
-              // Reduce the argument that was held by ready_object_
-              op_(*result, ready_object->arg());
-
-              // cleanup the argument
-              ReduceObject::destroy(ready_object);
-              this->dec();
+              // Reduce the arguments that were held by ready_objects_
+              const std::size_t n = reduce_objects(*result, ready_objects);
+              for(std::size_t i = 0ul; i < n; ++i)
+                this->dec();
             } else if(ready_result_) {
               // Get the ready result
               std::shared_ptr<result_type> ready_result = ready_result_;
@@ -352,32 +457,55 @@ namespace TiledArray {
           this->dec();
         }
 
-        /// Reduce two reduction arguments
-        void reduce_object_object(const ReduceObject* object1, const ReduceObject* object2) {
-          // Construct an empty result object
-          std::shared_ptr<result_type> result(new result_type(op_()));
+        /// Reduce and destroy a list of reduction arguments
 
-          // Reduce the two arguments
-          op_(*result, object1->arg());
-          op_(*result, object2->arg());
+        /// \param result The target of the reduction
+        /// \param objects The first object in the list of arguments
+        /// \return The number of arguments reduced
+        std::size_t reduce_objects(result_type& result, ReduceObject* objects) {
+          // Collect the arguments
+          std::vector<const argument_type*> args;
+          for(ReduceObject* object = objects; object; object = object->next())
+            args.push_back(& object->arg());
+
+          // Reduce the arguments
+          if(args.size() == 1ul)
+            op_(result, *args.front());
+          else
+            reduce_batch(op_, result, args, 0);
 
           // Cleanup arguments
-          ReduceObject::destroy(object1);
-          ReduceObject::destroy(object2);
+          while(objects) {
+            ReduceObject* const next = objects->next();
+            ReduceObject::destroy(objects);
+            objects = next;
+          }
+
+          return args.size();
+        }
+
+        /// Reduce a list of reduction arguments
+        void reduce_object_list(ReduceObject* objects) {
+          // Construct an empty result object
+          std::shared_ptr<result_type> result(new result_type(op_()));
+
+          // Reduce the arguments
+          const std::size_t n = reduce_objects(*result, objects);
 
           // Check for more reductions
           reduce(result);
 
-          // Decrement the dependency counter for the two arguments. This
+          // Decrement the dependency counter for the arguments. This
           // must be done after the reduce call to avoid a race condition.
-          this->dec();
-          this->dec();
+          for(std::size_t i = 0ul; i < n; ++i)
+            this->dec();
         }
 
         World& world_; ///< The world that owns this task
         opT op_; ///< The reduction operation
         std::shared_ptr<result_type> ready_result_; ///< Result object that is ready to be reduced
-        volatile ReduceObject* ready_object_; ///< Reduction argument that is ready to be reduced
+        ReduceObject* ready_objects_; ///< List of reduction arguments that are ready to be reduced
+        std::size_t ready_count_; ///< The number of objects in the ready list
         Future<result_type> result_; ///< The result of the reduction task
         madness::Spinlock lock_; ///< Task lock
         madness::CallbackInterface* callback_; ///< The completion callback
@@ -393,7 +521,8 @@ namespace TiledArray {
         ReduceTaskImpl(World& world, opT op, madness::CallbackInterface* callback) :
           madness::TaskInterface(1, TaskAttributes::hipri()),
           world_(world), op_(op), ready_result_(new result_type(op())),
-          ready_object_(nullptr), result_(), lock_(), callback_(callback)
+          ready_objects_(nullptr), ready_count_(0ul), result_(), lock_(),
+          callback_(callback)
         { }
 
         virtual ~ReduceTaskImpl() { }
@@ -408,9 +537,12 @@ namespace TiledArray {
 
         /// Callback function invoked by \c ReductionObject
 
-        /// This function will place \c object in the ready state. If
-        /// another object is already in the ready state, then both objects
-        /// are used to spawn a task
+        /// This function will place \c object in the ready state. If a
+        /// result object is ready, it is used to spawn a task that reduces
+        /// \c object . Otherwise, \c object is added to the list of ready
+        /// objects, which are reduced together by the task that holds the
+        /// result object. When the list is full, a new task is spawned to
+        /// reduce the objects in the list.
         /// \param object The reduction object that is ready to be reduced
         void ready(ReduceObject* object) {
           MADNESS_ASSERT(object);
@@ -422,15 +554,17 @@ namespace TiledArray {
             MADNESS_ASSERT(ready_result);
             world_.taskq.add(this, & ReduceTaskImpl::reduce_result_object,
                 ready_result, object, TaskAttributes::hipri());
-          } else if(ready_object_) {
-            ReduceObject* ready_object = const_cast<ReduceObject*>(ready_object_);
-            ready_object_ = nullptr;
+          } else if((ready_count_ + 1ul) >= max_batch_size) {
+            object->next(ready_objects_);
+            ready_objects_ = nullptr;
+            ready_count_ = 0ul;
             lock_.unlock(); // <<< End critical section
-            MADNESS_ASSERT(ready_object);
-            world_.taskq.add(this, & ReduceTaskImpl::reduce_object_object,
-                object, ready_object, TaskAttributes::hipri());
+            world_.taskq.add(this, & ReduceTaskImpl::reduce_object_list,
+                object, TaskAttributes::hipri());
           } else {
-            ready_object_ = object;
+            object->next(ready_objects_);
+            ready_objects_ = object;
+            ++ready_count_;
             lock_.unlock(); // <<< End critical section
           }
         }
@@ -453,6 +587,14 @@ namespace TiledArray {
 
     public:
 
+      /// The number of ready arguments that are reduced by a new task, when
+      /// no result object is available
+
+      /// Fewer ready arguments wait for a result object, and they are reduced
+      /// together when it is returned. A small batch keeps independent
+      /// reductions running in parallel while the result object is busy.
+      static constexpr std::size_t max_batch_size = 4ul;
+
       /// Default constructor
       ReduceTask() : pimpl_(nullptr), count_(0ul) { }
 
@@ -548,6 +690,9 @@ namespace TiledArray {
 
     }; // class ReduceTask
 
+    template <typename opT>
+    constexpr std::size_t ReduceTask<opT>::max_batch_size;
+
 
 
     /// Reduce pair task
@@ -21,6 +21,7 @@
 #define TILEDARRAY_REPLICATOR_H__INCLUDED
 
 #include <TiledArray/madness.h>
+#include <madness/world/buffer_archive.h>
 
 namespace TiledArray {
   namespace detail {
@@ -28,7 +29,11 @@ namespace TiledArray {
     /// Replicate a \c Array object
 
     /// This object will create a replicated \c Array from a distributed
-    /// \c Array.
+    /// \c Array. The local tiles of each process are broadcast to all other
+    /// processes with a binomial tree that is rooted at the owning process,
+    /// so the data of all processes is replicated concurrently in
+    /// <tt>O(log P)</tt> steps. Large tile sets are split into chunks that
+    /// are forwarded as soon as they arrive, which pipelines the broadcast.
     /// \tparam A The array type
     /// Homeworld = M7R-227
     template <typename A>
@@ -37,11 +42,14 @@ namespace TiledArray {
       typedef Replicator<A> Replicator_; ///< This object type
       typedef madness::WorldObject<Replicator_> wobj_type; ///< The base object type
       typedef std::stack<madness::CallbackInterface*, std::vector<madness::CallbackInterface*> > callback_type; ///< Callback interface
+      typedef typename A::size_type size_type; ///< Size type
+      typedef typename A::value_type value_type; ///< Tile type
 
       A destination_; ///< The replicated array
-      std::vector<typename A::size_type> indices_; ///< List of local tile indices
-      std::vector<Future<typename A::value_type> > data_; ///< List of local tiles
-      madness::AtomicInt sent_; ///< The number of nodes the data has been sent to
+      std::vector<size_type> indices_; ///< List of local tile indices
+      std::vector<Future<value_type> > data_; ///< List of local tiles
+      std::vector<std::size_t> chunks_; ///< The number of chunks received from each process
+      ProcessID complete_; ///< The number of processes whose data is complete on this process
       World& world_;
       volatile callback_type callbacks_; ///< A callback stack
       volatile mutable bool probe_; ///< Cache for local data probe
@@ -67,9 +75,9 @@ namespace TiledArray {
           madness::TaskInterface(madness::TaskAttributes::hipri()),
           parent_(parent)
         {
-          typename std::vector<Future<typename A::value_type> >::iterator it =
+          typename std::vector<Future<value_type> >::iterator it =
               parent_.data_.begin();
-          typename std::vector<Future<typename A::value_type> >::iterator end =
+          typename std::vector<Future<value_type> >::iterator end =
               parent_.data_.end();
           for(; it != end; ++it) {
             if(! it->probe()) {
@@ -94,9 +102,9 @@ namespace TiledArray {
         madness::ScopedMutex<madness::Spinlock> locker(this);
 
         if(! probe_) {
-          typename std::vector<Future<typename A::value_type> >::const_iterator it =
+          typename std::vector<Future<value_type> >::const_iterator it =
               data_.begin();
-          typename std::vector<Future<typename A::value_type> >::const_iterator end =
+          typename std::vector<Future<value_type> >::const_iterator end =
               data_.end();
           for(; it != end; ++it)
             if(! it->probe())
@@ -108,11 +116,11 @@ namespace TiledArray {
         return probe_;
       }
 
-      /// Send data to the next node when it is ready
+      /// Send local data when it is ready
       void delay_send() {
         if(probe()) {
           // The data is ready so send it now.
-          send(); // Replication is done
+          send();
         } else {
           // The local data is not ready to be sent, so create a task that will
           // send it when it is ready.
@@ -121,43 +129,114 @@ namespace TiledArray {
         }
       }
 
-      /// Send all local data to the next node
+      /// Record that the data of one process is complete on this process
+      void complete() {
+        madness::ScopedMutex<madness::Spinlock> locker(this);
+        if(++complete_ == world_.size())
+          do_callbacks(); // Replication is done
+      }
+
+      /// Send a chunk to the children of this process in the broadcast tree
+
+      /// In the binomial tree of \c root , the children of the process with
+      /// relative rank \c r are <tt>r + m</tt> for every power of two
+      /// <tt>m > r</tt>. Children with the largest subtrees are sent the
+      /// chunk first.
+      /// \param root The process that owns the chunk
+      /// \param nchunks The number of chunks of \c root
+      /// \param indices The tile indices of the chunk
+      /// \param tiles The tiles of the chunk
+      void forward(const ProcessID root, const std::size_t nchunks,
+          const std::vector<size_type>& indices,
+          const std::vector<value_type>& tiles)
+      {
+        const ProcessID nproc = world_.size();
+        const ProcessID rank = (world_.rank() - root + nproc) % nproc;
+
+        ProcessID m = 1;
+        while(m < nproc)
+          m <<= 1;
+        for(m >>= 1; m > rank; m >>= 1) {
+          const ProcessID child = rank + m;
+          if(child < nproc)
+            wobj_type::task((child + root) % nproc, & Replicator_::forward_handler,
+                root, nchunks, indices, tiles, madness::TaskAttributes::hipri());
+        }
+      }
+
+      /// Send all local data to the other processes
+
+      /// The local tiles are partitioned into chunks of at most
+      /// \c max_chunk_bytes bytes, which are broadcast independently.
       void send() {
-        const long sent = ++sent_;
-        const ProcessID dest = (world_.rank() + sent) % world_.size();
+        // Partition the local tiles into chunks
+        std::vector<std::size_t> chunk_first(1ul, 0ul);
+        std::size_t chunk_bytes = 0ul;
+        for(std::size_t i = 0ul; i < data_.size(); ++i) {
+          madness::archive::BufferOutputArchive count;
+          count & data_[i].get();
+          if((chunk_bytes + count.size() > max_chunk_bytes) && (i > chunk_first.back())) {
+            chunk_first.push_back(i);
+            chunk_bytes = 0ul;
+          }
+          chunk_bytes += count.size();
+        }
+        chunk_first.push_back(data_.size());
+
+        // Broadcast the chunks. Processes without local tiles send one empty
+        // chunk so that the other processes can detect completion.
+        const std::size_t nchunks = chunk_first.size() - 1ul;
+        for(std::size_t c = 0ul; c < nchunks; ++c) {
+          std::vector<size_type> indices(indices_.begin() + chunk_first[c],
+              indices_.begin() + chunk_first[c + 1ul]);
+          std::vector<value_type> tiles;
+          tiles.reserve(indices.size());
+          for(std::size_t i = chunk_first[c]; i < chunk_first[c + 1ul]; ++i)
+            tiles.push_back(data_[i].get());
+          forward(world_.rank(), nchunks, indices, tiles);
+        }
 
-        if(dest != world_.rank()) {
-          wobj_type::task(dest, &  Replicator_::send_handler, indices_, data_,
-              madness::TaskAttributes::hipri());
-        } else
-          do_callbacks(); // Replication is done
+        complete();
       }
 
-      void send_handler(const std::vector<typename A::size_type>& indices,
-          const std::vector<Future<typename A::value_type> >& data)
+      /// Receive a chunk and forward it to the children of this process
+
+      /// \param root The process that owns the chunk
+      /// \param nchunks The number of chunks of \c root
+      /// \param indices The tile indices of the chunk
+      /// \param tiles The tiles of the chunk
+      void forward_handler(const ProcessID root, const std::size_t nchunks,
+          const std::vector<size_type>& indices,
+          const std::vector<value_type>& tiles)
       {
-        typename std::vector<typename A::size_type>::const_iterator index_it =
-            indices.begin();
-        typename std::vector<Future<typename A::value_type> >::const_iterator data_it =
-            data.begin();
-        typename std::vector<Future<typename A::value_type> >::const_iterator data_end =
-            data.end();
+        forward(root, nchunks, indices, tiles);
 
-        for(; data_it != data_end; ++data_it, ++index_it)
-          destination_.set(*index_it, data_it->get());
+        for(std::size_t i = 0ul; i < indices.size(); ++i)
+          destination_.set(indices[i], tiles[i]);
 
-        delay_send();
+        bool root_complete = false;
+        {
+          madness::ScopedMutex<madness::Spinlock> locker(this);
+          root_complete = (++chunks_[root] == nchunks);
+        }
+        if(root_complete)
+          complete();
       }
 
     public:
 
+      /// The maximum size of a chunk message in bytes
+
+      /// A chunk contains at least one tile, so a tile that is larger than
+      /// this limit is sent in its own message.
+      static constexpr std::size_t max_chunk_bytes = 1048576ul;
+
       Replicator(const A& source, const A destination) :
         wobj_type(source.world()), madness::Spinlock(),
-        destination_(destination), indices_(), data_(), sent_(),
+        destination_(destination), indices_(), data_(),
+        chunks_(source.world().size(), 0ul), complete_(0),
         world_(source.world()), callbacks_(), probe_(false)
       {
-        sent_ = 0;
-
         // Generate a list of local tiles from other.
         typename A::pmap_interface::const_iterator end = source.pmap()->end();
         typename A::pmap_interface::const_iterator it = source.pmap()->begin();
@@ -180,7 +259,7 @@ namespace TiledArray {
             }
         }
 
-        /// Send the data to the first node
+        /// Send the data to the other nodes
         delay_send();
 
         // Process any pending messages
@@ -189,22 +268,23 @@ namespace TiledArray {
 
       /// Check that the replication is complete
 
-      /// \return \c true when all data has been transfered.
+      /// \return \c true when the local data has been sent and the data of
+      /// all other processes has been received.
       bool done() {
         madness::ScopedMutex<madness::Spinlock> locker(this);
-        return sent_ == world_.size();
+        return complete_ == world_.size();
       }
 
 
       /// Add a callback
 
-      /// The callback is called when the the local data has been sent to all
-      /// nodes. If the data has already been sent to all nodes, the callback
-      /// is notified immediately.
+      /// The callback is called when the local data has been sent and the
+      /// data of all other processes has been received. If replication is
+      /// already complete, the callback is notified immediately.
       /// \param callback The callback object
       void register_callback(madness::CallbackInterface* callback) {
           madness::ScopedMutex<madness::Spinlock> locker(this);
-          if(sent_ == world_.size())
+          if(complete_ == world_.size())
             callback->notify();
           else
             const_cast<callback_type&>(callbacks_).push(callback);
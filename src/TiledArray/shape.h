@@ -21,6 +21,7 @@
 #define TILEDARRAY_SHAPE_H__INCLUDED
 
 #include <TiledArray/sparse_shape.h>
+#include <TiledArray/compressed_sparse_shape.h>
 #include <TiledArray/dense_shape.h>
 
 namespace TiledArray {
@@ -33,6 +33,11 @@
 #include <TiledArray/tensor/tensor_interface.h>
 #include <typeinfo>
 
+#ifdef HAVE_INTEL_TBB
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+#endif // HAVE_INTEL_TBB
+
 namespace TiledArray {
 
   /// Arbitrary sparse shape
@@ -73,6 +78,7 @@ namespace TiledArray {
     std::shared_ptr<vector_type> size_vectors_; ///< Tile size information
     size_type zero_tile_count_; ///< Number of zero tiles
     static value_type threshold_; ///< The zero threshold
+    static float sparse_gemm_density_; ///< The sparse gemm crossover point
 
     template <typename Op>
     static vector_type
@@ -312,6 +318,23 @@ namespace TiledArray {
     /// \param thresh The new threshold
     static void threshold(const value_type thresh) { threshold_ = thresh; }
 
+    /// Sparse gemm crossover accessor
+
+    /// \return The largest product of the argument densities for which
+    /// \c gemm uses the sparse norm product
+    static float sparse_gemm_density() { return sparse_gemm_density_; }
+
+    /// Set the sparse gemm crossover point
+
+    /// \c gemm computes the norm product with sparse matrix kernels when the
+    /// product of the fractions of non-zero tiles in the arguments, i.e. the
+    /// expected fraction of non-zero tile products, is less than
+    /// \c density , and with a dense matrix multiply otherwise.
+    /// \param density The new crossover point
+    static void sparse_gemm_density(const float density) {
+      sparse_gemm_density_ = density;
+    }
+
     /// Tile norm accessor
 
     /// \tparam Index The index type
@@ -1023,25 +1046,36 @@ namespace TiledArray {
                 k_rank, [] (const vector_type& size_vector) -> const vector_type&
                 { return size_vector; });
 
-        // TODO: Make this faster. It can be done without using temporaries
-        // for the arguments, but requires a custom matrix multiply.
-
-        Tensor<value_type> left(tile_norms_.range());
-        const size_type mk = M * K;
-        auto left_op = [] (const value_type left, const value_type right)
-            { return left * right; };
-        for(size_type i = 0ul; i < mk; i += K)
-          math::vector_op(left_op, K, left.data() + i,
-              tile_norms_.data() + i, k_sizes.data());
-
-        Tensor<value_type> right(other.tile_norms_.range());
-        for(integer i = 0ul, k = 0; k < K; i += N, ++k) {
-          const value_type factor = k_sizes[k];
-          auto right_op = [=] (const value_type arg) { return arg * factor; };
-          math::vector_op(right_op, N, right.data() + i, other.tile_norms_.data() + i);
-        }
+        // Use the sparse product when few of the tile products are non-zero
+        const float density = (1.0f - sparsity()) * (1.0f - other.sparsity());
+        if(density < sparse_gemm_density_) {
+          // The sparse product reads the norms as row-major M x K and K x N
+          // matrices.
+          TA_ASSERT(gemm_helper.left_op() == madness::cblas::NoTrans);
+          TA_ASSERT(gemm_helper.right_op() == madness::cblas::NoTrans);
+          sparse_gemm(M, N, K, tile_norms_.data(), other.tile_norms_.data(),
+              k_sizes.data(), abs_factor, result_norms.data());
+        } else {
+          // TODO: Make this faster. It can be done without using temporaries
+          // for the arguments, but requires a custom matrix multiply.
+
+          Tensor<value_type> left(tile_norms_.range());
+          const size_type mk = M * K;
+          auto left_op = [] (const value_type left, const value_type right)
+              { return left * right; };
+          for(size_type i = 0ul; i < mk; i += K)
+            math::vector_op(left_op, K, left.data() + i,
+                tile_norms_.data() + i, k_sizes.data());
+
+          Tensor<value_type> right(other.tile_norms_.range());
+          for(integer i = 0ul, k = 0; k < K; i += N, ++k) {
+            const value_type factor = k_sizes[k];
+            auto right_op = [=] (const value_type arg) { return arg * factor; };
+            math::vector_op(right_op, N, right.data() + i, other.tile_norms_.data() + i);
+          }
 
-        result_norms = left.gemm(right, abs_factor, gemm_helper);
+          result_norms = left.gemm(right, abs_factor, gemm_helper);
+        }
 
         // Hard zero tiles that are below the zero threshold.
         result_norms.inplace_unary(
@@ -1081,6 +1115,71 @@ namespace TiledArray {
     }
 
   private:
+
+    /// Sparse norm matrix product
+
+    /// Compute <tt>result(m,n) = factor * sum_k left(m,k) * right(k,n) *
+    /// k_sizes[k]^2</tt>, where \c left , \c right , and \c result are
+    /// row-major matrices. Only products of non-zero norms are computed, so
+    /// the cost is proportional to the number of elements of the arguments
+    /// plus the number of non-zero products. The rows of \c result are
+    /// computed in parallel when Intel TBB is available.
+    /// Neither argument may be transposed.
+    /// \param M The number of rows of \c left and \c result
+    /// \param N The number of columns of \c right and \c result
+    /// \param K The number of columns of \c left and rows of \c right
+    /// \param left The left-hand norms
+    /// \param right The right-hand norms
+    /// \param k_sizes The number of elements in each inner tile
+    /// \param factor The scaling factor
+    /// \param[out] result The result norms, which must be zero on entry
+    static void sparse_gemm(const integer M, const integer N, const integer K,
+        const value_type* restrict const left, const value_type* restrict const right,
+        const value_type* restrict const k_sizes, const value_type factor,
+        value_type* restrict const result)
+    {
+      // Compress the rows of right, including the inner tile size
+      std::vector<size_type> right_rows(K + 1, 0ul);
+      std::vector<size_type> right_cols;
+      std::vector<value_type> right_norms;
+      for(integer k = 0; k < K; ++k) {
+        const value_type k_size = k_sizes[k];
+        const value_type* restrict const right_k = right + k * N;
+        for(integer n = 0; n < N; ++n) {
+          if(right_k[n] != value_type(0)) {
+            right_cols.push_back(n);
+            right_norms.push_back(right_k[n] * k_size);
+          }
+        }
+        right_rows[k + 1] = right_cols.size();
+      }
+
+      auto gemm_rows = [=,&right_rows,&right_cols,&right_norms]
+          (const size_type first, const size_type last)
+      {
+        for(size_type m = first; m < last; ++m) {
+          const value_type* restrict const left_m = left + m * K;
+          value_type* restrict const result_m = result + m * N;
+          for(integer k = 0; k < K; ++k) {
+            if(left_m[k] == value_type(0))
+              continue;
+            const value_type left_mk = left_m[k] * k_sizes[k] * factor;
+            for(size_type j = right_rows[k]; j < right_rows[k + 1]; ++j)
+              result_m[right_cols[j]] += left_mk * right_norms[j];
+          }
+        }
+      };
+
+#ifdef HAVE_INTEL_TBB
+      tbb::parallel_for(tbb::blocked_range<size_type>(0ul, M),
+          [&] (const tbb::blocked_range<size_type>& range) {
+            gemm_rows(range.begin(), range.end());
+          });
+#else
+      gemm_rows(0ul, M);
+#endif // HAVE_INTEL_TBB
+    }
+
     template <typename Factor>
     static value_type to_abs_factor(const Factor factor) {
       using std::abs;
@@ -1092,6 +1191,8 @@ namespace TiledArray {
   // Static member initialization
   template <typename T>
   typename SparseShape<T>::value_type SparseShape<T>::threshold_ = std::numeric_limits<T>::epsilon();
+  template <typename T>
+  float SparseShape<T>::sparse_gemm_density_ = 0.01f;
 
   /// Add the shape to an output stream
 
@@ -0,0 +1,145 @@
+/*
+ *  This file is a part of TiledArray.
+ *  Copyright (C) 2016  Virginia Tech
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef TILEDARRAY_SPILL_FILE_H__INCLUDED
+#define TILEDARRAY_SPILL_FILE_H__INCLUDED
+
+#include <TiledArray/error.h>
+#include <madness/world/buffer_archive.h>
+#include <atomic>
+#include <cerrno>
+#include <cstdlib>
+#include <string>
+#include <vector>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+namespace TiledArray {
+  namespace detail {
+
+    /// Append-only file of serialized objects
+
+    /// Objects are serialized into the file with \c write(), which returns
+    /// the region of the file that holds the object, and read back with a
+    /// memory map of that region. The file is removed from the file system
+    /// when it is created, so it is deleted when it is closed, even if the
+    /// program terminates abnormally. Regions are never reused, and \c write()
+    /// and \c read() may be called concurrently.
+    class SpillFile {
+    public:
+      /// A region of the file
+      struct Region {
+        std::size_t offset; ///< The position of the region in the file
+        std::size_t size; ///< The size of the region in bytes
+      }; // struct Region
+
+    private:
+      int fd_; ///< The file descriptor
+      std::atomic<std::size_t> end_; ///< The end of the last reserved region
+
+      // Not allowed
+      SpillFile(const SpillFile&);
+      SpillFile& operator=(const SpillFile&);
+
+    public:
+
+      /// Create a spill file
+
+      /// \param directory The directory where the file is created
+      /// \throw TiledArray::Exception When the file cannot be created
+      explicit SpillFile(const std::string& directory) : fd_(-1), end_(0ul) {
+        std::string path = directory + "/tiledarray_spill.XXXXXX";
+        std::vector<char> buffer(path.begin(), path.end());
+        buffer.push_back('\0');
+        fd_ = mkstemp(buffer.data());
+        if(fd_ == -1)
+          TA_EXCEPTION("Unable to create the spill file.");
+        unlink(buffer.data());
+      }
+
+      ~SpillFile() { close(fd_); }
+
+      /// Write an object to the file
+
+      /// \tparam T The object type
+      /// \param value The object to be written
+      /// \return The region of the file that holds \c value
+      /// \throw TiledArray::Exception When the object cannot be written
+      template <typename T>
+      Region write(const T& value) {
+        // Serialize the object
+        madness::archive::BufferOutputArchive count;
+        count & value;
+        std::vector<unsigned char> buffer(count.size());
+        madness::archive::BufferOutputArchive ar(buffer.data(), buffer.size());
+        ar & value;
+
+        // Write the object to a new region
+        const Region region = { end_.fetch_add(buffer.size()), buffer.size() };
+        std::size_t written = 0ul;
+        while(written < region.size) {
+          const ssize_t n = pwrite(fd_, buffer.data() + written,
+              region.size - written, region.offset + written);
+          if(n < 0) {
+            if(errno == EINTR)
+              continue;
+            TA_EXCEPTION("Unable to write to the spill file.");
+          }
+          written += n;
+        }
+
+        return region;
+      }
+
+      /// Read an object from the file
+
+      /// \tparam T The object type
+      /// \param region The region of the file that holds the object
+      /// \return The object
+      /// \throw TiledArray::Exception When the region cannot be mapped
+      template <typename T>
+      T read(const Region region) const {
+        if(region.size == 0ul)
+          return T();
+
+        // Map the pages that contain the region
+        const std::size_t page = sysconf(_SC_PAGESIZE);
+        const std::size_t first = region.offset - (region.offset % page);
+        const std::size_t length = region.offset + region.size - first;
+        void* const map = mmap(nullptr, length, PROT_READ, MAP_PRIVATE, fd_, first);
+        if(map == MAP_FAILED)
+          TA_EXCEPTION("Unable to map the spill file.");
+
+        T value;
+        madness::archive::BufferInputArchive ar(
+            static_cast<const unsigned char*>(map) + (region.offset - first),
+            region.size);
+        ar & value;
+        munmap(map, length);
+
+        return value;
+      }
+
+    }; // class SpillFile
+
+  }  // namespace detail
+}  // namespace TiledArray
+
+#endif // TILEDARRAY_SPILL_FILE_H__INCLUDED
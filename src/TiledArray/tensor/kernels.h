@@ -29,6 +29,13 @@
 #include <TiledArray/tensor/utility.h>
 #include <TiledArray/tensor/permute.h>
 #include <TiledArray/math/eigen.h>
+#include <TiledArray/math/vector_simd.h>
+#include <algorithm>
+
+#ifdef HAVE_INTEL_TBB
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_reduce.h>
+#endif // HAVE_INTEL_TBB
 
 namespace TiledArray {
 
@@ -132,6 +139,66 @@ namespace TiledArray {
       }
     }
 
+    /// Test for tensors that are evaluated with the explicit SIMD kernels
+
+    /// The tensors must be contiguous and have the same \c float or
+    /// \c double element type.
+    template <typename... Ts> struct is_simd_tensor;
+
+    template <typename T>
+    struct is_simd_tensor<T> :
+        public std::integral_constant<bool, is_contiguous_tensor<T>::value
+            && math::is_simd_type<typename T::value_type>::value>
+    { };
+
+    template <typename T1, typename T2, typename... Ts>
+    struct is_simd_tensor<T1, T2, Ts...> :
+        public std::integral_constant<bool, is_simd_tensor<T1>::value
+            && std::is_same<typename T1::value_type, typename T2::value_type>::value
+            && is_simd_tensor<T2, Ts...>::value>
+    { };
+
+    /// In-place tensor operations with an explicit SIMD kernel
+
+    /// This function evaluates \c simd_op(volume, result.data(),
+    /// tensors.data()...) .
+    /// \tparam SimdOp The vector operation type
+    /// \tparam Op The element-wise operation type
+    /// \tparam TR The result tensor type
+    /// \tparam Ts The argument tensor types
+    /// \param[in] simd_op The vector operation
+    /// \param[in,out] result The result tensor
+    /// \param[in] tensors The argument tensors
+    template <typename SimdOp, typename Op, typename TR, typename... Ts,
+        typename std::enable_if<is_simd_tensor<TR, Ts...>::value>::type* = nullptr>
+    inline void simd_inplace_tensor_op(SimdOp&& simd_op, Op&&, TR& result,
+        const Ts&... tensors)
+    {
+      TA_ASSERT(! empty(result, tensors...));
+      TA_ASSERT(is_range_set_congruent(result, tensors...));
+
+      simd_op(result.range().volume(), result.data(), tensors.data()...);
+    }
+
+    /// In-place tensor operations without an explicit SIMD kernel
+
+    /// This function evaluates \c inplace_tensor_op(op, result, tensors...) .
+    /// \tparam SimdOp The vector operation type
+    /// \tparam Op The element-wise operation type
+    /// \tparam TR The result tensor type
+    /// \tparam Ts The argument tensor types
+    /// \param[in] op The element-wise operation
+    /// \param[in,out] result The result tensor
+    /// \param[in] tensors The argument tensors
+    template <typename SimdOp, typename Op, typename TR, typename... Ts,
+        typename std::enable_if<is_tensor<TR, Ts...>::value
+            && ! is_simd_tensor<TR, Ts...>::value>::type* = nullptr>
+    inline void simd_inplace_tensor_op(SimdOp&&, Op&& op, TR& result,
+        const Ts&... tensors)
+    {
+      inplace_tensor_op(op, result, tensors...);
+    }
+
     /// In-place tensor permutation operations with contiguous data
 
     /// This function sets the elements of \c tensor1 with the result of
@@ -374,6 +441,58 @@ namespace TiledArray {
     }
 
 
+    /// Initialize tensor with a permuted copy of a tensor
+
+    /// Tensors of arithmetic elements with identical element types are copied
+    /// with \c permute_copy , which uses cache blocked SIMD transposes.
+    /// \pre The memory of \c result has been allocated but not initialized.
+    /// \tparam TR The result tensor type
+    /// \tparam T1 The argument tensor type
+    /// \param[in] perm The permutation that will be applied to tensor1
+    /// \param[out] result The result tensor
+    /// \param[in] tensor1 The argument tensor
+    template <typename TR, typename T1,
+        typename std::enable_if<is_tensor<TR, T1>::value
+               && is_contiguous_tensor<TR, T1>::value
+               && std::is_same<typename TR::value_type,
+                      typename T1::value_type>::value
+               && std::is_arithmetic<typename TR::value_type>::value>::type* = nullptr>
+    inline void tensor_copy_init(const Permutation& perm, TR& result,
+        const T1& tensor1)
+    {
+      TA_ASSERT(! empty(result, tensor1));
+      TA_ASSERT(is_range_set_congruent(perm, result, tensor1));
+      TA_ASSERT(perm);
+      TA_ASSERT(perm.dim() == result.range().rank());
+
+      permute_copy(result, perm, tensor1);
+    }
+
+    /// Initialize tensor with a permuted copy of a tensor
+
+    /// \pre The memory of \c result has been allocated but not initialized.
+    /// \tparam TR The result tensor type
+    /// \tparam T1 The argument tensor type
+    /// \param[in] perm The permutation that will be applied to tensor1
+    /// \param[out] result The result tensor
+    /// \param[in] tensor1 The argument tensor
+    template <typename TR, typename T1,
+        typename std::enable_if<! (is_tensor<TR, T1>::value
+               && is_contiguous_tensor<TR, T1>::value
+               && std::is_same<typename TR::value_type,
+                      typename T1::value_type>::value
+               && std::is_arithmetic<typename TR::value_type>::value)>::type* = nullptr>
+    inline void tensor_copy_init(const Permutation& perm, TR& result,
+        const T1& tensor1)
+    {
+      auto op =
+          [] (const numeric_t<T1> arg) -> numeric_t<T1>
+      { return arg; };
+
+      tensor_init(op, perm, result, tensor1);
+    }
+
+
     /// Initialize tensor of tensors with permuted tensor arguments
 
     /// This function initializes the elements of \c tensor1 with the result of
@@ -522,6 +641,60 @@ namespace TiledArray {
       return identity;
     }
 
+    /// Tensor reduction operation with an explicit SIMD kernel
+
+    /// \tparam SimdOp The vector reduction operation type
+    /// \tparam ReduceOp The element-wise reduction operation type
+    /// \tparam JoinOp The result operation type
+    /// \tparam Scalar A scalar type
+    /// \tparam T1 The first argument tensor type
+    /// \tparam Ts The argument tensor types
+    /// \param simd_op The vector reduction operation, which is evaluated as
+    /// \c simd_op(volume, tensor1.data(), tensors.data()...)
+    /// \param identity The initial value for the reduction and the result
+    /// \param tensor1 The first tensor to be reduced
+    /// \param tensors The other tensors to be reduced
+    /// \return The reduced value of the tensor(s)
+    template <typename SimdOp, typename ReduceOp, typename JoinOp, typename Scalar,
+        typename T1, typename... Ts,
+        typename std::enable_if<is_simd_tensor<T1, Ts...>::value>::type* = nullptr>
+    Scalar simd_tensor_reduce(SimdOp&& simd_op, ReduceOp&&, JoinOp&& join_op,
+        Scalar identity, const T1& tensor1, const Ts&... tensors)
+    {
+      TA_ASSERT(! empty(tensor1, tensors...));
+      TA_ASSERT(is_range_set_congruent(tensor1, tensors...));
+
+      join_op(identity, simd_op(tensor1.range().volume(), tensor1.data(),
+          tensors.data()...));
+
+      return identity;
+    }
+
+    /// Tensor reduction operation without an explicit SIMD kernel
+
+    /// This function evaluates
+    /// \c tensor_reduce(reduce_op, join_op, identity, tensor1, tensors...) .
+    /// \tparam SimdOp The vector reduction operation type
+    /// \tparam ReduceOp The element-wise reduction operation type
+    /// \tparam JoinOp The result operation type
+    /// \tparam Scalar A scalar type
+    /// \tparam T1 The first argument tensor type
+    /// \tparam Ts The argument tensor types
+    /// \param reduce_op The element-wise reduction operation
+    /// \param join_op The result join operation
+    /// \param identity The initial value for the reduction and the result
+    /// \param tensor1 The first tensor to be reduced
+    /// \param tensors The other tensors to be reduced
+    /// \return The reduced value of the tensor(s)
+    template <typename SimdOp, typename ReduceOp, typename JoinOp, typename Scalar,
+        typename T1, typename... Ts,
+        typename std::enable_if<! is_simd_tensor<T1, Ts...>::value>::type* = nullptr>
+    Scalar simd_tensor_reduce(SimdOp&&, ReduceOp&& reduce_op, JoinOp&& join_op,
+        Scalar identity, const T1& tensor1, const Ts&... tensors)
+    {
+      return tensor_reduce(reduce_op, join_op, identity, tensor1, tensors...);
+    }
+
     /// Tensor of tensor reduction operation for contiguous tensors
 
     /// Perform an element-wise reduction of the tensors.
@@ -581,19 +754,41 @@ namespace TiledArray {
       TA_ASSERT(! empty(tensor1, tensors...));
       TA_ASSERT(is_range_set_congruent(tensor1, tensors...));
 
-      const auto stride = inner_size(tensor1, tensors...);
-      const auto volume = tensor1.range().volume();
-
-      Scalar result = identity;
-      for(decltype(tensor1.range().volume()) i = 0ul; i < volume; i += stride) {
-        Scalar temp = identity;
-        math::reduce_op(reduce_op,join_op, identity, stride, temp,
-            tensor1.data() + tensor1.range().ordinal(i),
-            (tensors.data() + tensors.range().ordinal(i))...);
-        join_op(result, temp);
+      const std::size_t stride = inner_size(tensor1, tensors...);
+      const std::size_t volume = tensor1.range().volume();
+
+      // Reduce the contiguous blocks [first, last) of the tensors
+      auto reduce_blocks = [&] (const std::size_t first, const std::size_t last,
+          Scalar result) -> Scalar
+      {
+        for(std::size_t i = first * stride; i < last * stride; i += stride) {
+          Scalar temp = identity;
+          math::reduce_op_serial(reduce_op, stride, temp,
+              tensor1.data() + tensor1.range().ordinal(i),
+              (tensors.data() + tensors.range().ordinal(i))...);
+          join_op(result, temp);
+        }
+        return result;
+      };
+
+#ifdef HAVE_INTEL_TBB
+      // Large tensors are reduced in parallel, where each task reduces a
+      // range of blocks with at least reduce_op_min_volume / 2 elements.
+      if(volume >= math::reduce_op_min_volume) {
+        const std::size_t grain_size =
+            std::max<std::size_t>(math::reduce_op_min_volume / (2ul * stride), 1ul);
+        return tbb::parallel_reduce(
+            tbb::blocked_range<std::size_t>(0ul, volume / stride, grain_size),
+            identity,
+            [&] (const tbb::blocked_range<std::size_t>& range, Scalar result)
+                -> Scalar
+            { return reduce_blocks(range.begin(), range.end(), result); },
+            [&] (Scalar left, const Scalar right) -> Scalar
+            { join_op(left, right); return left; });
       }
+#endif // HAVE_INTEL_TBB
 
-      return result;
+      return reduce_blocks(0ul, volume / stride, identity);
     }
 
     /// Tensor of tensors reduction operation for non-contiguous tensors
@@ -646,6 +841,47 @@ namespace TiledArray {
       return identity;
     }
 
+    /// Pack a sequence of matrices along the inner (contracted) dimension
+
+    /// Tensor \c tensors[i] is treated as a row-major matrix with
+    /// \c k_sizes[i] inner elements and \c outer outer elements. The packed
+    /// result is a row-major matrix with <tt>sum_i k_sizes[i]</tt> inner
+    /// elements, where the inner elements of \c tensors[i] follow those of
+    /// <tt>tensors[i-1]</tt> .
+    /// \tparam T The tensor type
+    /// \tparam I The matrix size type
+    /// \tparam U The packed data element type
+    /// \param tensors The tensors to be packed
+    /// \param k_sizes The number of inner elements of each tensor
+    /// \param outer The number of outer elements of all tensors
+    /// \param k_fast If \c true , the inner dimension is the column (fast)
+    /// dimension of the matrices, otherwise it is the row dimension.
+    /// \param result A pointer to the packed data
+    template <typename T, typename I, typename U>
+    inline void pack_k(const std::vector<const T*>& tensors,
+        const I* restrict const k_sizes, const I outer, const bool k_fast,
+        U* restrict result)
+    {
+      const std::size_t n = tensors.size();
+      if(k_fast) {
+        // Interleave the rows of each matrix
+        for(I r = 0; r < outer; ++r) {
+          for(std::size_t i = 0ul; i < n; ++i) {
+            const I k_i = k_sizes[i];
+            math::copy_vector(k_i, tensors[i]->data() + r * k_i, result);
+            result += k_i;
+          }
+        }
+      } else {
+        // Concatenate the matrices
+        for(std::size_t i = 0ul; i < n; ++i) {
+          const I size = k_sizes[i] * outer;
+          math::copy_vector(size, tensors[i]->data(), result);
+          result += size;
+        }
+      }
+    }
+
   }  // namespace detail
 } // namespace TiledArray
 
@@ -28,6 +28,7 @@
 
 #include <TiledArray/perm_index.h>
 #include <TiledArray/math/transpose.h>
+#include <algorithm>
 
 namespace TiledArray {
   namespace detail {
@@ -204,6 +205,68 @@ namespace TiledArray {
     }
 
 
+    /// Construct a permuted tensor copy without element operations
+
+    /// This is equivalent to \c permute with identity input and output
+    /// operations, but the data is moved with block copies and with the cache
+    /// blocked, SIMD transpose kernel \c math::transpose_copy . The result
+    /// tensor must be allocated, and the element type must be trivially
+    /// copyable.
+    /// \tparam Result The result tensor type
+    /// \tparam Arg The argument tensor type
+    /// \param result The result tensor
+    /// \param perm The permutation that will be applied to the copy
+    /// \param arg The tensor to be permuted
+    template <typename Result, typename Arg>
+    inline void permute_copy(Result& result, const Permutation& perm,
+        const Arg& arg)
+    {
+      detail::PermIndex perm_index_op(arg.range(), perm);
+
+      // Cache constants
+      const unsigned int ndim = arg.range().rank();
+      const unsigned int ndim1 = ndim - 1;
+      const typename Result::size_type volume = arg.range().volume();
+
+      // Get pointer to arg extent
+      const auto* restrict const arg_extent = arg.range().extent_data();
+
+      if(perm[ndim1] == ndim1) {
+        // The last dimension is not permuted, so blocks are copied.
+        typename Result::size_type block_size = arg_extent[ndim1];
+        for(int i = int(ndim1) - 1 ; i >= 0; --i) {
+          if(int(perm[i]) != i)
+            break;
+          block_size *= arg_extent[i];
+        }
+
+        for(typename Result::size_type index = 0ul; index < volume; index += block_size)
+          std::copy(arg.data() + index, arg.data() + index + block_size,
+              result.data() + perm_index_op(index));
+
+      } else {
+        // Permute in terms of matrix transposes, see permute for details.
+        typename Result::size_type other_fused_size[4];
+        typename Result::size_type other_fused_weight[4];
+        fuse_dimensions(other_fused_size, other_fused_weight, arg_extent, perm);
+
+        const auto* restrict const result_extent = result.range().extent_data();
+        typename Result::size_type  result_outer_stride = 1ul;
+        for(unsigned int i = perm[ndim1] + 1u; i < ndim; ++i)
+          result_outer_stride *= result_extent[i];
+
+        for(typename Result::size_type i = 0ul; i < other_fused_size[0]; ++i) {
+          typename Result::size_type index = i * other_fused_weight[0];
+          for(typename Result::size_type j = 0ul; j < other_fused_size[2]; ++j, index += other_fused_weight[2]) {
+            math::transpose_copy(other_fused_size[1], other_fused_size[3],
+                result_outer_stride, result.data() + perm_index_op(index),
+                other_fused_weight[1], arg.data() + index);
+          }
+        }
+      }
+    }
+
+
   }  // namespace detail
 } // namespace TiledArray
 
@@ -0,0 +1,319 @@
+/*
+ *  This file is a part of TiledArray.
+ *  Copyright (C) 2016  Virginia Tech
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "pool_allocator.h"
+#include <TiledArray/config.h>
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <mutex>
+#include <vector>
+
+namespace TiledArray {
+  namespace pool {
+    namespace {
+
+      /// Block alignment
+      constexpr std::size_t alignment = TILEDARRAY_CACHELINE_SIZE;
+
+      /// The number of size classes; the largest class is 1.75 GiB
+      constexpr unsigned int num_classes = 100u;
+
+      /// The largest block that is held in a thread cache
+      constexpr std::size_t max_thread_block = 4194304ul; // 4 MiB
+
+      /// The maximum number of blocks of one size class in a thread cache
+      constexpr std::size_t max_thread_blocks = 8ul;
+
+      /// The maximum number of bytes held in a thread cache
+      constexpr std::size_t max_thread_bytes = 33554432ul; // 32 MiB
+
+      /// The size of a size class
+
+      /// Class \c c has size <tt>(4 + c % 4) * 2^(c / 4 + 4)</tt> bytes, so
+      /// the classes are 64, 80, 96, 112, 128, 160, ... bytes.
+      inline std::size_t class_size(const unsigned int c) {
+        return std::size_t(4u + (c & 3u)) << ((c >> 2) + 4u);
+      }
+
+      /// The smallest size class that holds \c bytes bytes
+      inline unsigned int size_class(const std::size_t bytes) {
+        if(bytes <= 64ul)
+          return 0u;
+
+        // e = floor(log2(bytes - 1)), which is at least 6
+        unsigned int e = 6u;
+        while(((bytes - 1ul) >> (e + 1u)) != 0ul)
+          ++e;
+
+        // Divide (2^e, 2^(e+1)] into four classes
+        const std::size_t unit = std::size_t(1) << (e - 2u);
+        const unsigned int sub = (bytes + unit - 1ul) / unit - 4ul;
+        return (sub == 4u ? 4u * (e - 5u) : 4u * (e - 6u) + sub);
+      }
+
+      void* system_allocate(const std::size_t bytes) {
+        void* p = nullptr;
+        if(posix_memalign(&p, alignment, bytes) != 0)
+          throw std::bad_alloc();
+        return p;
+      }
+
+      void system_deallocate(void* const p) { std::free(p); }
+
+      struct ThreadCache;
+
+      /// Shared pool state
+      struct Pool {
+        std::atomic<std::size_t> hits{0ul};
+        std::atomic<std::size_t> misses{0ul};
+        std::atomic<std::size_t> bytes_in_use{0ul};
+        std::atomic<std::size_t> high_water{0ul};
+        std::atomic<std::size_t> bytes_cached{0ul};
+        std::atomic<std::size_t> limit{1073741824ul}; // 1 GiB
+
+        std::mutex mutex[num_classes];
+        std::vector<void*> blocks[num_classes];
+
+        std::mutex caches_mutex; ///< Guards \c caches
+        std::vector<ThreadCache*> caches; ///< The caches of all threads
+
+        /// Take a cached block of class \c c
+        void* pop(const unsigned int c) {
+          std::lock_guard<std::mutex> lock(mutex[c]);
+          if(blocks[c].empty())
+            return nullptr;
+          void* const p = blocks[c].back();
+          blocks[c].pop_back();
+          bytes_cached -= class_size(c);
+          return p;
+        }
+
+        /// Cache or release a block of class \c c
+        void push(const unsigned int c, void* const p) {
+          const std::size_t size = class_size(c);
+          if((bytes_cached.fetch_add(size) + size) <= limit.load()) {
+            std::lock_guard<std::mutex> lock(mutex[c]);
+            blocks[c].push_back(p);
+          } else {
+            bytes_cached -= size;
+            system_deallocate(p);
+          }
+        }
+
+        /// Release all cached blocks
+        void trim() {
+          for(unsigned int c = 0u; c < num_classes; ++c) {
+            std::vector<void*> temp;
+            {
+              std::lock_guard<std::mutex> lock(mutex[c]);
+              temp.swap(blocks[c]);
+            }
+            bytes_cached -= temp.size() * class_size(c);
+            for(void* const p : temp)
+              system_deallocate(p);
+          }
+        }
+
+        void update_high_water(const std::size_t in_use) {
+          std::size_t current = high_water.load();
+          while((in_use > current) && ! high_water.compare_exchange_weak(current, in_use)) ;
+        }
+      }; // struct Pool
+
+      /// The shared pool
+
+      /// The pool is never destroyed, so blocks may be freed during static
+      /// destruction.
+      Pool& shared_pool() {
+        static Pool* const pool = new Pool();
+        return *pool;
+      }
+
+      /// Set when the cache of the calling thread has been destroyed
+      thread_local bool thread_cache_destroyed = false;
+
+      /// Per-thread block cache
+
+      /// Caches are registered with the shared pool so that \c trim() can
+      /// release the blocks cached by every thread. The cache mutex is only
+      /// contended while another thread trims the pool.
+      struct ThreadCache {
+        std::mutex mutex; ///< Guards the cached blocks
+        std::vector<void*> blocks[num_classes];
+        std::size_t bytes = 0ul;
+
+        ThreadCache() {
+          Pool& pool = shared_pool();
+          std::lock_guard<std::mutex> lock(pool.caches_mutex);
+          pool.caches.push_back(this);
+        }
+
+        ~ThreadCache() {
+          Pool& pool = shared_pool();
+          {
+            std::lock_guard<std::mutex> lock(pool.caches_mutex);
+            pool.caches.erase(std::find(pool.caches.begin(), pool.caches.end(), this));
+          }
+          flush();
+          thread_cache_destroyed = true;
+        }
+
+        /// Move all blocks to the shared pool (the cache mutex must be locked
+        /// by the caller, unless the cache is no longer registered)
+        void flush() {
+          Pool& pool = shared_pool();
+          for(unsigned int c = 0u; c < num_classes; ++c) {
+            const std::size_t size = class_size(c);
+            for(void* const p : blocks[c]) {
+              pool.bytes_cached -= size;
+              pool.push(c, p);
+            }
+            blocks[c].clear();
+          }
+          bytes = 0ul;
+        }
+      }; // struct ThreadCache
+
+      /// The cache of the calling thread
+
+      /// \return A pointer to the thread cache, or \c nullptr if it has
+      /// already been destroyed, i.e. during thread exit
+      ThreadCache* thread_cache() {
+        if(thread_cache_destroyed)
+          return nullptr;
+        static thread_local ThreadCache cache;
+        return &cache;
+      }
+
+    } // namespace
+
+    void* allocate(const std::size_t bytes) {
+      Pool& pool = shared_pool();
+
+      if(bytes > class_size(num_classes - 1u)) {
+        ++pool.misses;
+        pool.update_high_water(pool.bytes_in_use += bytes);
+        return system_allocate(bytes);
+      }
+
+      const unsigned int c = size_class(bytes);
+      const std::size_t size = class_size(c);
+
+      void* p = nullptr;
+      ThreadCache* const cache =
+          (size <= max_thread_block ? thread_cache() : nullptr);
+      if(cache) {
+        std::lock_guard<std::mutex> lock(cache->mutex);
+        if(! cache->blocks[c].empty()) {
+          p = cache->blocks[c].back();
+          cache->blocks[c].pop_back();
+          cache->bytes -= size;
+          pool.bytes_cached -= size;
+        }
+      }
+      if(! p)
+        p = pool.pop(c);
+
+      if(p) {
+        ++pool.hits;
+      } else {
+        ++pool.misses;
+        p = system_allocate(size);
+      }
+
+      pool.update_high_water(pool.bytes_in_use += size);
+      return p;
+    }
+
+    void deallocate(void* const p, const std::size_t bytes) {
+      if(! p)
+        return;
+
+      Pool& pool = shared_pool();
+
+      if(bytes > class_size(num_classes - 1u)) {
+        pool.bytes_in_use -= bytes;
+        system_deallocate(p);
+        return;
+      }
+
+      const unsigned int c = size_class(bytes);
+      const std::size_t size = class_size(c);
+      pool.bytes_in_use -= size;
+
+      ThreadCache* const cache =
+          (size <= max_thread_block ? thread_cache() : nullptr);
+      if(cache) {
+        std::lock_guard<std::mutex> lock(cache->mutex);
+        if((cache->blocks[c].size() < max_thread_blocks) &&
+            ((cache->bytes + size) <= max_thread_bytes))
+        {
+          cache->blocks[c].push_back(p);
+          cache->bytes += size;
+          pool.bytes_cached += size;
+          return;
+        }
+      }
+
+      pool.push(c, p);
+    }
+
+    std::size_t block_size(const std::size_t bytes) {
+      if(bytes > class_size(num_classes - 1u))
+        return bytes;
+      return class_size(size_class(bytes));
+    }
+
+    PoolStatistics statistics() {
+      const Pool& pool = shared_pool();
+      return PoolStatistics{ pool.hits.load(), pool.misses.load(),
+          pool.bytes_in_use.load(), pool.high_water.load(),
+          pool.bytes_cached.load() };
+    }
+
+    void reset_statistics() {
+      Pool& pool = shared_pool();
+      pool.hits = 0ul;
+      pool.misses = 0ul;
+      pool.high_water = pool.bytes_in_use.load();
+    }
+
+    void trim() {
+      Pool& pool = shared_pool();
+      {
+        std::lock_guard<std::mutex> lock(pool.caches_mutex);
+        for(ThreadCache* const cache : pool.caches) {
+          std::lock_guard<std::mutex> cache_lock(cache->mutex);
+          cache->flush();
+        }
+      }
+      pool.trim();
+    }
+
+    void set_cache_limit(const std::size_t bytes) {
+      shared_pool().limit = bytes;
+    }
+
+    std::size_t cache_limit() {
+      return shared_pool().limit.load();
+    }
+
+  } // namespace pool
+} // namespace TiledArray
@@ -0,0 +1,299 @@
+/*
+ *  This file is a part of TiledArray.
+ *  Copyright (C) 2016  Virginia Tech
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef TILEDARRAY_TENSOR_POOL_ALLOCATOR_H__INCLUDED
+#define TILEDARRAY_TENSOR_POOL_ALLOCATOR_H__INCLUDED
+
+#include <TiledArray/config.h>
+#include <TiledArray/error.h>
+#include <cstddef>
+#include <limits>
+#include <new>
+#include <utility>
+
+namespace Eigen {
+  template <typename> class aligned_allocator;
+} // namespace Eigen
+
+namespace TiledArray {
+
+  /// Tile memory pool statistics
+  struct PoolStatistics {
+    std::size_t hits; ///< Allocations served by a cached block
+    std::size_t misses; ///< Allocations served by the system allocator
+    std::size_t bytes_in_use; ///< Bytes currently allocated from the pool
+    std::size_t high_water; ///< The maximum of \c bytes_in_use
+    std::size_t bytes_cached; ///< Bytes held in the pool caches
+  }; // struct PoolStatistics
+
+  /// Tile memory pool
+
+  /// Requests are rounded up to one of a set of size classes, with four
+  /// classes per power of two, and all blocks are aligned to the cache line
+  /// size. Freed blocks are cached, first in a small cache owned by the
+  /// freeing thread and then in a shared cache, and reused by later requests
+  /// of the same size class. This avoids system allocator calls and page
+  /// faults for the many short-lived tiles of an expression evaluation.
+  /// Requests larger than the largest size class are passed to the system
+  /// allocator.
+  namespace pool {
+
+    /// Allocate memory
+
+    /// \param bytes The number of bytes to allocate
+    /// \return A pointer to an aligned block of at least \c bytes bytes
+    /// \throw std::bad_alloc When the system allocator fails
+    void* allocate(const std::size_t bytes);
+
+    /// Deallocate memory
+
+    /// \param p A pointer returned by \c allocate
+    /// \param bytes The size that was passed to \c allocate
+    void deallocate(void* const p, const std::size_t bytes);
+
+    /// The size of the block that holds an allocation
+
+    /// \param bytes The number of bytes to allocate
+    /// \return The size of the size class of \c bytes , or \c bytes when it
+    /// is larger than the largest size class
+    std::size_t block_size(const std::size_t bytes);
+
+    /// Pool usage statistics
+
+    /// \return The current pool statistics
+    PoolStatistics statistics();
+
+    /// Reset the hit, miss, and high-water statistics
+    void reset_statistics();
+
+    /// Release the cached blocks of the shared cache and the caches of all
+    /// threads to the system allocator
+    void trim();
+
+    /// Set the maximum number of bytes held in the pool caches
+
+    /// Blocks that are moved to the shared cache when the cached bytes would
+    /// exceed the limit are returned to the system allocator instead. A limit
+    /// of zero disables the shared cache; the small per-thread caches are
+    /// not affected.
+    /// \param bytes The cache limit in bytes
+    void set_cache_limit(const std::size_t bytes);
+
+    /// The maximum number of bytes held in the pool caches
+
+    /// \return The cache limit in bytes
+    std::size_t cache_limit();
+
+  } // namespace pool
+
+  /// Allocator that uses the tile memory pool
+
+  /// \tparam T The element type
+  template <typename T>
+  class PoolAllocator {
+  public:
+    typedef T value_type;
+    typedef T* pointer;
+    typedef const T* const_pointer;
+    typedef T& reference;
+    typedef const T& const_reference;
+    typedef std::size_t size_type;
+    typedef std::ptrdiff_t difference_type;
+
+    template <typename U>
+    struct rebind { typedef PoolAllocator<U> other; };
+
+    PoolAllocator() = default;
+    PoolAllocator(const PoolAllocator&) = default;
+    template <typename U>
+    PoolAllocator(const PoolAllocator<U>&) { }
+
+    pointer allocate(const size_type n, const void* = nullptr) {
+      TA_ASSERT(n <= max_size());
+      return static_cast<pointer>(pool::allocate(n * sizeof(T)));
+    }
+
+    void deallocate(const pointer p, const size_type n) {
+      pool::deallocate(p, n * sizeof(T));
+    }
+
+    size_type max_size() const {
+      return std::numeric_limits<size_type>::max() / sizeof(T);
+    }
+
+    template <typename U, typename... Args>
+    void construct(U* const p, Args&&... args) {
+      ::new(static_cast<void*>(p)) U(std::forward<Args>(args)...);
+    }
+
+    template <typename U>
+    void destroy(U* const p) { p->~U(); }
+
+    pointer address(reference x) const { return &x; }
+    const_pointer address(const_reference x) const { return &x; }
+
+  }; // class PoolAllocator
+
+  template <typename T, typename U>
+  inline bool operator==(const PoolAllocator<T>&, const PoolAllocator<U>&) {
+    return true;
+  }
+
+  template <typename T, typename U>
+  inline bool operator!=(const PoolAllocator<T>&, const PoolAllocator<U>&) {
+    return false;
+  }
+
+  namespace detail {
+
+    /// Allocator that appends a data buffer to each allocation
+
+    /// This allocator is used with \c std::allocate_shared to place a tile
+    /// object, its reference count, and its data in a single block from the
+    /// tile memory pool. The data buffer starts at the first cache line
+    /// boundary after the allocated objects. When the header would move the
+    /// block to a size class that is larger than the two blocks of a separate
+    /// allocation, e.g. for data buffers that fill a size class exactly, the
+    /// data buffer is allocated in its own block and its address is stored
+    /// after the header.
+    /// \tparam T The element type
+    template <typename T>
+    class ColocatedAllocator {
+    public:
+      typedef T value_type;
+      typedef T* pointer;
+      typedef const T* const_pointer;
+      typedef T& reference;
+      typedef const T& const_reference;
+      typedef std::size_t size_type;
+      typedef std::ptrdiff_t difference_type;
+
+      template <typename U>
+      struct rebind { typedef ColocatedAllocator<U> other; };
+
+    private:
+      template <typename> friend class ColocatedAllocator;
+
+      std::size_t data_bytes_; ///< The size of the data buffer
+      void** data_; ///< Receives the address of the data buffer on allocation
+
+      static std::size_t header_bytes(const size_type n) {
+        return (n * sizeof(T) + (TILEDARRAY_CACHELINE_SIZE - 1ul)) &
+            ~std::size_t(TILEDARRAY_CACHELINE_SIZE - 1ul);
+      }
+
+      /// Check that the data buffer is placed in the header block
+
+      /// \param header The size of the header in bytes
+      /// \return \c true if a single block for the header and data is not
+      /// larger than separate header and data blocks
+      bool is_colocated(const std::size_t header) const {
+        return pool::block_size(header + data_bytes_) <=
+            (pool::block_size(header + sizeof(void*)) + pool::block_size(data_bytes_));
+      }
+
+    public:
+
+      /// Constructor
+
+      /// \param data_bytes The size of the data buffer in bytes
+      /// \param data A pointer that is set to the address of the data buffer
+      /// when memory is allocated
+      ColocatedAllocator(const std::size_t data_bytes, void** const data) :
+        data_bytes_(data_bytes), data_(data)
+      { }
+
+      ColocatedAllocator(const ColocatedAllocator&) = default;
+
+      template <typename U>
+      ColocatedAllocator(const ColocatedAllocator<U>& other) :
+        data_bytes_(other.data_bytes_), data_(other.data_)
+      { }
+
+      pointer allocate(const size_type n, const void* = nullptr) {
+        const std::size_t header = header_bytes(n);
+        if(is_colocated(header)) {
+          char* const p = static_cast<char*>(pool::allocate(header + data_bytes_));
+          *data_ = p + header;
+          return reinterpret_cast<pointer>(p);
+        }
+
+        char* const p = static_cast<char*>(pool::allocate(header + sizeof(void*)));
+        try {
+          *data_ = pool::allocate(data_bytes_);
+        } catch(...) {
+          pool::deallocate(p, header + sizeof(void*));
+          throw;
+        }
+        *reinterpret_cast<void**>(p + header) = *data_;
+        return reinterpret_cast<pointer>(p);
+      }
+
+      void deallocate(const pointer p, const size_type n) {
+        const std::size_t header = header_bytes(n);
+        if(is_colocated(header)) {
+          pool::deallocate(p, header + data_bytes_);
+        } else {
+          char* const block = reinterpret_cast<char*>(p);
+          pool::deallocate(*reinterpret_cast<void**>(block + header), data_bytes_);
+          pool::deallocate(p, header + sizeof(void*));
+        }
+      }
+
+      size_type max_size() const {
+        return std::numeric_limits<size_type>::max() / sizeof(T);
+      }
+
+      template <typename U, typename... Args>
+      void construct(U* const p, Args&&... args) {
+        ::new(static_cast<void*>(p)) U(std::forward<Args>(args)...);
+      }
+
+      template <typename U>
+      void destroy(U* const p) { p->~U(); }
+
+      template <typename U>
+      bool operator==(const ColocatedAllocator<U>& other) const {
+        return data_bytes_ == other.data_bytes_;
+      }
+
+      template <typename U>
+      bool operator!=(const ColocatedAllocator<U>& other) const {
+        return data_bytes_ != other.data_bytes_;
+      }
+
+    }; // class ColocatedAllocator
+
+    /// The allocator used for tile data
+
+    /// Tiles with the default allocator, \c Eigen::aligned_allocator , use
+    /// the tile memory pool. Other allocators are used as given.
+    /// \tparam A The tensor allocator type
+    template <typename A>
+    struct tile_allocator { typedef A type; };
+
+    template <typename T>
+    struct tile_allocator<Eigen::aligned_allocator<T> > {
+      typedef PoolAllocator<T> type;
+    };
+
+  } // namespace detail
+} // namespace TiledArray
+
+#endif // TILEDARRAY_TENSOR_POOL_ALLOCATOR_H__INCLUDED
@@ -22,11 +22,28 @@
 
 #include <TiledArray/math/gemm_helper.h>
 #include <TiledArray/math/blas.h>
+#include <TiledArray/math/parallel_gemm.h>
+#include <TiledArray/math/strided_gemm.h>
 #include <TiledArray/tensor/kernels.h>
 #include <TiledArray/tensor/complex.h>
+#include <TiledArray/tensor/pool_allocator.h>
 
 namespace TiledArray {
 
+  namespace detail {
+
+    /// Tensor construction tag type, see \c TiledArray::uninitialized
+    struct uninitialized_t { };
+
+  } // namespace detail
+
+  /// Tag that selects construction of a tensor with uninitialized data
+
+  /// Use this for result tensors where every element is written before it is
+  /// read, e.g. the result of a *GEMM with a zero \c beta , to avoid a pass
+  /// of memory writes over the data.
+  constexpr detail::uninitialized_t uninitialized = detail::uninitialized_t();
+
   /// An N-dimensional tensor object
 
   /// \tparam T the value type of this tensor
@@ -56,36 +73,79 @@ namespace TiledArray {
     template <typename X>
     using numeric_t = typename TiledArray::detail::numeric_type<X>::type;
 
+    /// The allocator used for the tensor data
+
+    /// Data of tensors with the default allocator is allocated from the tile
+    /// memory pool (see \c pool ).
+    typedef typename detail::tile_allocator<allocator_type>::type
+        impl_allocator_type;
+
     /// Evaluation tensor
 
     /// This tensor is used as an evaluated intermediate for other tensors.
-    class Impl : public allocator_type {
+    class Impl : public impl_allocator_type {
     public:
 
       /// Default constructor
 
       /// Construct an empty tensor that has no data or dimensions
-      Impl() : allocator_type(), range_(), data_(NULL) { }
+      Impl() : impl_allocator_type(), range_(), data_(NULL), owns_data_(true) { }
 
       /// Construct with range
 
       /// \param range The N-dimensional range for this tensor
       explicit Impl(const range_type& range) :
-        allocator_type(), range_(range), data_(NULL)
+        impl_allocator_type(), range_(range), data_(NULL), owns_data_(true)
       {
-        data_ = allocator_type::allocate(range.volume());
+        data_ = impl_allocator_type::allocate(range.volume());
       }
 
+      /// Construct with range and co-located data
+
+      /// \param range The N-dimensional range for this tensor
+      /// \param data The address of the data buffer, which is allocated
+      /// together with this object and is not deallocated by it. \c data is
+      /// passed by reference since it is set when the memory for this object
+      /// is allocated, i.e. after the constructor arguments are bound.
+      Impl(const range_type& range, void* const& data) :
+        impl_allocator_type(), range_(range),
+        data_(static_cast<pointer>(data)), owns_data_(false)
+      { }
+
       ~Impl() {
         math::destroy_vector(range_.volume(), data_);
-        allocator_type::deallocate(data_, range_.volume());
+        if(owns_data_)
+          impl_allocator_type::deallocate(data_, range_.volume());
         data_ = NULL;
       }
 
       range_type range_; ///< Tensor size info
       pointer data_; ///< Tensor data
+      bool owns_data_; ///< \c true when \c data_ was allocated by this object
     }; // class Impl
 
+    /// Construct a tensor implementation object with uninitialized data
+
+    /// Tensors that use the tile memory pool place the reference count, the
+    /// implementation object, and the data in a single allocation, unless
+    /// that wastes memory (see \c detail::ColocatedAllocator ).
+    /// \param range The range of the tensor
+    /// \return A shared pointer to the implementation object
+    static std::shared_ptr<Impl> make_impl(const range_type& range) {
+      return make_impl(range, std::is_same<impl_allocator_type,
+          PoolAllocator<value_type> >());
+    }
+
+    static std::shared_ptr<Impl> make_impl(const range_type& range, std::true_type) {
+      void* data = nullptr;
+      return std::allocate_shared<Impl>(detail::ColocatedAllocator<Impl>(
+          range.volume() * sizeof(value_type), &data), range, data);
+    }
+
+    static std::shared_ptr<Impl> make_impl(const range_type& range, std::false_type) {
+      return std::make_shared<Impl>(range);
+    }
+
     template <typename... Ts>
     struct is_tensor {
       static constexpr bool value =
@@ -100,6 +160,26 @@ namespace TiledArray {
       math::uninitialized_fill_vector(n, U(), u);
     }
 
+    /// Compute the extents and memory strides of a permuted range
+
+    /// \param range The range of the tensor data
+    /// \param perm The permutation applied to \c range
+    /// \param[out] extent The extents of the permuted range
+    /// \param[out] stride The memory strides of the dimensions of the permuted
+    /// range, with respect to the layout of \c range
+    static void permuted_layout(const range_type& range, const Permutation& perm,
+        std::vector<size_type>& extent, std::vector<size_type>& stride)
+    {
+      const unsigned int rank = range.rank();
+      extent.resize(rank);
+      stride.resize(rank);
+      for(unsigned int i = 0u; i < rank; ++i) {
+        const unsigned int pi = (perm ? perm[i] : i);
+        extent[pi] = range.extent_data()[i];
+        stride[pi] = range.stride_data()[i];
+      }
+    }
+
     std::shared_ptr<Impl> pimpl_; ///< Shared pointer to implementation object
     static const range_type empty_range_; ///< Empty range
 
@@ -125,11 +205,24 @@ namespace TiledArray {
     /// uninitialized.
     /// \param range The range of the tensor
     Tensor(const range_type& range) :
-      pimpl_(new Impl(range))
+      pimpl_(make_impl(range))
     {
       default_init(range.volume(), pimpl_->data_);
     }
 
+    /// Construct tensor with uninitialized data
+
+    /// Construct a tensor with a range equal to \c range , where the elements
+    /// are not initialized, not even for element types with a default
+    /// constructor (e.g. \c std::complex ). Every element must be assigned
+    /// before it is read.
+    /// \param range The range of the tensor
+    template <typename U = value_type,
+        typename std::enable_if<detail::is_numeric<U>::value>::type* = nullptr>
+    Tensor(const range_type& range, detail::uninitialized_t) :
+      pimpl_(make_impl(range))
+    { }
+
 
     /// Construct a tensor with a fill value
 
@@ -139,7 +232,7 @@ namespace TiledArray {
         typename std::enable_if<std::is_same<Value, value_type>::value &&
         detail::is_tensor<Value>::value>::type* = nullptr>
     Tensor(const range_type& range, const Value& value) :
-      pimpl_(new Impl(range))
+      pimpl_(make_impl(range))
     {
       const size_type n = pimpl_->range_.volume();
       pointer restrict const data = pimpl_->data_;
@@ -154,7 +247,7 @@ namespace TiledArray {
     template <typename Value,
         typename std::enable_if<detail::is_numeric<Value>::value>::type* = nullptr>
     Tensor(const range_type& range, const Value& value) :
-      pimpl_(new Impl(range))
+      pimpl_(make_impl(range))
     {
       detail::tensor_init([=] () -> Value { return value; }, *this);
     }
@@ -164,7 +257,7 @@ namespace TiledArray {
         typename std::enable_if<TiledArray::detail::is_input_iterator<InIter>::value &&
             ! std::is_pointer<InIter>::value>::type* = nullptr>
     Tensor(const range_type& range, InIter it) :
-      pimpl_(new Impl(range))
+      pimpl_(make_impl(range))
     {
       size_type n = range.volume();
       pointer restrict const data = pimpl_->data_;
@@ -174,7 +267,7 @@ namespace TiledArray {
 
     template <typename U>
     Tensor(const Range& range, const U* u) :
-      pimpl_(new Impl(range))
+      pimpl_(make_impl(range))
     {
       math::uninitialized_copy_vector(range.volume(), u, pimpl_->data_);
     }
@@ -187,7 +280,7 @@ namespace TiledArray {
         typename std::enable_if<is_tensor<T1>::value &&
             ! std::is_same<T1, Tensor_>::value>::type* = nullptr>
     Tensor(const T1& other) :
-      pimpl_(new Impl(detail::clone_range(other)))
+      pimpl_(make_impl(detail::clone_range(other)))
     {
       auto op =
           [] (const numeric_t<T1> arg) -> numeric_t<T1>
@@ -204,13 +297,9 @@ namespace TiledArray {
     template <typename T1,
         typename std::enable_if<is_tensor<T1>::value>::type* = nullptr>
     Tensor(const T1& other, const Permutation& perm) :
-      pimpl_(new Impl(perm * other.range()))
+      pimpl_(make_impl(perm * other.range()))
     {
-      auto op =
-          [] (const numeric_t<T1> arg) -> numeric_t<T1>
-      { return arg; };
-
-      detail::tensor_init(op, perm, *this, other);
+      detail::tensor_copy_init(perm, *this, other);
     }
 
     /// Copy and modify the data from \c other
@@ -224,7 +313,7 @@ namespace TiledArray {
                  && ! std::is_same<typename std::decay<Op>::type,
                  Permutation>::value>::type* = nullptr>
     Tensor(const T1& other, Op&& op) :
-      pimpl_(new Impl(detail::clone_range(other)))
+      pimpl_(make_impl(detail::clone_range(other)))
     {
       detail::tensor_init(op, *this, other);
     }
@@ -238,7 +327,7 @@ namespace TiledArray {
     template <typename T1, typename Op,
         typename std::enable_if<is_tensor<T1>::value>::type* = nullptr>
     Tensor(const T1& other, Op&& op, const Permutation& perm) :
-      pimpl_(new Impl(perm * other.range()))
+      pimpl_(make_impl(perm * other.range()))
     {
       detail::tensor_init(op, perm, *this, other);
     }
@@ -254,7 +343,7 @@ namespace TiledArray {
     template <typename T1, typename T2, typename Op,
         typename std::enable_if<is_tensor<T1, T2>::value>::type* = nullptr>
     Tensor(const T1& left, const T2& right, Op&& op) :
-      pimpl_(new Impl(detail::clone_range(left)))
+      pimpl_(make_impl(detail::clone_range(left)))
     {
       detail::tensor_init(op, *this, left, right);
     }
@@ -271,7 +360,7 @@ namespace TiledArray {
     template <typename T1, typename T2, typename Op,
         typename std::enable_if<is_tensor<T1, T2>::value>::type* = nullptr>
     Tensor(const T1& left, const T2& right, Op&& op, const Permutation& perm) :
-      pimpl_(new Impl(perm * left.range()))
+      pimpl_(make_impl(perm * left.range()))
     {
       detail::tensor_init(op, perm, *this, left, right);
     }
@@ -454,6 +543,7 @@ namespace TiledArray {
           ar & temp->range_;
         } catch(...) {
           temp->deallocate(temp->data_, n);
+          temp->data_ = NULL;
           throw;
         }
 
@@ -663,7 +753,11 @@ namespace TiledArray {
     template <typename Scalar,
         typename std::enable_if<detail::is_numeric<Scalar>::value>::type* = nullptr>
     Tensor_& scale_to(const Scalar factor) {
-      return inplace_unary([=] (numeric_type& restrict res) { res *= factor; });
+      detail::simd_inplace_tensor_op(
+          [=] (const std::size_t n, numeric_type* const res)
+          { math::simd::scale_to(n, numeric_type(factor), res); },
+          [=] (numeric_type& restrict res) { res *= factor; }, *this);
+      return *this;
     }
 
     // Addition operations
@@ -763,8 +857,13 @@ namespace TiledArray {
     template <typename Right,
         typename std::enable_if<is_tensor<Right>::value>::type* = nullptr>
     Tensor_& add_to(const Right& right) {
-      return inplace_binary(right, [] (numeric_type& restrict l,
-          const numeric_t<Right> r) { l += r; });
+      detail::simd_inplace_tensor_op(
+          [] (const std::size_t n, numeric_type* const l,
+              const numeric_t<Right>* const r)
+          { math::simd::add_to(n, l, r); },
+          [] (numeric_type& restrict l, const numeric_t<Right> r)
+          { l += r; }, *this, right);
+      return *this;
     }
 
     /// Add \c other to this tensor, and scale the result
@@ -778,9 +877,13 @@ namespace TiledArray {
         typename std::enable_if<is_tensor<Right>::value &&
         detail::is_numeric<Scalar>::value>::type* = nullptr>
     Tensor_& add_to(const Right& right, const Scalar factor) {
-      return inplace_binary(right, [=] (numeric_type& restrict l,
-          const numeric_t<Right> r)
-          { (l += r) *= factor; });
+      detail::simd_inplace_tensor_op(
+          [=] (const std::size_t n, numeric_type* const l,
+              const numeric_t<Right>* const r)
+          { math::simd::add_to(n, l, r, numeric_type(factor)); },
+          [=] (numeric_type& restrict l, const numeric_t<Right> r)
+          { (l += r) *= factor; }, *this, right);
+      return *this;
     }
 
     /// Add a constant to this tensor
@@ -885,9 +988,13 @@ namespace TiledArray {
     template <typename Right,
         typename std::enable_if<is_tensor<Right>::value>::type* = nullptr>
     Tensor_& subt_to(const Right& right) {
-      return inplace_binary(right, [] (numeric_type& restrict l,
-          const numeric_t<Right> r)
-          { l -= r; });
+      detail::simd_inplace_tensor_op(
+          [] (const std::size_t n, numeric_type* const l,
+              const numeric_t<Right>* const r)
+          { math::simd::subt_to(n, l, r); },
+          [] (numeric_type& restrict l, const numeric_t<Right> r)
+          { l -= r; }, *this, right);
+      return *this;
     }
 
     /// Subtract \c right from and scale this tensor
@@ -901,9 +1008,13 @@ namespace TiledArray {
         typename std::enable_if<is_tensor<Right>::value &&
         detail::is_numeric<Scalar>::value>::type* = nullptr>
     Tensor_& subt_to(const Right& right, const Scalar factor) {
-      return inplace_binary(right, [=] (numeric_type& restrict l,
-          const numeric_t<Right> r)
-          { (l -= r) *= factor; });
+      detail::simd_inplace_tensor_op(
+          [=] (const std::size_t n, numeric_type* const l,
+              const numeric_t<Right>* const r)
+          { math::simd::subt_to(n, l, r, numeric_type(factor)); },
+          [=] (numeric_type& restrict l, const numeric_t<Right> r)
+          { (l -= r) *= factor; }, *this, right);
+      return *this;
     }
 
     /// Subtract a constant from this tensor
@@ -989,9 +1100,13 @@ namespace TiledArray {
     template <typename Right,
         typename std::enable_if<is_tensor<Right>::value>::type* = nullptr>
     Tensor_& mult_to(const Right& right) {
-      return inplace_binary(right, [] (numeric_type& restrict l,
-          const numeric_t<Right> r)
-          { l *= r; });
+      detail::simd_inplace_tensor_op(
+          [] (const std::size_t n, numeric_type* const l,
+              const numeric_t<Right>* const r)
+          { math::simd::mult_to(n, l, r); },
+          [] (numeric_type& restrict l, const numeric_t<Right> r)
+          { l *= r; }, *this, right);
+      return *this;
     }
 
     /// Scale and multiply this tensor by \c right
@@ -1005,9 +1120,13 @@ namespace TiledArray {
         typename std::enable_if<is_tensor<Right>::value &&
         detail::is_numeric<Scalar>::value>::type* = nullptr>
     Tensor_& mult_to(const Right& right, const Scalar factor) {
-      return inplace_binary(right, [=] (numeric_type& restrict l,
-          const numeric_t<Right> r)
-          { (l *= r) *= factor; });
+      detail::simd_inplace_tensor_op(
+          [=] (const std::size_t n, numeric_type* const l,
+              const numeric_t<Right>* const r)
+          { math::simd::mult_to(n, l, r, numeric_type(factor)); },
+          [=] (numeric_type& restrict l, const numeric_t<Right> r)
+          { (l *= r) *= factor; }, *this, right);
+      return *this;
     }
 
     // Negation operations
@@ -1129,7 +1248,8 @@ namespace TiledArray {
       TA_ASSERT(other.range().rank() == gemm_helper.right_rank());
 
       // Construct the result Tensor
-      Tensor_ result(gemm_helper.make_result_range<range_type>(pimpl_->range_, other.range()));
+      Tensor_ result(gemm_helper.make_result_range<range_type>(pimpl_->range_,
+          other.range()), uninitialized);
 
       // Check that the inner dimensions of left and right match
       TA_ASSERT(gemm_helper.left_right_coformal(pimpl_->range_.lobound_data(), other.range().lobound_data()));
@@ -1145,7 +1265,7 @@ namespace TiledArray {
       const integer lda = (gemm_helper.left_op() == madness::cblas::NoTrans ? k : m);
       const integer ldb = (gemm_helper.right_op() == madness::cblas::NoTrans ? n : k);
 
-      math::gemm(gemm_helper.left_op(), gemm_helper.right_op(), m, n, k, factor,
+      math::parallel_gemm(gemm_helper.left_op(), gemm_helper.right_op(), m, n, k, factor,
           pimpl_->data_, lda, other.data(), ldb, numeric_type(0), result.data(), n);
 
       return result;
@@ -1242,12 +1362,173 @@ namespace TiledArray {
       const integer ldb =
           (gemm_helper.right_op() == madness::cblas::NoTrans ? n : k);
 
-      math::gemm(gemm_helper.left_op(), gemm_helper.right_op(), m, n, k, factor,
+      math::parallel_gemm(gemm_helper.left_op(), gemm_helper.right_op(), m, n, k, factor,
           left.data(), lda, right.data(), ldb, numeric_type(1), pimpl_->data_, n);
 
       return *this;
     }
 
+    /// Contract two permuted tensors and store the result in this tensor
+
+    /// This function computes the same contraction as
+    /// <tt>gemm(left.permute(left_perm), right.permute(right_perm), factor,
+    /// gemm_helper)</tt>, where \c gemm_helper describes the permuted
+    /// arguments, but the permuted copies of the arguments are never formed.
+    /// Instead, panels of the arguments are packed directly from their
+    /// original layout (see \c math::strided_gemm ), which avoids the memory
+    /// traffic and the peak memory of the argument permutations. If this
+    /// tensor is empty, it is set to the result of the contraction.
+    /// \tparam U The left-hand tensor element type
+    /// \tparam AU The left-hand tensor allocator type
+    /// \tparam V The right-hand tensor element type
+    /// \tparam AV The right-hand tensor allocator type
+    /// \tparam W The type of the scaling factor
+    /// \param left The left-hand tensor that will be contracted
+    /// \param left_perm The permutation that maps \c left to the layout
+    /// expected by \c gemm_helper
+    /// \param right The right-hand tensor that will be contracted
+    /// \param right_perm The permutation that maps \c right to the layout
+    /// expected by \c gemm_helper
+    /// \param factor The scaling factor
+    /// \param gemm_helper The *GEMM operation meta data
+    /// \return A reference to this tensor
+    template <typename U, typename AU, typename V, typename AV, typename W>
+    Tensor_& gemm(const Tensor<U, AU>& left, const Permutation& left_perm,
+        const Tensor<V, AV>& right, const Permutation& right_perm,
+        const W factor, const math::GemmHelper& gemm_helper)
+    {
+      TA_ASSERT(! left.empty());
+      TA_ASSERT(left.range().rank() == gemm_helper.left_rank());
+      TA_ASSERT(! right.empty());
+      TA_ASSERT(right.range().rank() == gemm_helper.right_rank());
+
+      // Compute the extents and strides of the arguments in the permuted
+      // layout.
+      std::vector<size_type> left_extent, left_stride, right_extent, right_stride;
+      permuted_layout(left.range(), left_perm, left_extent, left_stride);
+      permuted_layout(right.range(), right_perm, right_extent, right_stride);
+      const range_type left_range = (left_perm ? left_perm * left.range() : left.range());
+      const range_type right_range = (right_perm ? right_perm * right.range() : right.range());
+
+      // Construct an uninitialized result tensor when this tensor is empty,
+      // since the result is then overwritten (beta = 0).
+      const bool init_result = ! pimpl_;
+      if(init_result)
+        *this = Tensor_(gemm_helper.make_result_range<range_type>(left_range,
+            right_range), uninitialized);
+
+      // Check that the outer dimensions of left match the the corresponding
+      // dimensions in result
+      TA_ASSERT(pimpl_->range_.rank() == gemm_helper.result_rank());
+      TA_ASSERT(gemm_helper.left_result_coformal(left_range.extent_data(),
+          pimpl_->range_.extent_data()));
+      TA_ASSERT(gemm_helper.right_result_coformal(right_range.extent_data(),
+          pimpl_->range_.extent_data()));
+      TA_ASSERT(gemm_helper.left_right_coformal(left_range.extent_data(),
+          right_range.extent_data()));
+
+      // Compute gemm dimensions
+      integer m, n, k;
+      gemm_helper.compute_matrix_sizes(m, n, k, left_range, right_range);
+
+      // Compute the element offsets of the rows and columns of the left- and
+      // right-hand matrices.
+      std::vector<integer> left_row, left_col, right_row, right_col;
+      math::fused_offsets(gemm_helper.left_outer_end() - gemm_helper.left_outer_begin(),
+          left_extent.data() + gemm_helper.left_outer_begin(),
+          left_stride.data() + gemm_helper.left_outer_begin(), left_row);
+      math::fused_offsets(gemm_helper.left_inner_end() - gemm_helper.left_inner_begin(),
+          left_extent.data() + gemm_helper.left_inner_begin(),
+          left_stride.data() + gemm_helper.left_inner_begin(), left_col);
+      math::fused_offsets(gemm_helper.right_inner_end() - gemm_helper.right_inner_begin(),
+          right_extent.data() + gemm_helper.right_inner_begin(),
+          right_stride.data() + gemm_helper.right_inner_begin(), right_row);
+      math::fused_offsets(gemm_helper.right_outer_end() - gemm_helper.right_outer_begin(),
+          right_extent.data() + gemm_helper.right_outer_begin(),
+          right_stride.data() + gemm_helper.right_outer_begin(), right_col);
+
+      math::strided_gemm(m, n, k, factor, left.data(), left_row.data(),
+          left_col.data(), right.data(), right_row.data(), right_col.data(),
+          numeric_type(init_result ? 0 : 1), pimpl_->data_, n);
+
+      return *this;
+    }
+
+    /// Contract a batch of tensor pairs and store the result in this tensor
+
+    /// The pairs <tt>(*left[i], *right[i])</tt> all contribute to this tensor,
+    /// and they differ only in the size of the inner (contracted) dimensions.
+    /// The left- and right-hand tensors are packed along the inner dimension
+    /// and contracted with a single *GEMM call, which is more efficient than
+    /// one call per pair when the tensors are small. The contraction patterns
+    /// supported are the same as those of the pair-wise \c gemm function.
+    /// \tparam U The left-hand tensor element type
+    /// \tparam AU The left-hand tensor allocator type
+    /// \tparam V The right-hand tensor element type
+    /// \tparam AV The right-hand tensor allocator type
+    /// \tparam W The type of the scaling factor
+    /// \param left The left-hand tensors that will be contracted
+    /// \param right The right-hand tensors that will be contracted
+    /// \param factor The scaling factor
+    /// \param gemm_helper The *GEMM operation meta data
+    /// \return A reference to this tensor
+    /// \throw TiledArray::Exception When this tensor is empty.
+    /// \throw TiledArray::Exception When \c left and \c right have different
+    /// sizes.
+    template <typename U, typename AU, typename V, typename AV, typename W>
+    Tensor_& gemm(const std::vector<const Tensor<U, AU>*>& left,
+        const std::vector<const Tensor<V, AV>*>& right, const W factor,
+        const math::GemmHelper& gemm_helper)
+    {
+      TA_ASSERT(pimpl_);
+      TA_ASSERT(left.size() == right.size());
+
+      const std::size_t batch_size = left.size();
+      if(batch_size == 1ul)
+        return gemm(*left.front(), *right.front(), factor, gemm_helper);
+
+      // Compute the gemm dimensions of each pair and the packed k dimension
+      integer m = 1, n = 1, k = 0;
+      std::vector<integer> k_sizes(batch_size);
+      for(std::size_t i = 0ul; i < batch_size; ++i) {
+        TA_ASSERT(! left[i]->empty());
+        TA_ASSERT(! right[i]->empty());
+        TA_ASSERT(gemm_helper.left_result_coformal(left[i]->range().extent_data(),
+            pimpl_->range_.extent_data()));
+        TA_ASSERT(gemm_helper.right_result_coformal(right[i]->range().extent_data(),
+            pimpl_->range_.extent_data()));
+        TA_ASSERT(gemm_helper.left_right_coformal(left[i]->range().extent_data(),
+            right[i]->range().extent_data()));
+
+        integer k_i = 1;
+        gemm_helper.compute_matrix_sizes(m, n, k_i, left[i]->range(), right[i]->range());
+        k_sizes[i] = k_i;
+        k += k_i;
+      }
+
+      // Pack the arguments along the k dimension. The inner dimension is the
+      // fast (row-major column) dimension for a non-transposed left-hand
+      // argument and a transposed right-hand argument.
+      std::vector<U> left_packed(m * k);
+      std::vector<V> right_packed(k * n);
+      detail::pack_k(left, k_sizes.data(), m,
+          gemm_helper.left_op() == madness::cblas::NoTrans, left_packed.data());
+      detail::pack_k(right, k_sizes.data(), n,
+          gemm_helper.right_op() != madness::cblas::NoTrans, right_packed.data());
+
+      // Get the leading dimension for left and right matrices.
+      const integer lda =
+          (gemm_helper.left_op() == madness::cblas::NoTrans ? k : m);
+      const integer ldb =
+          (gemm_helper.right_op() == madness::cblas::NoTrans ? n : k);
+
+      math::parallel_gemm(gemm_helper.left_op(), gemm_helper.right_op(), m, n, k, factor,
+          left_packed.data(), lda, right_packed.data(), ldb, numeric_type(1),
+          pimpl_->data_, n);
+
+      return *this;
+    }
+
     // Reduction operations
 
     /// Generalized tensor trace
@@ -1360,7 +1641,10 @@ namespace TiledArray {
               { res += TiledArray::detail::norm(arg); };
       auto sum_op = [] (scalar_type& restrict res, const scalar_type arg)
               { res += arg; };
-      return detail::tensor_reduce(square_op, sum_op, scalar_type(0), *this);
+      auto simd_op = [] (const std::size_t n, const numeric_type* const arg)
+              { return math::simd::squared_norm(n, arg); };
+      return detail::simd_tensor_reduce(simd_op, square_op, sum_op,
+          scalar_type(0), *this);
     }
 
     /// Vector 2-norm
@@ -1407,7 +1691,10 @@ namespace TiledArray {
               { res = std::max(res, std::abs(arg)); };
       auto max_op = [] (numeric_type& restrict res, const numeric_type arg)
               { res = std::max(res, arg); };
-      return reduce(abs_max_op, max_op, numeric_type(0));
+      auto simd_op = [] (const std::size_t n, const numeric_type* const arg)
+              { return math::simd::abs_max(n, arg); };
+      return detail::simd_tensor_reduce(simd_op, abs_max_op, max_op,
+          numeric_type(0), *this);
     }
 
     /// Vector dot product
@@ -1423,7 +1710,11 @@ namespace TiledArray {
                 { res += l * r; };
       auto add_op = [] (numeric_type& restrict res, const numeric_type value)
             { res += value; };
-      return reduce(other, mult_add_op, add_op, numeric_type(0));
+      auto simd_op = [] (const std::size_t n, const numeric_type* const l,
+                const numeric_t<Right>* const r)
+            { return math::simd::dot(n, l, r); };
+      return detail::simd_tensor_reduce(simd_op, mult_add_op, add_op,
+          numeric_type(0), *this, other);
     }
 
   }; // class Tensor
@@ -52,14 +52,18 @@ namespace TiledArray {
       Impl(const madness::cblas::CBLAS_TRANSPOSE left_op,
           const madness::cblas::CBLAS_TRANSPOSE right_op, const scalar_type alpha,
           const unsigned int result_rank, const unsigned int left_rank,
-          const unsigned int right_rank, const Permutation& perm = Permutation()) :
+          const unsigned int right_rank, const Permutation& perm = Permutation(),
+          const Permutation& left_perm = Permutation(),
+          const Permutation& right_perm = Permutation()) :
         gemm_helper_(left_op, right_op, result_rank, left_rank, right_rank),
-        alpha_(alpha), perm_(perm)
+        alpha_(alpha), perm_(perm), left_perm_(left_perm), right_perm_(right_perm)
       { }
 
       math::GemmHelper gemm_helper_; ///< Gemm helper object
       scalar_type alpha_; ///< Scaling factor applied to the contraction of the left- and right-hand arguments
       Permutation perm_; ///< Permutation that is applied to the final result tensor
+      Permutation left_perm_; ///< Permutation of the left-hand argument tiles
+      Permutation right_perm_; ///< Permutation of the right-hand argument tiles
     };
 
     std::shared_ptr<Impl> pimpl_;
@@ -84,11 +88,18 @@ namespace TiledArray {
     /// \param right_rank The rank of the right-hand tensor
     /// \param perm The permutation to be applied to the result tensor
     /// (default = no permute)
+    /// \param left_perm The permutation that maps the left-hand tiles to the
+    /// layout of the contraction (default = no permute)
+    /// \param right_perm The permutation that maps the right-hand tiles to the
+    /// layout of the contraction (default = no permute)
     ContractReduceBase(const madness::cblas::CBLAS_TRANSPOSE left_op,
         const madness::cblas::CBLAS_TRANSPOSE right_op, const scalar_type alpha,
         const unsigned int result_rank, const unsigned int left_rank,
-        const unsigned int right_rank, const Permutation& perm = Permutation()) :
-      pimpl_(new Impl(left_op, right_op, alpha, result_rank, left_rank, right_rank, perm))
+        const unsigned int right_rank, const Permutation& perm = Permutation(),
+        const Permutation& left_perm = Permutation(),
+        const Permutation& right_perm = Permutation()) :
+      pimpl_(new Impl(left_op, right_op, alpha, result_rank, left_rank,
+          right_rank, perm, left_perm, right_perm))
     { }
 
 
@@ -108,6 +119,35 @@ namespace TiledArray {
       return pimpl_->perm_;
     }
 
+    /// Left-hand argument permutation accessor
+
+    /// The left-hand tiles are contracted as if they were permuted by this
+    /// permutation, but the permuted tiles are not formed.
+    /// \return A const reference to the left-hand argument permutation
+    const Permutation& left_perm() const {
+      TA_ASSERT(pimpl_);
+      return pimpl_->left_perm_;
+    }
+
+    /// Right-hand argument permutation accessor
+
+    /// The right-hand tiles are contracted as if they were permuted by this
+    /// permutation, but the permuted tiles are not formed.
+    /// \return A const reference to the right-hand argument permutation
+    const Permutation& right_perm() const {
+      TA_ASSERT(pimpl_);
+      return pimpl_->right_perm_;
+    }
+
+    /// Query the argument permutations
+
+    /// \return \c true if the argument tiles are contracted with a permuted
+    /// layout
+    bool permuted_args() const {
+      TA_ASSERT(pimpl_);
+      return pimpl_->left_perm_ || pimpl_->right_perm_;
+    }
+
 
     /// Scaling factor accessor
 
@@ -189,12 +229,18 @@ namespace TiledArray {
     /// \param right_rank The rank of the right-hand tensor
     /// \param perm The permutation to be applied to the result tensor
     /// (default = no permute)
+    /// \param left_perm The permutation that maps the left-hand tiles to the
+    /// layout of the contraction (default = no permute)
+    /// \param right_perm The permutation that maps the right-hand tiles to the
+    /// layout of the contraction (default = no permute)
     ContractReduce(const madness::cblas::CBLAS_TRANSPOSE left_op,
         const madness::cblas::CBLAS_TRANSPOSE right_op, const scalar_type alpha,
         const unsigned int result_rank, const unsigned int left_rank,
-        const unsigned int right_rank, const Permutation& perm = Permutation()) :
+        const unsigned int right_rank, const Permutation& perm = Permutation(),
+        const Permutation& left_perm = Permutation(),
+        const Permutation& right_perm = Permutation()) :
       ContractReduceBase_(left_op, right_op, alpha, result_rank, left_rank,
-          right_rank, perm)
+          right_rank, perm, left_perm, right_perm)
     { }
 
 
@@ -238,7 +284,11 @@ namespace TiledArray {
     {
       using TiledArray::empty;
       using TiledArray::gemm;
-      if(empty(result))
+      if(ContractReduceBase_::permuted_args())
+        gemm(result, left, ContractReduceBase_::left_perm(), right,
+            ContractReduceBase_::right_perm(), ContractReduceBase_::factor(),
+            ContractReduceBase_::gemm_helper());
+      else if(empty(result))
         result = gemm(left, right, ContractReduceBase_::factor(),
             ContractReduceBase_::gemm_helper());
       else
@@ -246,6 +296,38 @@ namespace TiledArray {
             ContractReduceBase_::gemm_helper());
     }
 
+    /// Contract a batch of tile pairs and add to a target tile
+
+    /// Contract each pair <tt>(*left[i], *right[i])</tt> and add the result to
+    /// \c result. The pairs are contracted together, which avoids the
+    /// overhead of one contraction per pair for small tiles.
+    /// \param[in,out] result The result object that will be the reduction target
+    /// \param[in] left The left-hand tiles to be contracted
+    /// \param[in] right The right-hand tiles to be contracted
+    void operator()(result_type& result, const std::vector<const Left*>& left,
+        const std::vector<const Right*>& right) const
+    {
+      using TiledArray::empty;
+      using TiledArray::gemm;
+      TA_ASSERT(left.size() == right.size());
+      TA_ASSERT(! left.empty());
+      if(ContractReduceBase_::permuted_args()) {
+        // Permuted tiles cannot be packed along the inner dimension.
+        for(std::size_t i = 0ul; i < left.size(); ++i)
+          operator()(result, *left[i], *right[i]);
+      } else if(empty(result)) {
+        result = gemm(*left.front(), *right.front(), ContractReduceBase_::factor(),
+            ContractReduceBase_::gemm_helper());
+        if(left.size() > 1ul)
+          gemm(result, std::vector<const Left*>(left.begin() + 1, left.end()),
+              std::vector<const Right*>(right.begin() + 1, right.end()),
+              ContractReduceBase_::factor(), ContractReduceBase_::gemm_helper());
+      } else {
+        gemm(result, left, right, ContractReduceBase_::factor(),
+            ContractReduceBase_::gemm_helper());
+      }
+    }
+
   }; // class ContractReduce
 
 
@@ -289,12 +371,18 @@ namespace TiledArray {
     /// \param right_rank The rank of the right-hand tensor
     /// \param perm The permutation to be applied to the result tensor
     /// (default = no permute)
+    /// \param left_perm The permutation that maps the left-hand tiles to the
+    /// layout of the contraction (default = no permute)
+    /// \param right_perm The permutation that maps the right-hand tiles to the
+    /// layout of the contraction (default = no permute)
     ContractReduce(const madness::cblas::CBLAS_TRANSPOSE left_op,
         const madness::cblas::CBLAS_TRANSPOSE right_op, const scalar_type alpha,
         const unsigned int result_rank, const unsigned int left_rank,
-        const unsigned int right_rank, const Permutation& perm = Permutation()) :
+        const unsigned int right_rank, const Permutation& perm = Permutation(),
+        const Permutation& left_perm = Permutation(),
+        const Permutation& right_perm = Permutation()) :
       ContractReduceBase_(left_op, right_op, alpha, result_rank, left_rank,
-          right_rank, perm)
+          right_rank, perm, left_perm, right_perm)
     { }
 
 
@@ -338,12 +426,47 @@ namespace TiledArray {
     {
       using TiledArray::empty;
       using TiledArray::gemm;
-      if(empty(result))
+      if(ContractReduceBase_::permuted_args())
+        gemm(result, left, ContractReduceBase_::left_perm(), right,
+            ContractReduceBase_::right_perm(), 1, ContractReduceBase_::gemm_helper());
+      else if(empty(result))
         result = gemm(left, right, 1, ContractReduceBase_::gemm_helper());
       else
         gemm(result, left, right, 1, ContractReduceBase_::gemm_helper());
     }
 
+    /// Contract a batch of tile pairs and add to a target tile
+
+    /// Contract each pair <tt>(*left[i], *right[i])</tt> and add the result to
+    /// \c result. The pairs are contracted together, which avoids the
+    /// overhead of one contraction per pair for small tiles.
+    /// \param[in,out] result The result object that will be the reduction target
+    /// \param[in] left The left-hand tiles to be contracted
+    /// \param[in] right The right-hand tiles to be contracted
+    void operator()(result_type& result, const std::vector<const Left*>& left,
+        const std::vector<const Right*>& right) const
+    {
+      using TiledArray::empty;
+      using TiledArray::gemm;
+      TA_ASSERT(left.size() == right.size());
+      TA_ASSERT(! left.empty());
+      if(ContractReduceBase_::permuted_args()) {
+        // Permuted tiles cannot be packed along the inner dimension.
+        for(std::size_t i = 0ul; i < left.size(); ++i)
+          operator()(result, *left[i], *right[i]);
+      } else if(empty(result)) {
+        result = gemm(*left.front(), *right.front(), 1,
+            ContractReduceBase_::gemm_helper());
+        if(left.size() > 1ul)
+          gemm(result, std::vector<const Left*>(left.begin() + 1, left.end()),
+              std::vector<const Right*>(right.begin() + 1, right.end()),
+              1, ContractReduceBase_::gemm_helper());
+      } else {
+        gemm(result, left, right, 1,
+            ContractReduceBase_::gemm_helper());
+      }
+    }
+
   }; // class ContractReduce
 
 
@@ -387,12 +510,18 @@ namespace TiledArray {
     /// \param right_rank The rank of the right-hand tensor
     /// \param perm The permutation to be applied to the result tensor
     /// (default = no permute)
+    /// \param left_perm The permutation that maps the left-hand tiles to the
+    /// layout of the contraction (default = no permute)
+    /// \param right_perm The permutation that maps the right-hand tiles to the
+    /// layout of the contraction (default = no permute)
     ContractReduce(const madness::cblas::CBLAS_TRANSPOSE left_op,
         const madness::cblas::CBLAS_TRANSPOSE right_op, const scalar_type alpha,
         const unsigned int result_rank, const unsigned int left_rank,
-        const unsigned int right_rank, const Permutation& perm = Permutation()) :
+        const unsigned int right_rank, const Permutation& perm = Permutation(),
+        const Permutation& left_perm = Permutation(),
+        const Permutation& right_perm = Permutation()) :
       ContractReduceBase_(left_op, right_op, alpha, result_rank, left_rank,
-          right_rank, perm)
+          right_rank, perm, left_perm, right_perm)
     { }
 
 
@@ -437,12 +566,47 @@ namespace TiledArray {
     {
       using TiledArray::empty;
       using TiledArray::gemm;
-      if(empty(result))
+      if(ContractReduceBase_::permuted_args())
+        gemm(result, left, ContractReduceBase_::left_perm(), right,
+            ContractReduceBase_::right_perm(), 1, ContractReduceBase_::gemm_helper());
+      else if(empty(result))
         result = gemm(left, right, 1, ContractReduceBase_::gemm_helper());
       else
         gemm(result, left, right, 1, ContractReduceBase_::gemm_helper());
     }
 
+    /// Contract a batch of tile pairs and add to a target tile
+
+    /// Contract each pair <tt>(*left[i], *right[i])</tt> and add the result to
+    /// \c result. The pairs are contracted together, which avoids the
+    /// overhead of one contraction per pair for small tiles.
+    /// \param[in,out] result The result object that will be the reduction target
+    /// \param[in] left The left-hand tiles to be contracted
+    /// \param[in] right The right-hand tiles to be contracted
+    void operator()(result_type& result, const std::vector<const Left*>& left,
+        const std::vector<const Right*>& right) const
+    {
+      using TiledArray::empty;
+      using TiledArray::gemm;
+      TA_ASSERT(left.size() == right.size());
+      TA_ASSERT(! left.empty());
+      if(ContractReduceBase_::permuted_args()) {
+        // Permuted tiles cannot be packed along the inner dimension.
+        for(std::size_t i = 0ul; i < left.size(); ++i)
+          operator()(result, *left[i], *right[i]);
+      } else if(empty(result)) {
+        result = gemm(*left.front(), *right.front(), 1,
+            ContractReduceBase_::gemm_helper());
+        if(left.size() > 1ul)
+          gemm(result, std::vector<const Left*>(left.begin() + 1, left.end()),
+              std::vector<const Right*>(right.begin() + 1, right.end()),
+              1, ContractReduceBase_::gemm_helper());
+      } else {
+        gemm(result, left, right, 1,
+            ContractReduceBase_::gemm_helper());
+      }
+    }
+
   }; // class ContractReduce
 
 } // namespace TiledArray
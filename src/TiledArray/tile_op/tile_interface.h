@@ -27,6 +27,7 @@
 #define TILEDARRAY_NONINTRUSIVE_API_TENSOR_H__INCLUDED
 
 #include <TiledArray/type_traits.h>
+#include <TiledArray/error.h>
 
 namespace TiledArray {
 
@@ -858,6 +859,104 @@ namespace TiledArray {
     return result.gemm(left, right, factor, gemm_config);
   }
 
+  namespace detail {
+
+    template <typename Result, typename Left, typename Right, typename Scalar>
+    inline auto gemm_permuted(Result& result, const Left& left,
+        const Permutation& left_perm, const Right& right,
+        const Permutation& right_perm, const Scalar factor,
+        const math::GemmHelper& gemm_config, int) ->
+        decltype(result.gemm(left, left_perm, right, right_perm, factor, gemm_config))
+    { return result.gemm(left, left_perm, right, right_perm, factor, gemm_config); }
+
+    template <typename Result, typename Left, typename Right, typename Scalar>
+    inline Result& gemm_permuted(Result& result, const Left&, const Permutation&,
+        const Right&, const Permutation&, const Scalar, const math::GemmHelper&, long)
+    {
+      TA_EXCEPTION("The tile type does not support the contraction of permuted tiles.");
+      return result;
+    }
+
+  } // namespace detail
+
+  /// Contract and scale permuted tile arguments to the result tile
+
+  /// The contraction is done as if \c left and \c right were permuted by
+  /// \c left_perm and \c right_perm , respectively, before the GEMM operation
+  /// defined by \c gemm_config, but the permuted tiles are not formed. An
+  /// empty \c result is initialized to zero.
+  /// \tparam Result The result tile type
+  /// \tparam Left The left-hand tile type
+  /// \tparam Right The right-hand tile type
+  /// \tparam Scalar A scalar type
+  /// \param result The contracted result
+  /// \param left The left-hand argument to be contracted
+  /// \param left_perm The permutation of the left-hand argument
+  /// \param right The right-hand argument to be contracted
+  /// \param right_perm The permutation of the right-hand argument
+  /// \param factor The scaling factor
+  /// \param gemm_config A helper object used to simplify gemm operations
+  /// \return A tile that is equal to
+  /// <tt>result += (left_perm ^ left * right_perm ^ right) * factor</tt>
+  /// \throw TiledArray::Exception When the tile type does not support the
+  /// contraction of permuted tiles.
+  template <typename Result, typename Left, typename Right, typename Scalar,
+      typename std::enable_if<TiledArray::detail::is_numeric<Scalar>::value>::type* = nullptr>
+  inline Result& gemm(Result& result, const Left& left, const Permutation& left_perm,
+      const Right& right, const Permutation& right_perm, const Scalar factor,
+      const math::GemmHelper& gemm_config)
+  {
+    return detail::gemm_permuted(result, left, left_perm, right, right_perm,
+        factor, gemm_config, 0);
+  }
+
+  namespace detail {
+
+    template <typename Result, typename Left, typename Right, typename Scalar>
+    inline auto gemm_batch(Result& result, const std::vector<const Left*>& left,
+        const std::vector<const Right*>& right, const Scalar factor,
+        const math::GemmHelper& gemm_config, int) ->
+        decltype(result.gemm(left, right, factor, gemm_config))
+    { return result.gemm(left, right, factor, gemm_config); }
+
+    template <typename Result, typename Left, typename Right, typename Scalar>
+    inline Result& gemm_batch(Result& result, const std::vector<const Left*>& left,
+        const std::vector<const Right*>& right, const Scalar factor,
+        const math::GemmHelper& gemm_config, long)
+    {
+      for(std::size_t i = 0ul; i < left.size(); ++i)
+        gemm(result, *left[i], *right[i], factor, gemm_config);
+      return result;
+    }
+
+  } // namespace detail
+
+  /// Contract and scale a batch of tile argument pairs to the result tile
+
+  /// The contraction is done via a GEMM operation with fused indices as defined
+  /// by \c gemm_config. Tiles that provide a batched \c gemm member function
+  /// contract all pairs at once, otherwise the pairs are contracted one at a
+  /// time.
+  /// \tparam Result The result tile type
+  /// \tparam Left The left-hand tile type
+  /// \tparam Right The right-hand tile type
+  /// \tparam Scalar A scalar type
+  /// \param result The contracted result
+  /// \param left The left-hand arguments to be contracted
+  /// \param right The right-hand arguments to be contracted
+  /// \param factor The scaling factor
+  /// \param gemm_config A helper object used to simplify gemm operations
+  /// \return A tile that is equal to <tt>result += sum_i (left[i] * right[i]) * factor</tt>
+  template <typename Result, typename Left, typename Right, typename Scalar,
+      typename std::enable_if<TiledArray::detail::is_numeric<Scalar>::value>::type* = nullptr>
+  inline Result& gemm(Result& result, const std::vector<const Left*>& left,
+      const std::vector<const Right*>& right, const Scalar factor,
+      const math::GemmHelper& gemm_config)
+  {
+    TA_ASSERT(left.size() == right.size());
+    return detail::gemm_batch(result, left, right, factor, gemm_config, 0);
+  }
+
 
   // Reduction operations ------------------------------------------------------
 
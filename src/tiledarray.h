@@ -31,6 +31,7 @@
 // Array policy classes
 #include <TiledArray/policies/dense_policy.h>
 #include <TiledArray/policies/sparse_policy.h>
+#include <TiledArray/policies/compressed_sparse_policy.h>
 
 // Expression functionality
 #include <TiledArray/expressions/scal_expr.h>
@@ -43,6 +44,7 @@
 #include <TiledArray/conversions/make_array.h>
 
 // Process maps
+#include <TiledArray/pmap/cost_pmap.h>
 #include <TiledArray/pmap/hash_pmap.h>
 #include <TiledArray/pmap/replicated_pmap.h>
 
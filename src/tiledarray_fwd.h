@@ -32,6 +32,7 @@ namespace TiledArray {
   //TiledArray Policy
   class DensePolicy;
   class SparsePolicy;
+  class CompressedSparsePolicy;
 
   // TiledArray Tensors
   template<typename, typename>
@@ -118,4 +118,17 @@ BOOST_AUTO_TEST_CASE( local_group )
   }
 }
 
+BOOST_AUTO_TEST_CASE( local_ordinal )
+{
+  for(std::size_t tiles = 1ul; tiles < 100ul; ++tiles) {
+    TiledArray::detail::BlockedPmap pmap(* GlobalFixture::world, tiles);
+    BOOST_CHECK(pmap.has_local_ordinal());
+
+    // Check that the local ordinal is the position in the local tile list
+    std::size_t ordinal = 0ul;
+    for(detail::BlockedPmap::const_iterator it = pmap.begin(); it != pmap.end(); ++it, ++ordinal)
+      BOOST_CHECK_EQUAL(pmap.local_ordinal(*it), ordinal);
+  }
+}
+
 BOOST_AUTO_TEST_SUITE_END()
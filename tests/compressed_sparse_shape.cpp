@@ -0,0 +1,236 @@
+/*
+ *  This file is a part of TiledArray.
+ *  Copyright (C) 2016  Virginia Tech
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "TiledArray/compressed_sparse_shape.h"
+#include "tiledarray.h"
+#include "unit_test_config.h"
+#include "sparse_shape_fixture.h"
+
+using namespace TiledArray;
+
+struct CompressedSparseShapeFixture : public SparseShapeFixture {
+
+  CompressedSparseShapeFixture() :
+    left_norms(make_norm_tensor(tr, 0.1, 23)),
+    right_norms(make_norm_tensor(tr, 0.1, 82)),
+    dense_left(left_norms, tr),
+    dense_right(right_norms, tr),
+    compressed_left(left_norms, tr),
+    compressed_right(right_norms, tr)
+  { }
+
+  ~CompressedSparseShapeFixture() { }
+
+  // Check that a compressed shape is equal to the reference shape
+  static void check_shape(const CompressedSparseShape<float>& result,
+      const SparseShape<float>& reference, const float tolerance)
+  {
+    BOOST_REQUIRE(result.validate(reference.data().range()));
+
+    std::size_t nnz = 0ul;
+    for(std::size_t i = 0ul; i < reference.data().size(); ++i) {
+      BOOST_CHECK_CLOSE(result[i], reference[i], tolerance);
+      BOOST_CHECK_EQUAL(result.is_zero(i), reference.is_zero(i));
+      if(! reference.is_zero(i))
+        ++nnz;
+    }
+
+    BOOST_CHECK_EQUAL(result.nnz(), nnz);
+    BOOST_CHECK_CLOSE(result.sparsity(), reference.sparsity(), tolerance);
+  }
+
+  Tensor<float> left_norms;
+  Tensor<float> right_norms;
+  SparseShape<float> dense_left;
+  SparseShape<float> dense_right;
+  CompressedSparseShape<float> compressed_left;
+  CompressedSparseShape<float> compressed_right;
+}; // CompressedSparseShapeFixture
+
+BOOST_FIXTURE_TEST_SUITE( compressed_sparse_shape_suite, CompressedSparseShapeFixture )
+
+BOOST_AUTO_TEST_CASE( default_constructor )
+{
+  BOOST_CHECK_NO_THROW(CompressedSparseShape<float> x);
+  CompressedSparseShape<float> x;
+
+  BOOST_CHECK(x.empty());
+  BOOST_CHECK(! x.is_dense());
+  BOOST_CHECK(! x.validate(tr.tiles_range()));
+
+#ifdef TA_EXCEPTION_ERROR
+  BOOST_CHECK_THROW(x[0], Exception);
+  BOOST_CHECK_THROW(x.perm(perm), Exception);
+  BOOST_CHECK_THROW(x.scale(2.0), Exception);
+#endif // TA_EXCEPTION_ERROR
+}
+
+BOOST_AUTO_TEST_CASE( constructor )
+{
+  BOOST_CHECK(! compressed_left.empty());
+  BOOST_CHECK(compressed_left.validate(tr.tiles_range()));
+  check_shape(compressed_left, dense_left, tolerance);
+  BOOST_CHECK(compressed_left.nnz() < tr.tiles_range().volume());
+
+  // Check the sparse constructor with repeated tile indices
+  std::vector<CompressedSparseShape<float>::nonzero_type> tile_norms;
+  for(std::size_t i = 0ul; i < left_norms.size(); ++i) {
+    if(left_norms[i] != 0.0f) {
+      tile_norms.emplace_back(i, left_norms[i] * 0.25f);
+      tile_norms.emplace_back(i, left_norms[i] * 0.75f);
+    }
+  }
+  std::reverse(tile_norms.begin(), tile_norms.end());
+  CompressedSparseShape<float> x(tile_norms, tr);
+  check_shape(x, dense_left, tolerance);
+}
+
+BOOST_AUTO_TEST_CASE( comm_constructor )
+{
+  // Zero non-local tiles
+  Tensor<float> tile_norms = left_norms.clone();
+  TiledArray::detail::BlockedPmap pmap(*GlobalFixture::world, tr.tiles_range().volume());
+  for(Tensor<float>::size_type i = 0ul; i < tile_norms.size(); ++i)
+    if(! pmap.is_local(i))
+      tile_norms[i] = 0.0f;
+
+  CompressedSparseShape<float> x(*GlobalFixture::world, tile_norms, tr);
+  check_shape(x, dense_left, tolerance);
+}
+
+BOOST_AUTO_TEST_CASE( permute )
+{
+  check_shape(compressed_left.perm(perm), dense_left.perm(perm), tolerance);
+}
+
+BOOST_AUTO_TEST_CASE( block )
+{
+  std::vector<std::size_t> lower(tr.tiles_range().rank()), upper(tr.tiles_range().rank());
+  for(unsigned int i = 0u; i < tr.tiles_range().rank(); ++i) {
+    lower[i] = tr.tiles_range().lobound_data()[i] + 1ul;
+    upper[i] = tr.tiles_range().upbound_data()[i];
+  }
+
+  check_shape(compressed_left.block(lower, upper),
+      dense_left.block(lower, upper), tolerance);
+  check_shape(compressed_left.block(lower, upper, -2.5),
+      dense_left.block(lower, upper, -2.5), tolerance);
+  check_shape(compressed_left.block(lower, upper, perm),
+      dense_left.block(lower, upper, perm), tolerance);
+}
+
+BOOST_AUTO_TEST_CASE( update_block )
+{
+  std::vector<std::size_t> lower(tr.tiles_range().rank()), upper(tr.tiles_range().rank());
+  for(unsigned int i = 0u; i < tr.tiles_range().rank(); ++i) {
+    lower[i] = tr.tiles_range().lobound_data()[i] + 1ul;
+    upper[i] = tr.tiles_range().upbound_data()[i];
+  }
+
+  check_shape(
+      compressed_left.update_block(lower, upper,
+          compressed_right.block(lower, upper)),
+      dense_left.update_block(lower, upper, dense_right.block(lower, upper)),
+      tolerance);
+}
+
+BOOST_AUTO_TEST_CASE( mask )
+{
+  check_shape(compressed_left.mask(compressed_right),
+      dense_left.mask(dense_right), tolerance);
+}
+
+BOOST_AUTO_TEST_CASE( transform )
+{
+  // Scale the norms of the non-zero tiles by a factor that depends on the
+  // position of the tile in the compressed data
+  auto op = [](const std::vector<float>& norms) {
+    std::vector<float> result(norms);
+    for(std::size_t i = 0ul; i < result.size(); ++i)
+      result[i] *= (i % 2 == 0 ? 2.0f : 0.5f);
+    return result;
+  };
+  auto dense_op = [&](const Tensor<float>& norms) {
+    Tensor<float> result = norms.clone();
+    std::size_t i = 0ul;
+    for(const auto ordinal : compressed_left.nonzero_ordinals())
+      result[ordinal] *= (i++ % 2 == 0 ? 2.0f : 0.5f);
+    return result;
+  };
+
+  check_shape(compressed_left.transform(op), dense_left.transform(dense_op),
+      tolerance);
+}
+
+BOOST_AUTO_TEST_CASE( dense_data )
+{
+  const Tensor<float> norms = compressed_left.dense_data();
+  BOOST_CHECK_EQUAL(norms.range(), tr.tiles_range());
+  for(std::size_t i = 0ul; i < norms.size(); ++i)
+    BOOST_CHECK_CLOSE(norms[i], dense_left[i], tolerance);
+}
+
+BOOST_AUTO_TEST_CASE( scale )
+{
+  check_shape(compressed_left.scale(-4.1), dense_left.scale(-4.1), tolerance);
+  check_shape(compressed_left.scale(-4.1, perm),
+      dense_left.scale(-4.1, perm), tolerance);
+}
+
+BOOST_AUTO_TEST_CASE( add )
+{
+  check_shape(compressed_left.add(compressed_right),
+      dense_left.add(dense_right), tolerance);
+  check_shape(compressed_left.add(compressed_right, -2.2),
+      dense_left.add(dense_right, -2.2), tolerance);
+  check_shape(compressed_left.add(compressed_right, -2.2, perm),
+      dense_left.add(dense_right, -2.2, perm), tolerance);
+  check_shape(compressed_left.subt(compressed_right, perm),
+      dense_left.subt(dense_right, perm), tolerance);
+  check_shape(compressed_left.add(-8.8f), dense_left.add(-8.8f), tolerance);
+}
+
+BOOST_AUTO_TEST_CASE( mult )
+{
+  check_shape(compressed_left.mult(compressed_right),
+      dense_left.mult(dense_right), tolerance);
+  check_shape(compressed_left.mult(compressed_right, -2.2, perm),
+      dense_left.mult(dense_right, -2.2, perm), tolerance);
+}
+
+BOOST_AUTO_TEST_CASE( gemm )
+{
+  const unsigned int rank = tr.tiles_range().rank();
+
+  // Contraction over the inner dimensions
+  math::GemmHelper gemm_helper(madness::cblas::NoTrans, madness::cblas::NoTrans,
+      2u, rank, rank);
+  check_shape(compressed_left.gemm(compressed_right, -7.2, gemm_helper),
+      dense_left.gemm(dense_right, -7.2, gemm_helper), 0.001);
+  check_shape(compressed_left.gemm(compressed_right, -7.2, gemm_helper, Permutation({1,0})),
+      dense_left.gemm(dense_right, -7.2, gemm_helper, Permutation({1,0})), 0.001);
+
+  // Outer product
+  math::GemmHelper outer_helper(madness::cblas::NoTrans, madness::cblas::NoTrans,
+      rank + rank, rank, rank);
+  check_shape(compressed_left.gemm(compressed_right, 2.0, outer_helper),
+      dense_left.gemm(dense_right, 2.0, outer_helper), 0.001);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,160 @@
+/*
+ *  This file is a part of TiledArray.
+ *  Copyright (C) 2016  Virginia Tech
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "TiledArray/pmap/cost_pmap.h"
+#include "tiledarray.h"
+#include "unit_test_config.h"
+#include "global_fixture.h"
+#include "range_fixture.h"
+#include <numeric>
+
+using namespace TiledArray;
+
+struct CostPmapFixture : public TiledRangeFixture {
+
+  CostPmapFixture() { }
+
+  // Make a list of tile costs, where every third tile is zero
+  static std::vector<double> make_costs(const std::size_t tiles) {
+    std::vector<double> costs(tiles, 0.0);
+    for(std::size_t tile = 0ul; tile < tiles; ++tile)
+      if(tile % 3ul)
+        costs[tile] = double((tile * 37ul) % 101ul);
+    return costs;
+  }
+
+};
+
+// =============================================================================
+// CostPmap Test Suite
+
+
+BOOST_FIXTURE_TEST_SUITE( cost_pmap_suite, CostPmapFixture )
+
+BOOST_AUTO_TEST_CASE( constructor )
+{
+  for(std::size_t tiles = 1ul; tiles < 100ul; ++tiles) {
+    const Range range(std::vector<std::size_t>(1, tiles));
+    BOOST_REQUIRE_NO_THROW(TiledArray::detail::CostPmap pmap(* GlobalFixture::world, range, make_costs(tiles)));
+    TiledArray::detail::CostPmap pmap(* GlobalFixture::world, range, make_costs(tiles));
+    BOOST_CHECK_EQUAL(pmap.rank(), GlobalFixture::world->rank());
+    BOOST_CHECK_EQUAL(pmap.procs(), GlobalFixture::world->size());
+    BOOST_CHECK_EQUAL(pmap.size(), tiles);
+  }
+}
+
+BOOST_AUTO_TEST_CASE( owner )
+{
+  const std::size_t rank = GlobalFixture::world->rank();
+  const std::size_t size = GlobalFixture::world->size();
+
+  ProcessID* p_owner = new ProcessID[size];
+
+  // Check various pmap sizes
+  for(std::size_t tiles = 1ul; tiles < 100ul; ++tiles) {
+    const Range range(std::vector<std::size_t>(1, tiles));
+    TiledArray::detail::CostPmap pmap(* GlobalFixture::world, range, make_costs(tiles));
+
+    for(std::size_t tile = 0; tile < tiles; ++tile) {
+      std::fill_n(p_owner, size, 0);
+      p_owner[rank] = pmap.owner(tile);
+      // check that the value is in range
+      BOOST_CHECK_LT(p_owner[rank], size);
+      GlobalFixture::world->gop.sum(p_owner, size);
+
+      // Make sure everyone agrees on who owns what.
+      for(std::size_t p = 0ul; p < size; ++p)
+        BOOST_CHECK_EQUAL(p_owner[p], p_owner[rank]);
+    }
+  }
+
+  delete [] p_owner;
+}
+
+BOOST_AUTO_TEST_CASE( local_group )
+{
+  const Range& range = tr.tiles_range();
+  const std::vector<double> costs = make_costs(range.volume());
+  TiledArray::detail::CostPmap pmap(* GlobalFixture::world, range, costs);
+
+  // Check that all local elements map to this rank
+  std::size_t total_size = pmap.local_size();
+  double local_cost = 0.0;
+  for(detail::CostPmap::const_iterator it = pmap.begin(); it != pmap.end(); ++it) {
+    BOOST_CHECK_EQUAL(pmap.owner(*it), GlobalFixture::world->rank());
+    local_cost += costs[*it];
+  }
+  GlobalFixture::world->gop.sum(total_size);
+  BOOST_CHECK_EQUAL(total_size, range.volume());
+
+  // Check that the local cost is within one tile of the average cost
+  const double total_cost = std::accumulate(costs.begin(), costs.end(), 0.0);
+  const double max_cost = *std::max_element(costs.begin(), costs.end());
+  BOOST_CHECK_LE(local_cost, total_cost / GlobalFixture::world->size() + max_cost);
+}
+
+BOOST_AUTO_TEST_CASE( shape_costs )
+{
+  // Tiles that are zero in the shape have no cost
+  Tensor<float> tile_norms(tr.tiles_range(), 0.0f);
+  for(std::size_t i = 0ul; i < tile_norms.size(); i += 2ul)
+    tile_norms[i] = 1.0f;
+  SparseShape<float> shape(tile_norms, tr);
+
+  std::shared_ptr<Pmap> pmap =
+      TiledArray::detail::make_cost_pmap(* GlobalFixture::world, tr, shape);
+  BOOST_CHECK_EQUAL(pmap->size(), tr.tiles_range().volume());
+
+  std::size_t local_elements = 0ul;
+  for(Pmap::const_iterator it = pmap->begin(); it != pmap->end(); ++it)
+    if(! shape.is_zero(*it))
+      local_elements += tr.make_tile_range(*it).volume();
+  std::size_t total_elements = local_elements;
+  GlobalFixture::world->gop.sum(total_elements);
+
+  std::size_t nonzero_elements = 0ul;
+  std::size_t max_tile = 0ul;
+  for(std::size_t i = 0ul; i < tile_norms.size(); ++i) {
+    if(! shape.is_zero(i)) {
+      nonzero_elements += tr.make_tile_range(i).volume();
+      max_tile = std::max<std::size_t>(max_tile, tr.make_tile_range(i).volume());
+    }
+  }
+  BOOST_CHECK_EQUAL(total_elements, nonzero_elements);
+  BOOST_CHECK_LE(local_elements, nonzero_elements / GlobalFixture::world->size() + max_tile);
+
+  // The process map can be used to construct an array
+  BOOST_CHECK_NO_THROW(TSpArrayI array(* GlobalFixture::world, tr, shape, pmap));
+}
+
+BOOST_AUTO_TEST_CASE( local_ordinal )
+{
+  for(std::size_t tiles = 1ul; tiles < 100ul; ++tiles) {
+    const Range range(std::vector<std::size_t>(1, tiles));
+    TiledArray::detail::CostPmap pmap(* GlobalFixture::world, range, make_costs(tiles));
+    BOOST_CHECK(pmap.has_local_ordinal());
+
+    // Check that the local ordinal is the position in the local tile list
+    std::size_t ordinal = 0ul;
+    for(detail::CostPmap::const_iterator it = pmap.begin(); it != pmap.end(); ++it, ++ordinal)
+      BOOST_CHECK_EQUAL(pmap.local_ordinal(*it), ordinal);
+  }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
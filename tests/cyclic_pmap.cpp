@@ -180,5 +180,30 @@ BOOST_AUTO_TEST_CASE( local_group )
   }
 }
 
+BOOST_AUTO_TEST_CASE( local_ordinal )
+{
+  for(std::size_t x = 1ul; x < 10ul; ++x) {
+    for(std::size_t y = 1ul; y < 10ul; ++y) {
+      // Compute the limits for process rows
+      const std::size_t min_proc_rows =
+          std::max<std::size_t>(((GlobalFixture::world->size() + y - 1ul) / y), 1ul);
+      const std::size_t max_proc_rows = std::min<std::size_t>(GlobalFixture::world->size(), x);
+
+      // Compute process rows and process columns
+      const std::size_t p_rows = std::max<std::size_t>(min_proc_rows,
+          std::min<std::size_t>(std::sqrt(GlobalFixture::world->size() * x / y), max_proc_rows));
+      const std::size_t p_cols = GlobalFixture::world->size() / p_rows;
+
+      TiledArray::detail::CyclicPmap pmap(* GlobalFixture::world, x, y, p_rows, p_cols);
+      BOOST_CHECK(pmap.has_local_ordinal());
+
+      // Check that the local ordinal is the position in the local tile list
+      std::size_t ordinal = 0ul;
+      for(detail::CyclicPmap::const_iterator it = pmap.begin(); it != pmap.end(); ++it, ++ordinal)
+        BOOST_CHECK_EQUAL(pmap.local_ordinal(*it), ordinal);
+    }
+  }
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
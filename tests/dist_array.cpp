@@ -22,6 +22,8 @@
 #include "tiledarray.h"
 #include "unit_test_config.h"
 #include "../src/TiledArray/dist_array.h"
+#include <algorithm>
+#include <array>
 #include <random>
 #include <chrono>
 
@@ -277,5 +279,151 @@ BOOST_AUTO_TEST_CASE( make_replicated )
   }
 }
 
+BOOST_AUTO_TEST_CASE( make_replicated_large_tiles )
+{
+  // Alternate tiles that are larger than the maximum chunk size of the
+  // replicator, which are sent in their own messages, with small tiles.
+  const std::size_t large =
+      detail::Replicator<TArrayD>::max_chunk_bytes / sizeof(double) + 1ul;
+  std::vector<std::size_t> tiling(1ul, 0ul);
+  for(std::size_t i = 0ul; i < 2ul * world.size() + 2ul; ++i)
+    tiling.push_back(tiling.back() + (i % 2ul ? 16ul : large));
+  std::array<TiledRange1, 1> tr1 = {{ TiledRange1(tiling.begin(), tiling.end()) }};
+  TiledRange tr_large(tr1.begin(), tr1.end());
+
+  TArrayD array(world, tr_large);
+  for(auto it = array.pmap()->begin(); it != array.pmap()->end(); ++it)
+    array.set(*it, double(*it + 1ul));
+
+  BOOST_REQUIRE_NO_THROW(array.make_replicated());
+
+  // Check that all the data is local
+  for(std::size_t i = 0; i < array.size(); ++i) {
+    BOOST_CHECK(array.is_local(i));
+    const TArrayD::value_type tile = array.find(i).get();
+    BOOST_CHECK_EQUAL(tile.range(), tr_large.make_tile_range(i));
+    BOOST_CHECK(std::all_of(tile.begin(), tile.end(),
+        [=] (const double value) { return value == double(i + 1ul); }));
+  }
+}
+
+BOOST_AUTO_TEST_CASE( make_replicated_no_local_tiles )
+{
+  // Make a sparse array where only the tiles of the first process are
+  // non-zero, so the other processes do not have local tiles.
+  std::shared_ptr<SpArrayN::pmap_interface> pmap =
+      std::make_shared<detail::BlockedPmap>(world, tr.tiles_range().volume());
+  Tensor<float> norms(tr.tiles_range(), 0.0f);
+  for(std::size_t i = 0ul; i < norms.size(); ++i)
+    if(pmap->owner(i) == 0)
+      norms[i] = 1.0f;
+  SpArrayN as(world, tr, SparseShape<float>(norms, tr), pmap);
+  for(std::size_t i = 0ul; i < norms.size(); ++i)
+    if(as.is_local(i) && ! as.is_zero(i))
+      as.set(i, int(i) + 1);
+
+  BOOST_REQUIRE_NO_THROW(as.make_replicated());
+
+  for(std::size_t i = 0; i < as.size(); ++i) {
+    BOOST_CHECK(as.is_local(i));
+    BOOST_CHECK_EQUAL(as.is_zero(i), pmap->owner(i) != 0);
+    if(as.is_zero(i))
+      continue;
+    const SpArrayN::value_type tile = as.find(i).get();
+    BOOST_CHECK_EQUAL(tile.range(), as.trange().make_tile_range(i));
+    for(SpArrayN::value_type::const_iterator it = tile.begin(); it != tile.end(); ++it)
+      BOOST_CHECK_EQUAL(*it, int(i) + 1);
+  }
+
+  // Make a dense array with a single tile, so only one process has a local
+  // tile.
+  std::array<TiledRange1, 1> tr1 = {{ TiledRange1{0, 10} }};
+  TiledRange tr_single(tr1.begin(), tr1.end());
+  ArrayN ad(world, tr_single);
+  if(ad.is_local(0))
+    ad.set(0, 42);
+
+  BOOST_REQUIRE_NO_THROW(ad.make_replicated());
+
+  BOOST_CHECK(ad.is_local(0));
+  const ArrayN::value_type tile = ad.find(0).get();
+  BOOST_CHECK_EQUAL(tile.range(), tr_single.make_tile_range(0));
+  for(ArrayN::value_type::const_iterator it = tile.begin(); it != tile.end(); ++it)
+    BOOST_CHECK_EQUAL(*it, 42);
+}
+
+BOOST_AUTO_TEST_CASE( redistribute )
+{
+  // Get a copy of the original process map
+  std::shared_ptr<ArrayN::pmap_interface> distributed_pmap = a.pmap();
+
+  // Move the array to a new process map
+  std::shared_ptr<ArrayN::pmap_interface> pmap =
+      std::make_shared<detail::HashPmap>(world, a.size());
+  BOOST_REQUIRE_NO_THROW(a.redistribute(pmap));
+  BOOST_CHECK_EQUAL(a.pmap(), pmap);
+
+  // Check that the local tiles hold the data of the original owner
+  for(std::size_t i = 0; i < a.size(); ++i) {
+    BOOST_CHECK_EQUAL(a.owner(i), pmap->owner(i));
+    if(! a.is_local(i))
+      continue;
+    Future<ArrayN::value_type> tile = a.find(i);
+    BOOST_CHECK_EQUAL(tile.get().range(), a.trange().make_tile_range(i));
+    for(ArrayN::value_type::const_iterator it = tile.get().begin(); it != tile.get().end(); ++it)
+      BOOST_CHECK_EQUAL(*it, distributed_pmap->owner(i) + 1);
+  }
+
+  // Move a sparse array, where zero tiles are not sent
+  SpArrayN s(world, tr, SparseShape<float>(shape_tensor, tr), distributed_pmap);
+  for(std::size_t i = 0; i < s.size(); ++i)
+    if(s.is_local(i) && ! s.is_zero(i))
+      s.set(i, world.rank() + 1);
+  BOOST_REQUIRE_NO_THROW(s.redistribute(pmap));
+  for(std::size_t i = 0; i < s.size(); ++i) {
+    if(s.is_zero(i) || ! s.is_local(i))
+      continue;
+    Future<SpArrayN::value_type> tile = s.find(i);
+    for(SpArrayN::value_type::const_iterator it = tile.get().begin(); it != tile.get().end(); ++it)
+      BOOST_CHECK_EQUAL(*it, distributed_pmap->owner(i) + 1);
+  }
+}
+
+BOOST_AUTO_TEST_CASE( redistribute_replicated )
+{
+  // Construct a replicated array, where each process holds the same data
+  ArrayN r(world, tr, std::make_shared<detail::ReplicatedPmap>(world, tr.tiles_range().volume()));
+  for(std::size_t i = 0; i < r.size(); ++i)
+    r.set(i, int(i) + 1);
+
+  // Move the array to another replicated process map
+  std::shared_ptr<ArrayN::pmap_interface> replicated_pmap =
+      std::make_shared<detail::ReplicatedPmap>(world, r.size());
+  BOOST_REQUIRE_NO_THROW(r.redistribute(replicated_pmap));
+  BOOST_CHECK_EQUAL(r.pmap(), replicated_pmap);
+  for(std::size_t i = 0; i < r.size(); ++i) {
+    BOOST_CHECK(r.is_local(i));
+    Future<ArrayN::value_type> tile = r.find(i);
+    BOOST_CHECK_EQUAL(tile.get().range(), r.trange().make_tile_range(i));
+    for(ArrayN::value_type::const_iterator it = tile.get().begin(); it != tile.get().end(); ++it)
+      BOOST_CHECK_EQUAL(*it, int(i) + 1);
+  }
+
+  // Move the replicated array to a distributed process map
+  std::shared_ptr<ArrayN::pmap_interface> pmap =
+      std::make_shared<detail::HashPmap>(world, r.size());
+  BOOST_REQUIRE_NO_THROW(r.redistribute(pmap));
+  BOOST_CHECK_EQUAL(r.pmap(), pmap);
+  for(std::size_t i = 0; i < r.size(); ++i) {
+    BOOST_CHECK_EQUAL(r.owner(i), pmap->owner(i));
+    if(! r.is_local(i))
+      continue;
+    Future<ArrayN::value_type> tile = r.find(i);
+    for(ArrayN::value_type::const_iterator it = tile.get().begin(); it != tile.get().end(); ++it)
+      BOOST_CHECK_EQUAL(*it, int(i) + 1);
+  }
+  world.gop.fence();
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
@@ -426,4 +426,70 @@ BOOST_AUTO_TEST_CASE( sparse_eval )
 
 }
 
+BOOST_AUTO_TEST_CASE( adaptive_depth )
+{
+  typedef ContractReduce<TensorI, TensorI, int> op_type;
+  typedef detail::Summa<array_eval_type, array_eval_type, op_type, DensePolicy> summa_type;
+  World& world = *GlobalFixture::world;
+
+  // Construct matrices with many thin inner tiles, such that the local result
+  // tiles are larger than the argument tiles of two iterations.
+  const TiledRange1 outer{ 0, 8, 16, 24, 32 };
+  const TiledRange1 inner{ 0, 1, 2, 3, 4, 5, 6, 7, 8 };
+  TArrayI a(world, TiledRange{ outer, inner });
+  TArrayI b(world, TiledRange{ inner, outer });
+  rand_fill_array(a);
+  rand_fill_array(b);
+
+  const TiledRange c_tr{ outer, outer };
+  const detail::ProcGrid grid(world, 4ul, 4ul, 32ul, 32ul);
+  array_eval_type a_arg = make_array_eval(a, world, DenseShape(),
+      grid.make_row_phase_pmap(8ul), Permutation(), make_array_noop());
+  array_eval_type b_arg = make_array_eval(b, world, DenseShape(),
+      grid.make_col_phase_pmap(8ul), Permutation(), make_array_noop());
+  const std::shared_ptr<Pmap> c_pmap(new detail::BlockedPmap(world, 16ul));
+
+  const matrix_type reference = copy_to_matrix(a, 1) * copy_to_matrix(b, 1);
+
+  // Evaluate the contraction with a memory bound, check the result, and
+  // return the final pipeline depth
+  auto eval = [&] (const std::size_t max_memory) -> std::size_t {
+    const std::size_t default_max_memory = summa_type::max_memory();
+    summa_type::max_memory(max_memory);
+
+    std::shared_ptr<summa_type> summa(new summa_type(a_arg, b_arg, world,
+        c_tr, DenseShape(), c_pmap, Permutation(), make_contract(2u, 2u, 2u),
+        8ul, grid));
+    detail::DistEval<TensorI, DensePolicy> contract(summa);
+    BOOST_REQUIRE_NO_THROW(contract.eval());
+    BOOST_REQUIRE_NO_THROW(contract.wait());
+
+    for(auto index : *contract.pmap()) {
+      const TensorI tile = contract.get(index).get();
+      BOOST_CHECK(eigen_map(tile) == reference.block(tile.range().lobound_data()[0],
+          tile.range().lobound_data()[1], tile.range().extent_data()[0],
+          tile.range().extent_data()[1]));
+    }
+    world.gop.fence();
+
+    summa_type::max_memory(default_max_memory);
+    return summa->depth();
+  };
+
+  // The pipeline grows to one iteration per inner tile when the budget is
+  // large.
+  const std::size_t large_depth = eval(1ul << 30);
+
+  // The initial depth of two iterations is computed from the average tile
+  // size, and the pipeline shrinks to one iteration because the result
+  // tiles of the pending reductions exceed the budget.
+  const std::size_t small_depth = eval(2ul * 8ul * sizeof(int) *
+      (grid.local_rows() + grid.local_cols()));
+
+  if(grid.local_size() > 0ul) {
+    BOOST_CHECK_EQUAL(large_depth, 8ul);
+    BOOST_CHECK_EQUAL(small_depth, 1ul);
+  }
+}
+
 BOOST_AUTO_TEST_SUITE_END()
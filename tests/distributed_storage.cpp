@@ -99,6 +99,38 @@ BOOST_AUTO_TEST_CASE( set_value )
 #endif // TA_EXCEPTION_ERROR
 }
 
+BOOST_AUTO_TEST_CASE( indirect_pmap )
+{
+  // A process map without a direct local ordinal uses the hash map storage
+  std::shared_ptr<detail::HashPmap> hash_pmap =
+      std::make_shared<detail::HashPmap>(world, 10);
+  BOOST_REQUIRE(! hash_pmap->has_local_ordinal());
+  Storage s(world, 10, hash_pmap);
+
+  // Set local elements with values and futures
+  std::vector<std::pair<std::size_t, Future<int> > > futures;
+  for(std::size_t i = 0; i < s.max_size(); ++i) {
+    if(! s.is_local(i))
+      continue;
+    if(i % 2ul) {
+      futures.emplace_back(i, Future<int>());
+      s.set(i, futures.back().second);
+    } else {
+      s.set(i, int(i));
+    }
+  }
+  for(std::size_t i = 0ul; i < futures.size(); ++i)
+    futures[i].second.set(int(futures[i].first));
+  world.gop.fence();
+
+  std::size_t n = s.size();
+  world.gop.sum(n);
+  BOOST_CHECK_EQUAL(n, s.max_size());
+  for(std::size_t i = 0; i < s.max_size(); ++i)
+    BOOST_CHECK_EQUAL(s.get(i).get(), int(i));
+  world.gop.fence();
+}
+
 BOOST_AUTO_TEST_CASE( array_operator )
 {
   // Check that elements are inserted properly for access requests.
@@ -121,5 +153,108 @@ BOOST_AUTO_TEST_CASE( array_operator )
 #endif // TA_EXCEPTION_ERROR
 }
 
+BOOST_AUTO_TEST_CASE( remote_cache )
+{
+  for(std::size_t i = 0; i < t.max_size(); ++i)
+    if(t.is_local(i))
+      t.set(i, i);
+  world.gop.fence();
+
+  t.set_remote_cache(t.max_size() * sizeof(int));
+
+  // Count the remote elements
+  std::size_t remote = 0ul;
+  for(std::size_t i = 0; i < t.max_size(); ++i)
+    if(! t.is_local(i))
+      ++remote;
+
+  // Get all elements twice, where the second request of remote elements
+  // should be served by the cache.
+  for(std::size_t pass = 0ul; pass < 2ul; ++pass)
+    for(std::size_t i = 0; i < t.max_size(); ++i)
+      BOOST_CHECK_EQUAL(t.get(i).get(), int(i));
+  BOOST_CHECK_EQUAL(t.remote_cache_misses(), remote);
+  BOOST_CHECK_EQUAL(t.remote_cache_hits(), remote);
+
+  // Check that the cache is invalidated by a fence
+  world.gop.fence();
+  for(std::size_t i = 0; i < t.max_size(); ++i)
+    BOOST_CHECK_EQUAL(t.get(i).get(), int(i));
+  BOOST_CHECK_EQUAL(t.remote_cache_misses(), 2ul * remote);
+  BOOST_CHECK_EQUAL(t.remote_cache_hits(), remote);
+  world.gop.fence();
+
+  // Check that the least recently used elements are evicted when the cache
+  // is full.
+  t.set_remote_cache(sizeof(int));
+  for(std::size_t i = 0; i < t.max_size(); ++i)
+    t.get(i).get();
+  for(std::size_t i = 0; i < t.max_size(); ++i)
+    t.get(i).get();
+  if(remote > 1ul) {
+    BOOST_CHECK_EQUAL(t.remote_cache_misses(), 2ul * remote);
+    BOOST_CHECK_EQUAL(t.remote_cache_hits(), 0ul);
+  }
+
+  // Check that disabled caches do not count requests
+  t.set_remote_cache(0ul);
+  for(std::size_t i = 0; i < t.max_size(); ++i)
+    t.get(i).get();
+  BOOST_CHECK_EQUAL(t.remote_cache_misses(), 0ul);
+  BOOST_CHECK_EQUAL(t.remote_cache_hits(), 0ul);
+}
+
+BOOST_AUTO_TEST_CASE( aggregation )
+{
+  t.set_aggregation(3ul);
+
+  // Set all elements from process 0, so remote elements are set in batches
+  if(world.rank() == 0)
+    for(std::size_t i = 0; i < t.max_size(); ++i)
+      t.set(i, i);
+  world.gop.fence();
+
+  std::size_t n = t.size();
+  world.gop.sum(n);
+  BOOST_CHECK_EQUAL(n, t.max_size());
+
+  // Get all elements with batched requests
+  std::vector<Storage::future> elements;
+  for(std::size_t i = 0; i < t.max_size(); ++i)
+    elements.push_back(t.get(i));
+  t.flush();
+  for(std::size_t i = 0; i < t.max_size(); ++i)
+    BOOST_CHECK_EQUAL(elements[i].get(), int(i));
+
+  world.gop.fence();
+  t.set_aggregation(0ul);
+}
+
+BOOST_AUTO_TEST_CASE( spill )
+{
+  // Keep at most two elements in memory
+  Storage s(world, 10, pmap);
+  s.set_spill(2ul * sizeof(int));
+
+  for(std::size_t i = 0; i < s.max_size(); ++i)
+    if(s.is_local(i))
+      s.set(i, i);
+  world.gop.fence();
+  BOOST_CHECK_LE(s.resident_bytes(), 2ul * sizeof(int));
+
+  // Check that spilled elements are read back
+  for(std::size_t pass = 0ul; pass < 2ul; ++pass) {
+    for(std::size_t i = 0; i < s.max_size(); ++i)
+      s.prefetch(i);
+    for(std::size_t i = 0; i < s.max_size(); ++i)
+      BOOST_CHECK_EQUAL(s.get(i).get(), int(i));
+  }
+  BOOST_CHECK_LE(s.resident_bytes(), 2ul * sizeof(int));
+
+  std::size_t n = s.size();
+  world.gop.sum(n);
+  BOOST_CHECK_EQUAL(n, s.max_size());
+  world.gop.fence();
+}
 
 BOOST_AUTO_TEST_SUITE_END()
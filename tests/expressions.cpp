@@ -23,6 +23,7 @@
  *
  */
 
+#include <numeric>
 #include "tiledarray.h"
 #include "unit_test_config.h"
 #include "range_fixture.h"
@@ -1213,6 +1214,126 @@ BOOST_AUTO_TEST_CASE( scale_cont )
 }
 
 
+BOOST_AUTO_TEST_CASE( plan )
+{
+  const std::size_t m = a.trange().elements_range().extent_data()[0];
+  const std::size_t k = a.trange().elements_range().extent_data()[1] * a.trange().elements_range().extent_data()[2];
+  const std::size_t n = b.trange().elements_range().extent_data()[0];
+  const std::size_t volume = a.trange().elements_range().volume();
+
+  // Plan a contraction
+  auto cont_plan = (a("i,b,c") * b("j,b,c")).plan(w("i,j"));
+  BOOST_CHECK_EQUAL(cont_plan.flops, 2.0 * m * n * k);
+  BOOST_CHECK_EQUAL(std::accumulate(cont_plan.rank_memory.begin(),
+      cont_plan.rank_memory.end(), 0ul), m * n * sizeof(int));
+  BOOST_CHECK_EQUAL(cont_plan.memory, *std::max_element(
+      cont_plan.rank_memory.begin(), cont_plan.rank_memory.end()));
+  if(GlobalFixture::world->size() == 1)
+    BOOST_CHECK_EQUAL(cont_plan.broadcast_bytes, 0ul);
+
+  // Check that the plan matches the evaluated result
+  BOOST_REQUIRE_NO_THROW(w("i,j") = a("i,b,c") * b("j,b,c"));
+  BOOST_CHECK_EQUAL(cont_plan.trange, w.trange());
+
+  // Plan element-wise expressions
+  auto add_plan = (a("a,b,c") + b("a,b,c")).plan(c("a,b,c"));
+  BOOST_CHECK_EQUAL(add_plan.flops, double(volume));
+  BOOST_CHECK_EQUAL(std::accumulate(add_plan.rank_memory.begin(),
+      add_plan.rank_memory.end(), 0ul), volume * sizeof(int));
+  BOOST_CHECK_EQUAL(add_plan.broadcast_bytes, 0ul);
+  BOOST_CHECK_EQUAL(add_plan.trange, a.trange());
+
+  auto scale_plan = (2 * a("a,b,c")).plan(c("c,b,a"));
+  BOOST_CHECK_EQUAL(scale_plan.flops, double(volume));
+  BOOST_CHECK_EQUAL(std::accumulate(scale_plan.rank_memory.begin(),
+      scale_plan.rank_memory.end(), 0ul), volume * sizeof(int));
+  BOOST_CHECK_EQUAL(scale_plan.trange, Permutation({2,1,0}) * a.trange());
+}
+
+BOOST_AUTO_TEST_CASE( cont_plan_cache )
+{
+  typedef expressions::ContPlanCache<TArrayI::trange_type, TArrayI::shape_type> plan_cache;
+
+  // Evaluate a contraction without the plan cache for reference
+  const std::size_t capacity = plan_cache::capacity();
+  plan_cache::capacity(0ul);
+  BOOST_REQUIRE_NO_THROW(w("i,j") = a("i,b,c") * b("j,b,c"));
+  BOOST_CHECK_EQUAL(plan_cache::size(), 0ul);
+  Eigen::MatrixXi reference = make_matrix(w);
+
+  // Check that repeated contractions reuse a single plan
+  plan_cache::capacity(capacity);
+  for(int iter = 0; iter < 3; ++iter) {
+    TArrayI result;
+    BOOST_REQUIRE_NO_THROW(result("i,j") = a("i,b,c") * b("j,b,c"));
+    BOOST_CHECK_EQUAL(plan_cache::size(), 1ul);
+    BOOST_CHECK_EQUAL(result.trange(), w.trange());
+    BOOST_CHECK(make_matrix(result) == reference);
+  }
+
+  // A different contraction adds a new plan
+  BOOST_REQUIRE_NO_THROW(w("i,j") = 2 * (a("i,b,c") * b("j,b,c")));
+  BOOST_CHECK_EQUAL(plan_cache::size(), 2ul);
+
+  plan_cache::clear();
+  BOOST_CHECK_EQUAL(plan_cache::size(), 0ul);
+}
+
+BOOST_AUTO_TEST_CASE( cont_plan_cache_shape_change )
+{
+  typedef expressions::ContPlanCache<TSpArrayI::trange_type, TSpArrayI::shape_type> plan_cache;
+  World& world = *GlobalFixture::world;
+  const TiledRange trange = { {0, 2, 5, 10, 17, 28, 41},
+                              {0, 2, 5, 10, 17, 28, 41} };
+
+  // Construct a sparse array where tile (i,j) is zero when (i + j) % shift == 0
+  auto make_array = [&] (const std::size_t shift) -> TSpArrayI {
+    Tensor<float> norms(trange.tiles_range(), 1.0f);
+    for(std::size_t i = 0ul; i < norms.size(); ++i)
+      if((i / 6ul + i % 6ul) % shift == 0ul)
+        norms[i] = 0.0f;
+    TSpArrayI array(world, trange, SparseShape<float>(norms, trange));
+    for(std::size_t i = 0ul; i < array.size(); ++i)
+      if(array.is_local(i) && ! array.is_zero(i))
+        array.set(i, make_rand_tile<TSpArrayI>(trange.make_tile_range(i)));
+    return array;
+  };
+
+  // Compute the result shape of a contraction without the plan cache
+  auto reference_shape = [&] (const TSpArrayI& left, const TSpArrayI& right) {
+    const std::size_t capacity = plan_cache::capacity();
+    plan_cache::capacity(0ul);
+    TSpArrayI result;
+    result("i,j") = left("i,k") * right("k,j");
+    plan_cache::capacity(capacity);
+    return result.shape();
+  };
+
+  plan_cache::clear();
+  TSpArrayI left = make_array(2ul);
+  TSpArrayI right = make_array(3ul);
+
+  // Repeated contractions with the same shapes reuse a single plan
+  for(int iter = 0; iter < 2; ++iter) {
+    TSpArrayI result;
+    BOOST_REQUIRE_NO_THROW(result("i,j") = left("i,k") * right("k,j"));
+    BOOST_CHECK_EQUAL(plan_cache::size(), 1ul);
+  }
+
+  // A contraction with a new argument shape replaces the plan, and the
+  // result shape is computed for the new shape
+  left = make_array(4ul);
+  TSpArrayI result;
+  BOOST_REQUIRE_NO_THROW(result("i,j") = left("i,k") * right("k,j"));
+  BOOST_CHECK_EQUAL(plan_cache::size(), 1ul);
+  const TSpArrayI::shape_type reference = reference_shape(left, right);
+  BOOST_CHECK_EQUAL_COLLECTIONS(result.shape().data().begin(),
+      result.shape().data().end(), reference.data().begin(),
+      reference.data().end());
+
+  plan_cache::clear();
+}
+
 BOOST_AUTO_TEST_CASE( cont_non_uniform1 )
 {
   // Construc the tiled range
@@ -1256,6 +1377,226 @@ BOOST_AUTO_TEST_CASE( cont_non_uniform1 )
   }
 }
 
+BOOST_AUTO_TEST_CASE( cont_summa_layers )
+{
+  // Construc the tiled range
+  std::array<std::size_t, 6> tiling1 = {{ 0, 1, 2, 3, 4, 5 }};
+  std::array<std::size_t, 2> tiling2 = {{ 0, 40 }};
+  TiledRange1 tr1_1(tiling1.begin(), tiling1.end());
+  TiledRange1 tr1_2(tiling2.begin(), tiling2.end());
+  std::array<TiledRange1, 4> tiling4 = {{ tr1_1, tr1_2, tr1_1, tr1_1 }};
+  TiledRange trange(tiling4.begin(), tiling4.end());
+
+  const std::size_t m = 5;
+  const std::size_t k = 40 * 5 * 5;
+  const std::size_t n = 5;
+
+  // Construct the test arguments
+  TArrayI left(*GlobalFixture::world, trange);
+  TArrayI right(*GlobalFixture::world, trange);
+
+  // Construct the reference matrices
+  TiledArray::EigenMatrixXi left_ref(m, k);
+  TiledArray::EigenMatrixXi right_ref(n, k);
+
+  // Initialize input
+  rand_fill_matrix_and_array(left_ref, left, 23);
+  rand_fill_matrix_and_array(right_ref, right, 42);
+
+  // Compute the reference result
+  TiledArray::EigenMatrixXi result_ref = 5 * left_ref * right_ref.transpose();
+
+  const unsigned int max_layers =
+      std::min<unsigned int>(GlobalFixture::world->size(), 4u);
+  for(unsigned int layers = 1u; layers <= max_layers; ++layers) {
+    // Compute the result to be tested
+    TArrayI result;
+    BOOST_REQUIRE_NO_THROW(result("x,y") =
+        (5 * left("x,i,j,k") * right("y,i,j,k")).set_summa_layers(layers));
+
+    // Check the result
+    for(TArrayI::iterator it = result.begin(); it != result.end(); ++it) {
+      const TArrayI::value_type tile = *it;
+      for(Range::const_iterator rit = tile.range().begin(); rit != tile.range().end(); ++rit) {
+        const std::size_t elem_index = result.elements_range().ordinal(*rit);
+        BOOST_CHECK_EQUAL(result_ref.array()(elem_index), tile[*rit]);
+      }
+    }
+  }
+}
+
+
+BOOST_AUTO_TEST_CASE( cont_summa_screen )
+{
+  World& world = *GlobalFixture::world;
+  const TiledRange trange = { {0, 2, 4, 6, 8}, {0, 2, 4, 6, 8} };
+
+  // Construct an array of constant tiles where the tiles of the first inner
+  // tile index have a small value, such that the norm products of the tile
+  // pairs for k = 0 are below the screening threshold.
+  auto make_array = [&] (const bool left) -> TSpArrayD {
+    auto value = [=] (const std::size_t i) {
+      return ((left ? i % 4ul : i / 4ul) == 0ul ? 1.0e-5 : 1.0);
+    };
+    Tensor<float> norms(trange.tiles_range());
+    for(std::size_t i = 0ul; i < norms.size(); ++i)
+      norms[i] = 2.0 * value(i);
+    TSpArrayD array(world, trange, SparseShape<float>(norms, trange));
+    for(std::size_t i = 0ul; i < array.size(); ++i)
+      if(array.is_local(i))
+        array.set(i, TSpArrayD::value_type(trange.make_tile_range(i), value(i)));
+    return array;
+  };
+
+  TSpArrayD left = make_array(true);
+  TSpArrayD right = make_array(false);
+
+  const bool screen = detail::summa_screen();
+  detail::SummaScreenStatistics& stats = detail::summa_screen_statistics();
+
+  // Compute the reference result without screening
+  detail::summa_screen() = false;
+  TSpArrayD reference;
+  BOOST_REQUIRE_NO_THROW(reference("i,j") = left("i,k") * right("k,j"));
+  world.gop.fence();
+
+  // Compute the result with screening
+  std::size_t counters[2] = { stats.pairs, stats.flops };
+  detail::summa_screen() = true;
+  TSpArrayD result;
+  BOOST_REQUIRE_NO_THROW(result("i,j") = left("i,k") * right("k,j"));
+  world.gop.fence();
+  detail::summa_screen() = screen;
+
+  // Each of the 16 result tiles skips the k = 0 pair, which is
+  // 2 * 2 * 2 * 2 = 16 floating point operations.
+  counters[0] = stats.pairs - counters[0];
+  counters[1] = stats.flops - counters[1];
+  world.gop.sum(counters, 2);
+  BOOST_CHECK_EQUAL(counters[0], 16ul);
+  BOOST_CHECK_EQUAL(counters[1], 16ul * 16ul);
+
+  // Check that only the negligible contributions are missing from the result
+  for(std::size_t i = 0ul; i < result.size(); ++i) {
+    BOOST_CHECK(! result.is_zero(i));
+    if(! result.is_local(i))
+      continue;
+
+    const TSpArrayD::value_type tile = result.find(i).get();
+    const TSpArrayD::value_type reference_tile = reference.find(i).get();
+    for(std::size_t j = 0ul; j < tile.size(); ++j) {
+      BOOST_CHECK_EQUAL(tile[j], 6.0);
+      BOOST_CHECK_CLOSE(reference_tile[j], 6.0, 1.0e-6);
+    }
+  }
+}
+
+BOOST_AUTO_TEST_CASE( compressed_sparse )
+{
+  typedef DistArray<TSpArrayD::value_type, CompressedSparsePolicy> TCspArrayD;
+
+  World& world = *GlobalFixture::world;
+  const TiledRange trange = { {0, 2, 5, 9, 14}, {0, 3, 5, 8, 12} };
+
+  // Construct the same array with a block sparse shape and a compressed
+  // sparse shape, where every third tile is zero and the other tiles are
+  // constant.
+  auto make_arrays = [&] (const std::size_t seed, TSpArrayD& sparse,
+      TCspArrayD& compressed)
+  {
+    auto is_zero = [=] (const std::size_t i) { return (i + seed) % 3ul == 0ul; };
+    auto value = [=] (const std::size_t i) { return double((i * seed) % 7ul + 1ul); };
+
+    Tensor<float> norms(trange.tiles_range(), 0.0f);
+    std::vector<CompressedSparseShape<float>::nonzero_type> nonzero_norms;
+    for(std::size_t i = 0ul; i < norms.size(); ++i) {
+      if(is_zero(i))
+        continue;
+      norms[i] = value(i) * std::sqrt(double(trange.make_tile_range(i).volume()));
+      nonzero_norms.emplace_back(i, norms[i]);
+    }
+
+    sparse = TSpArrayD(world, trange, SparseShape<float>(norms, trange));
+    compressed = TCspArrayD(world, trange,
+        CompressedSparseShape<float>(nonzero_norms, trange));
+    for(std::size_t i = 0ul; i < norms.size(); ++i) {
+      if(is_zero(i))
+        continue;
+      const TSpArrayD::value_type tile(trange.make_tile_range(i), value(i));
+      if(sparse.is_local(i))
+        sparse.set(i, tile.clone());
+      if(compressed.is_local(i))
+        compressed.set(i, tile.clone());
+    }
+  };
+
+  // Check that the compressed sparse result is equal to the block sparse
+  // reference
+  auto check = [&] (const TCspArrayD& result, const TSpArrayD& reference) {
+    world.gop.fence();
+    BOOST_REQUIRE(result.trange() == reference.trange());
+    for(std::size_t i = 0ul; i < result.size(); ++i) {
+      BOOST_CHECK_EQUAL(result.is_zero(i), reference.is_zero(i));
+      if(result.is_zero(i) || reference.is_zero(i) || ! result.is_local(i))
+        continue;
+
+      const TSpArrayD::value_type tile = result.find(i).get();
+      const TSpArrayD::value_type reference_tile = reference.find(i).get();
+      BOOST_REQUIRE(tile.range() == reference_tile.range());
+      for(std::size_t j = 0ul; j < tile.size(); ++j)
+        BOOST_CHECK_EQUAL(tile[j], reference_tile[j]);
+    }
+  };
+
+  TSpArrayD sparse_a, sparse_b;
+  TCspArrayD compressed_a, compressed_b;
+  make_arrays(1ul, sparse_a, compressed_a);
+  make_arrays(2ul, sparse_b, compressed_b);
+  check(compressed_a, sparse_a);
+  check(compressed_b, sparse_b);
+
+  TSpArrayD sparse_add, sparse_mult, sparse_perm, sparse_cont;
+  TCspArrayD compressed_add, compressed_mult, compressed_perm, compressed_cont;
+
+  BOOST_REQUIRE_NO_THROW(compressed_add("i,j") = 2 * compressed_a("i,j") + compressed_b("i,j"));
+  sparse_add("i,j") = 2 * sparse_a("i,j") + sparse_b("i,j");
+  check(compressed_add, sparse_add);
+
+  BOOST_REQUIRE_NO_THROW(compressed_mult("i,j") = compressed_a("i,j") * compressed_b("i,j"));
+  sparse_mult("i,j") = sparse_a("i,j") * sparse_b("i,j");
+  check(compressed_mult, sparse_mult);
+
+  BOOST_REQUIRE_NO_THROW(compressed_perm("j,i") = compressed_a("i,j") - compressed_b("i,j"));
+  sparse_perm("j,i") = sparse_a("i,j") - sparse_b("i,j");
+  check(compressed_perm, sparse_perm);
+
+  BOOST_REQUIRE_NO_THROW(compressed_cont("i,j") = compressed_a("i,k") * compressed_b("j,k"));
+  sparse_cont("i,j") = sparse_a("i,k") * sparse_b("j,k");
+  check(compressed_cont, sparse_cont);
+
+  // Check the conversions
+  check(to_compressed_sparse(sparse_mult), sparse_mult);
+  check(to_compressed_sparse(to_dense(compressed_mult)), sparse_mult);
+  TSpArrayD converted = to_sparse(compressed_mult);
+  world.gop.fence();
+  for(std::size_t i = 0ul; i < converted.size(); ++i)
+    BOOST_CHECK_EQUAL(converted.is_zero(i), sparse_mult.is_zero(i));
+
+  // Zero the tiles of the first tile row with foreach, but keep their norms,
+  // so that the tiles are removed by truncate only.
+  TCspArrayD result = foreach(compressed_mult,
+      [] (TSpArrayD::value_type& result_tile, const TSpArrayD::value_type& arg_tile) -> float {
+        result_tile = (arg_tile.range().lobound_data()[0] == 0 ?
+            TSpArrayD::value_type(arg_tile.range(), 0.0) : arg_tile.clone());
+        return arg_tile.norm();
+      });
+  result.truncate();
+  world.gop.fence();
+  for(std::size_t i = 0ul; i < result.size(); ++i)
+    BOOST_CHECK_EQUAL(result.is_zero(i),
+        (i < trange.tiles_range().extent_data()[1]) || sparse_mult.is_zero(i));
+}
+
 
 BOOST_AUTO_TEST_CASE( cont_non_uniform2 )
 {
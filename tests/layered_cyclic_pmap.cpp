@@ -0,0 +1,152 @@
+/*
+ *  This file is a part of TiledArray.
+ *  Copyright (C) 2016  Virginia Tech
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "TiledArray/pmap/layered_cyclic_pmap.h"
+#include "unit_test_config.h"
+#include "global_fixture.h"
+
+using namespace TiledArray;
+
+struct LayeredCyclicPmapFixture {
+
+  LayeredCyclicPmapFixture() { }
+
+};
+
+
+// =============================================================================
+// LayeredCyclicPmap Test Suite
+
+
+BOOST_FIXTURE_TEST_SUITE( layered_cyclic_pmap_suite, LayeredCyclicPmapFixture )
+
+BOOST_AUTO_TEST_CASE( layer_begin_owner )
+{
+  for(std::size_t extent = 1ul; extent < 20ul; ++extent) {
+    for(std::size_t layers = 1ul; layers <= extent; ++layers) {
+      // Check the layer blocks cover the whole extent
+      BOOST_CHECK_EQUAL(detail::LayeredCyclicPmap::layer_begin(0ul, extent, layers), 0ul);
+      BOOST_CHECK_EQUAL(detail::LayeredCyclicPmap::layer_begin(layers, extent, layers), extent);
+
+      // Check that each index is owned by the layer that includes it
+      for(std::size_t l = 0ul; l < layers; ++l) {
+        const std::size_t first = detail::LayeredCyclicPmap::layer_begin(l, extent, layers);
+        const std::size_t last = detail::LayeredCyclicPmap::layer_begin(l + 1ul, extent, layers);
+        BOOST_CHECK_LT(first, last);
+        for(std::size_t i = first; i < last; ++i)
+          BOOST_CHECK_EQUAL(detail::LayeredCyclicPmap::layer_owner(i, extent, layers), l);
+      }
+    }
+  }
+}
+
+BOOST_AUTO_TEST_CASE( constructor )
+{
+  const std::size_t size = GlobalFixture::world->size();
+  for(std::size_t layers = 1ul; layers <= size; ++layers) {
+    const std::size_t p_cols = size / layers;
+    for(std::size_t x = layers; x < 10ul; ++x) {
+      BOOST_REQUIRE_NO_THROW(detail::LayeredCyclicPmap pmap(* GlobalFixture::world,
+          x, 5ul, 1ul, p_cols, layers, false));
+      detail::LayeredCyclicPmap pmap(* GlobalFixture::world, x, 5ul, 1ul,
+          p_cols, layers, false);
+      BOOST_CHECK_EQUAL(pmap.rank(), GlobalFixture::world->rank());
+      BOOST_CHECK_EQUAL(pmap.procs(), GlobalFixture::world->size());
+      BOOST_CHECK_EQUAL(pmap.size(), x * 5ul);
+      BOOST_CHECK_EQUAL(pmap.nlayers(), layers);
+    }
+  }
+
+#ifdef TA_EXCEPTION_ERROR
+  BOOST_CHECK_THROW(detail::LayeredCyclicPmap pmap(* GlobalFixture::world, 10ul, 10ul, 1, 1, 0, true), TiledArray::Exception);
+  BOOST_CHECK_THROW(detail::LayeredCyclicPmap pmap(* GlobalFixture::world, 10ul, 2ul, 1, 1, 3, true), TiledArray::Exception);
+  BOOST_CHECK_THROW(detail::LayeredCyclicPmap pmap(* GlobalFixture::world, 10ul, 10ul, 1, 1, size + 1, true), TiledArray::Exception);
+#endif // TA_EXCEPTION_ERROR
+}
+
+BOOST_AUTO_TEST_CASE( local_group )
+{
+  ProcessID tile_owners[100];
+  const std::size_t size = GlobalFixture::world->size();
+
+  for(std::size_t layers = 1ul; layers <= std::min<std::size_t>(size, 4ul); ++layers) {
+    const std::size_t p_rows = (size / layers > 1ul ? 2ul : 1ul);
+    const std::size_t p_cols = (size / layers) / p_rows;
+
+    for(std::size_t x = layers; x < 10ul; ++x) {
+      for(std::size_t y = layers; y < 10ul; ++y) {
+        for(int layer_cols = 0; layer_cols < 2; ++layer_cols) {
+          const std::size_t tiles = x * y;
+          detail::LayeredCyclicPmap pmap(* GlobalFixture::world, x, y, p_rows,
+              p_cols, layers, layer_cols);
+
+          // Check that all local elements map to this rank
+          for(detail::LayeredCyclicPmap::const_iterator it = pmap.begin(); it != pmap.end(); ++it) {
+            BOOST_CHECK_EQUAL(pmap.owner(*it), GlobalFixture::world->rank());
+          }
+
+          // Check that the tiles of each layer block are owned by that layer
+          for(std::size_t tile = 0ul; tile < tiles; ++tile) {
+            const std::size_t index = (layer_cols ? tile % y : tile / y);
+            const std::size_t layer = detail::LayeredCyclicPmap::layer_owner(
+                index, (layer_cols ? y : x), layers);
+            BOOST_CHECK_EQUAL(pmap.owner(tile) / (p_rows * p_cols), layer);
+          }
+
+          std::fill_n(tile_owners, tiles, 0);
+          for(detail::LayeredCyclicPmap::const_iterator it = pmap.begin(); it != pmap.end(); ++it) {
+            tile_owners[*it] += GlobalFixture::world->rank();
+          }
+
+          GlobalFixture::world->gop.sum(tile_owners, tiles);
+          for(std::size_t tile = 0; tile < tiles; ++tile) {
+            BOOST_CHECK_EQUAL(tile_owners[tile], pmap.owner(tile));
+          }
+        }
+      }
+    }
+  }
+}
+
+BOOST_AUTO_TEST_CASE( local_ordinal )
+{
+  const std::size_t size = GlobalFixture::world->size();
+
+  for(std::size_t layers = 1ul; layers <= std::min<std::size_t>(size, 4ul); ++layers) {
+    const std::size_t p_rows = (size / layers > 1ul ? 2ul : 1ul);
+    const std::size_t p_cols = (size / layers) / p_rows;
+
+    for(std::size_t x = layers; x < 10ul; ++x) {
+      for(std::size_t y = layers; y < 10ul; ++y) {
+        for(int layer_cols = 0; layer_cols < 2; ++layer_cols) {
+          detail::LayeredCyclicPmap pmap(* GlobalFixture::world, x, y, p_rows,
+              p_cols, layers, layer_cols);
+          BOOST_CHECK(pmap.has_local_ordinal());
+
+          // Check that the local ordinal is the position in the local tile list
+          std::size_t ordinal = 0ul;
+          for(detail::LayeredCyclicPmap::const_iterator it = pmap.begin(); it != pmap.end(); ++it, ++ordinal)
+            BOOST_CHECK_EQUAL(pmap.local_ordinal(*it), ordinal);
+        }
+      }
+    }
+  }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -24,6 +24,7 @@
  */
 
 #include "TiledArray/math/blas.h"
+#include "TiledArray/math/parallel_gemm.h"
 #include "tiledarray.h"
 #include "unit_test_config.h"
 
@@ -350,4 +351,82 @@ BOOST_AUTO_TEST_CASE_TEMPLATE( complex_gemm_ld , T, floating_point_types )
   delete [] c;
 }
 
+BOOST_AUTO_TEST_CASE_TEMPLATE( blocked_gemm , T, floating_point_types )
+{
+  // Allocate and initialize test input
+  std::vector<T> a(m * k), b(k * n), c(m * n);
+  rand_fill(a.data(), m * k, 29);
+  rand_fill(b.data(), k * n, 47);
+  rand_fill(c.data(), m * n, 99);
+  const std::vector<T> c0 = c;
+
+  // Use a block size that does not evenly divide the result dimensions
+  const integer ldc = n, block_size = 7;
+
+  for(auto op_a : { madness::cblas::NoTrans, madness::cblas::Trans }) {
+    for(auto op_b : { madness::cblas::NoTrans, madness::cblas::Trans }) {
+      c = c0;
+
+      // Set the leading dimensions to match the argument layouts
+      const integer lda = (op_a == madness::cblas::NoTrans ? k : m);
+      const integer ldb = (op_b == madness::cblas::NoTrans ? n : k);
+
+      // Test the blocked gemm operation
+      BOOST_REQUIRE_NO_THROW(TiledArray::math::blocked_gemm(op_a, op_b,
+          m, n, k, T(3), a.data(), lda, b.data(), ldb, T(2), c.data(), ldc,
+          block_size));
+
+      for(integer i = 0; i < m; ++i) {
+        for(integer j = 0; j < n; ++j) {
+          // Compute the expected value
+          T expected = 0;
+          for(integer x = 0; x < k; ++x)
+            expected +=
+                (op_a == madness::cblas::NoTrans ? a[i * lda + x] : a[x * lda + i]) *
+                (op_b == madness::cblas::NoTrans ? b[x * ldb + j] : b[j * ldb + x]);
+          expected = 3 * expected + 2 * c0[i * ldc + j];
+
+          // Check the result against the expected value
+          BOOST_CHECK_CLOSE(c[i * ldc + j], expected, tol);
+        }
+      }
+    }
+  }
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE( parallel_gemm , T, floating_point_types )
+{
+  // Use a product that is large enough to be partitioned into blocks when
+  // Intel TBB is available
+  const integer M = TiledArray::math::parallel_gemm_block_size + 44;
+  const integer N = TiledArray::math::parallel_gemm_block_size + 4;
+  const integer K = 220;
+  BOOST_REQUIRE((std::size_t(M) * std::size_t(N) * std::size_t(K)) >=
+      TiledArray::math::parallel_gemm_min_volume);
+
+  // Allocate and initialize test input
+  std::vector<T> a(M * K), b(K * N), c(M * N);
+  rand_fill(a.data(), M * K, 29);
+  rand_fill(b.data(), K * N, 47);
+  rand_fill(c.data(), M * N, 99);
+  const std::vector<T> c0 = c;
+
+  BOOST_REQUIRE_NO_THROW(TiledArray::math::parallel_gemm(madness::cblas::NoTrans,
+      madness::cblas::NoTrans, M, N, K, T(3), a.data(), K, b.data(), N, T(2),
+      c.data(), N));
+
+  for(integer i = 0; i < M; ++i) {
+    for(integer j = 0; j < N; ++j) {
+      // Compute the expected value
+      T expected = 0;
+      for(integer x = 0; x < K; ++x)
+        expected += a[i * K + x] * b[x * N + j];
+      expected = 3 * expected + 2 * c0[i * N + j];
+
+      // Check the result against the expected value
+      BOOST_CHECK_CLOSE(c[i * N + j], expected, tol);
+    }
+  }
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -24,6 +24,8 @@
  */
 
 #include "TiledArray/math/transpose.h"
+#include "TiledArray/math/vector_simd.h"
+#include <vector>
 #include "tiledarray.h"
 #include "unit_test_config.h"
 
@@ -154,4 +156,50 @@ BOOST_AUTO_TEST_CASE( binary )
   delete [] b;
   delete [] c;
 }
+
+typedef boost::mpl::list<float, double> simd_types;
+
+BOOST_AUTO_TEST_CASE_TEMPLATE( transpose_copy, T, simd_types )
+{
+  using TiledArray::math::simd::Isa;
+  const Isa isa = TiledArray::math::simd::isa();
+
+  // Matrix sizes {m, n}, which include sizes that are larger than the level 2
+  // cache block and that are not multiples of the kernel size
+  const std::size_t sizes[][2] = { {70, 45}, {8, 8}, {256, 256}, {1, 300},
+      {300, 7}, {513, 270}, {263, 517} };
+
+  GlobalFixture::world->srand(1764);
+  for(const auto& size : sizes) {
+    const std::size_t m = size[0];
+    const std::size_t n = size[1];
+
+    // Use strides that are larger than the matrix dimensions
+    const std::size_t arg_stride = n + 5ul;
+    const std::size_t result_stride = m + 3ul;
+
+    std::vector<T> a(m * arg_stride);
+    for(std::size_t i = 0ul; i < a.size(); ++i)
+      a[i] = GlobalFixture::world->rand() % 42;
+
+    for(auto x : { Isa::generic, Isa::sse2, Isa::avx2, Isa::avx512 }) {
+      TiledArray::math::simd::set_isa(x);
+
+      std::vector<T> b(n * result_stride, T(-1));
+      TiledArray::math::transpose_copy(m, n, result_stride, b.data(),
+          arg_stride, a.data());
+
+      // Count the result elements that differ from the expected value
+      std::size_t errors = 0ul;
+      for(std::size_t j = 0ul; j < n; ++j)
+        for(std::size_t i = 0ul; i < result_stride; ++i)
+          if(b[j * result_stride + i] != (i < m ? a[i * arg_stride + j] : T(-1)))
+            ++errors;
+      BOOST_CHECK_EQUAL(errors, 0ul);
+    }
+  }
+
+  TiledArray::math::simd::set_isa(isa);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
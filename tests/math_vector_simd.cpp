@@ -0,0 +1,121 @@
+/*
+ *  This file is a part of TiledArray.
+ *  Copyright (C) 2016  Virginia Tech
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "TiledArray/math/vector_simd.h"
+#include "tiledarray.h"
+#include "unit_test_config.h"
+
+using namespace TiledArray::math;
+
+struct VectorSimdFixture {
+
+  VectorSimdFixture() : isa(simd::isa()) { }
+
+  ~VectorSimdFixture() { simd::set_isa(isa); }
+
+  // Compare the explicit SIMD kernels, with each instruction set, to the
+  // generic implementations
+  template <typename T>
+  void check() {
+    GlobalFixture::world->srand(27);
+    for(std::size_t n : { 0ul, 1ul, 7ul, 16ul, 63ul, 100ul, 1027ul }) {
+      std::vector<T> a(n), b(n), r(n), g(n);
+      for(std::size_t i = 0ul; i < n; ++i) {
+        a[i] = T(GlobalFixture::world->rand() % 101 - 50);
+        b[i] = T(GlobalFixture::world->rand() % 101 - 50);
+      }
+
+      for(auto i : { simd::Isa::generic, simd::Isa::sse2, simd::Isa::avx2,
+          simd::Isa::avx512 })
+      {
+        simd::set_isa(i);
+
+        r = a; g = a;
+        simd::scale_to(n, T(3), r.data());
+        simd::scale_to<T>(n, T(3), g.data());
+        BOOST_CHECK(r == g);
+
+        r = a; g = a;
+        simd::add_to(n, r.data(), b.data());
+        simd::add_to<T, T>(n, g.data(), b.data());
+        BOOST_CHECK(r == g);
+
+        r = a; g = a;
+        simd::add_to(n, r.data(), b.data(), T(2));
+        simd::add_to<T, T>(n, g.data(), b.data(), T(2));
+        BOOST_CHECK(r == g);
+
+        r = a; g = a;
+        simd::subt_to(n, r.data(), b.data());
+        simd::subt_to<T, T>(n, g.data(), b.data());
+        BOOST_CHECK(r == g);
+
+        r = a; g = a;
+        simd::subt_to(n, r.data(), b.data(), T(2));
+        simd::subt_to<T, T>(n, g.data(), b.data(), T(2));
+        BOOST_CHECK(r == g);
+
+        r = a; g = a;
+        simd::mult_to(n, r.data(), b.data());
+        simd::mult_to<T, T>(n, g.data(), b.data());
+        BOOST_CHECK(r == g);
+
+        r = a; g = a;
+        simd::mult_to(n, r.data(), b.data(), T(2));
+        simd::mult_to<T, T>(n, g.data(), b.data(), T(2));
+        BOOST_CHECK(r == g);
+
+        // The elements are integers, so the reductions are exact
+        BOOST_CHECK_EQUAL(simd::squared_norm(n, a.data()),
+            simd::squared_norm<T>(n, a.data()));
+        BOOST_CHECK_EQUAL(simd::dot(n, a.data(), b.data()),
+            (simd::dot<T, T>(n, a.data(), b.data())));
+        BOOST_CHECK_EQUAL(simd::abs_max(n, a.data()),
+            simd::abs_max<T>(n, a.data()));
+      }
+    }
+  }
+
+  const simd::Isa isa;
+
+}; // VectorSimdFixture
+
+BOOST_FIXTURE_TEST_SUITE( vector_simd_suite, VectorSimdFixture )
+
+BOOST_AUTO_TEST_CASE( isa )
+{
+  // Requests for instruction sets the host does not support fall back to a
+  // supported one
+  const simd::Isa host = simd::set_isa(simd::Isa::avx512);
+  BOOST_CHECK(static_cast<int>(simd::set_isa(simd::Isa::generic)) <= static_cast<int>(host));
+  BOOST_CHECK(simd::isa() == simd::Isa::generic);
+  BOOST_CHECK(simd::set_isa(host) == host);
+}
+
+BOOST_AUTO_TEST_CASE( double_kernels )
+{
+  check<double>();
+}
+
+BOOST_AUTO_TEST_CASE( float_kernels )
+{
+  check<float>();
+}
+
+BOOST_AUTO_TEST_SUITE_END()
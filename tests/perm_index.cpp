@@ -156,4 +156,24 @@ BOOST_AUTO_TEST_CASE( permute_constructor_tensor ) {
   }
 }
 
+BOOST_AUTO_TEST_CASE( permute_all_ranks ) {
+  // Check the rank specialized kernels and the run-time rank kernel
+  for(unsigned int rank = 1u; rank <= 6u; ++rank) {
+    std::vector<std::size_t> lower(rank), upper(rank);
+    std::vector<unsigned int> p(rank);
+    for(unsigned int i = 0u; i < rank; ++i) {
+      lower[i] = i;
+      upper[i] = i + 2u + (i % 2u);
+      p[i] = (i + 1u) % rank;
+    }
+    const Range r(lower, upper);
+    const Permutation pr(p.begin(), p.end());
+    const Range result_range = pr * r;
+
+    PermIndex perm_index(r, pr);
+    for(std::size_t i = 0ul; i < r.volume(); ++i)
+      BOOST_CHECK_EQUAL(perm_index(i), result_range.ordinal(pr * r.idx(i)));
+  }
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -193,6 +193,64 @@ BOOST_AUTO_TEST_CASE( make_groups )
   }
 }
 
+BOOST_AUTO_TEST_CASE( layers )
+{
+  for(ProcessID nprocs = 1; nprocs < 64; ++nprocs) {
+    for(std::size_t layers = 1ul; layers <= std::size_t(nprocs); ++layers) {
+      const std::size_t k = 12ul;
+
+      TiledArray::detail::ProcGrid proc_grid0(*GlobalFixture::world, 0, nprocs,
+          20, 30, 2000, 3000, layers);
+      BOOST_CHECK_EQUAL(proc_grid0.proc_layers(), layers);
+      BOOST_CHECK_LE(proc_grid0.proc_size() * layers, std::size_t(nprocs));
+      BOOST_CHECK_EQUAL(proc_grid0.rank_layer(), 0);
+      BOOST_CHECK_EQUAL(proc_grid0.layer_offset(), 0);
+
+      // Check that each process is assigned to the correct layer, and that the
+      // layers cover the inner dimension.
+      std::size_t k_total = 0ul;
+      for(ProcessID rank = 0; rank < nprocs; ++rank) {
+        TiledArray::detail::ProcGrid proc_grid(*GlobalFixture::world, rank,
+            nprocs, 20, 30, 2000, 3000, layers);
+
+        // Check process grid dimensions are equal for all ranks
+        BOOST_CHECK_EQUAL(proc_grid.proc_rows(), proc_grid0.proc_rows());
+        BOOST_CHECK_EQUAL(proc_grid.proc_cols(), proc_grid0.proc_cols());
+
+        if(std::size_t(rank) < (proc_grid0.proc_size() * layers)) {
+          const ProcessID layer = rank / proc_grid0.proc_size();
+          BOOST_CHECK_EQUAL(proc_grid.rank_layer(), layer);
+          BOOST_CHECK_EQUAL(proc_grid.layer_offset(), layer * proc_grid0.proc_size());
+          BOOST_CHECK_EQUAL(proc_grid.local_size(),
+              TiledArray::detail::ProcGrid(*GlobalFixture::world,
+              rank % proc_grid0.proc_size(), nprocs, 20, 30, 2000, 3000,
+              layers).local_size());
+
+          // Accumulate the inner dimension tiles of the first process in each layer
+          if((rank % proc_grid0.proc_size()) == 0) {
+            BOOST_CHECK_EQUAL(proc_grid.layer_k_begin(k), k_total);
+            k_total = proc_grid.layer_k_end(k);
+          }
+        } else {
+          BOOST_CHECK_EQUAL(proc_grid.rank_layer(), -1);
+          BOOST_CHECK_EQUAL(proc_grid.local_size(), 0ul);
+          BOOST_CHECK_EQUAL(proc_grid.layer_k_end(k), 0ul);
+        }
+      }
+
+      if(layers <= k)
+        BOOST_CHECK_EQUAL(k_total, k);
+    }
+  }
+
+  // Check that no layers are used when there is no memory bound
+  BOOST_CHECK_EQUAL(TiledArray::detail::ProcGrid::optimal_layers(64, 100,
+      10000, 10000, 10000, 8, 0), 1u);
+  // Check that layers are used for a large inner dimension
+  BOOST_CHECK_GT(TiledArray::detail::ProcGrid::optimal_layers(64, 100,
+      1000, 1000, 1000000, 8, 1ul << 32), 1u);
+}
+
 #if 0
 // This test case us used to evaluate distribute statistics. This unit test
 // should only be enabled when changes are made to the ProcGrid algorithm, and
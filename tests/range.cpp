@@ -364,4 +364,36 @@ BOOST_AUTO_TEST_CASE( swap )
   BOOST_CHECK_EQUAL(r.volume(), volume);
 }
 
+BOOST_AUTO_TEST_CASE( inline_storage )
+{
+  // Check copy, move, and swap of ranges with inline and heap allocated data
+  for(unsigned int rank0 = 1u; rank0 <= 8u; ++rank0) {
+    for(unsigned int rank1 = 1u; rank1 <= 8u; ++rank1) {
+      const Range r0(std::vector<std::size_t>(rank0, 2ul), std::vector<std::size_t>(rank0, 4ul));
+      const Range r1(std::vector<std::size_t>(rank1, 1ul), std::vector<std::size_t>(rank1, 3ul));
+
+      Range c0(r0);
+      Range c1(r1);
+      BOOST_CHECK_EQUAL(c0, r0);
+      BOOST_CHECK(c0.lobound_data() != r0.lobound_data());
+
+      BOOST_CHECK_NO_THROW(c0.swap(c1));
+      BOOST_CHECK_EQUAL(c0, r1);
+      BOOST_CHECK_EQUAL(c1, r0);
+
+      Range m(std::move(c0));
+      BOOST_CHECK_EQUAL(m, r1);
+      BOOST_CHECK_EQUAL(c0.rank(), 0u);
+      BOOST_CHECK(c0.lobound_data() == nullptr);
+
+      m = std::move(c1);
+      BOOST_CHECK_EQUAL(m, r0);
+      BOOST_CHECK_EQUAL(c1.rank(), 0u);
+
+      m = r1;
+      BOOST_CHECK_EQUAL(m, r1);
+    }
+  }
+}
+
 BOOST_AUTO_TEST_SUITE_END()
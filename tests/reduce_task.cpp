@@ -19,7 +19,11 @@
 
 #include "TiledArray/reduce_task.h"
 #include "unit_test_config.h"
+#include <algorithm>
+#include <atomic>
 #include <functional>
+#include <mutex>
+#include <thread>
 
 using namespace TiledArray;
 using namespace TiledArray::detail;
@@ -43,6 +47,45 @@ struct plus {
 };
 
 
+// Sum operation that records the size of batched reductions, and holds all
+// reductions until it is released
+struct batch_plus {
+  typedef int result_type;
+  typedef int argument_type;
+
+  struct State {
+    std::atomic<bool> released{ false }; ///< Reductions may run
+    std::mutex mutex; ///< Batch size mutex
+    std::vector<std::size_t> batches; ///< The sizes of the batched reductions
+  }; // struct State
+
+  std::shared_ptr<State> state = std::make_shared<State>();
+
+  void wait() const {
+    while(! state->released)
+      std::this_thread::yield();
+  }
+
+  result_type operator()() const { return result_type(); }
+
+  result_type operator()(const result_type temp) const { return temp; }
+
+  void operator()(result_type& result, const argument_type& arg) const {
+    wait();
+    result += arg;
+  }
+
+  void operator()(result_type& result, const std::vector<const argument_type*>& args) const {
+    wait();
+    {
+      std::lock_guard<std::mutex> lock(state->mutex);
+      state->batches.push_back(args.size());
+    }
+    for(const argument_type* arg : args)
+      result += *arg;
+  }
+}; // struct batch_plus
+
 struct ReduceTaskFixture {
 
   ReduceTaskFixture() : world(*GlobalFixture::world), rt(world, plus<int>()) {
@@ -137,6 +180,38 @@ BOOST_AUTO_TEST_CASE( reduce_future )
 
 }
 
+BOOST_AUTO_TEST_CASE( reduce_batch )
+{
+  const std::size_t max_batch_size = ReduceTask<batch_plus>::max_batch_size;
+  batch_plus op;
+  ReduceTask<batch_plus> batch_rt(world, op);
+
+  // The first argument is reduced with the result object. The others become
+  // ready while it is held, so they are reduced in two full batches by new
+  // tasks and one partial batch when a result object is returned.
+  const std::size_t n = 1ul + 2ul * max_batch_size + (max_batch_size - 1ul);
+  std::vector<Future<int> > fut_vec(n);
+  for(std::size_t i = 0ul; i < n; ++i)
+    batch_rt.add(fut_vec[i]);
+
+  Future<int> result = batch_rt.submit();
+
+  int sum = 0;
+  for(std::size_t i = 0ul; i < n; ++i) {
+    sum += int(i);
+    fut_vec[i].set(int(i));
+  }
+  op.state->released = true;
+
+  BOOST_CHECK_EQUAL(result.get(), sum);
+
+  std::vector<std::size_t> batches = op.state->batches;
+  std::sort(batches.begin(), batches.end());
+  const std::size_t reference[] = { max_batch_size - 1ul, max_batch_size, max_batch_size };
+  BOOST_CHECK_EQUAL_COLLECTIONS(batches.begin(), batches.end(),
+      std::begin(reference), std::end(reference));
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 
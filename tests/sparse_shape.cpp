@@ -1194,4 +1194,27 @@ BOOST_AUTO_TEST_CASE( gemm_perm )
   BOOST_CHECK_CLOSE(result.sparsity(), float(zero_tile_count) / float(result_norms.size()), tolerance);
 }
 
+BOOST_AUTO_TEST_CASE( gemm_sparse )
+{
+  math::GemmHelper gemm_helper(madness::cblas::NoTrans, madness::cblas::NoTrans,
+      2u, left.data().range().rank(), right.data().range().rank());
+
+  // Evaluate the contraction with the dense and sparse norm products
+  const float density = SparseShape<float>::sparse_gemm_density();
+  SparseShape<float>::sparse_gemm_density(0.0f);
+  SparseShape<float> dense_result = left.gemm(right, -7.2, gemm_helper);
+  SparseShape<float>::sparse_gemm_density(1.1f);
+  SparseShape<float> sparse_result;
+  BOOST_CHECK_NO_THROW(sparse_result = left.gemm(right, -7.2, gemm_helper));
+  SparseShape<float>::sparse_gemm_density(density);
+
+  // Check that the results are the same
+  BOOST_REQUIRE_EQUAL(sparse_result.data().range(), dense_result.data().range());
+  for(std::size_t i = 0ul; i < dense_result.data().size(); ++i) {
+    BOOST_CHECK_CLOSE(sparse_result[i], dense_result[i], 0.001);
+    BOOST_CHECK_EQUAL(sparse_result.is_zero(i), dense_result.is_zero(i));
+  }
+  BOOST_CHECK_CLOSE(sparse_result.sparsity(), dense_result.sparsity(), tolerance);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,67 @@
+/*
+ *  This file is a part of TiledArray.
+ *  Copyright (C) 2016  Virginia Tech
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "TiledArray/spill_file.h"
+#include "tiledarray.h"
+#include "unit_test_config.h"
+#include "range_fixture.h"
+
+using namespace TiledArray;
+
+struct SpillFileFixture : public TiledRangeFixture {
+
+  SpillFileFixture() : file("/tmp") { }
+
+  detail::SpillFile file;
+}; // struct SpillFileFixture
+
+BOOST_FIXTURE_TEST_SUITE( spill_file_suite, SpillFileFixture )
+
+BOOST_AUTO_TEST_CASE( write_read )
+{
+  // Write tiles of several sizes, so regions are not aligned to pages
+  std::vector<TensorI> tiles;
+  std::vector<detail::SpillFile::Region> regions;
+  for(std::size_t i = 0ul; i < tr.tiles_range().volume(); ++i) {
+    TensorI tile(tr.make_tile_range(i));
+    for(std::size_t j = 0ul; j < tile.size(); ++j)
+      tile[j] = i * 1000 + j;
+    regions.push_back(file.write(tile));
+    tiles.push_back(tile);
+  }
+
+  // Check that the regions do not overlap
+  for(std::size_t i = 1ul; i < regions.size(); ++i)
+    BOOST_CHECK_LE(regions[i - 1ul].offset + regions[i - 1ul].size, regions[i].offset);
+
+  // Read the tiles in reverse order
+  for(std::size_t i = tiles.size(); i > 0ul; --i) {
+    const TensorI tile = file.read<TensorI>(regions[i - 1ul]);
+    BOOST_CHECK_EQUAL(tile.range(), tiles[i - 1ul].range());
+    BOOST_CHECK_EQUAL_COLLECTIONS(tile.begin(), tile.end(),
+        tiles[i - 1ul].begin(), tiles[i - 1ul].end());
+  }
+}
+
+BOOST_AUTO_TEST_CASE( bad_directory )
+{
+  BOOST_CHECK_THROW(detail::SpillFile("/nonexistent/directory"), TiledArray::Exception);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
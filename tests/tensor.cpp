@@ -69,6 +69,22 @@ BOOST_AUTO_TEST_CASE( range_constructor )
   // Do not check values of x because it maybe uninitialized
 }
 
+BOOST_AUTO_TEST_CASE( uninitialized_constructor )
+{
+  BOOST_REQUIRE_NO_THROW(TensorN x(r, uninitialized));
+  TensorN x(r, uninitialized);
+
+  BOOST_CHECK(! x.empty());
+  BOOST_CHECK_NE(x.data(), static_cast<int*>(NULL));
+  BOOST_CHECK_EQUAL(x.size(), r.volume());
+  BOOST_CHECK_EQUAL(x.range(), r);
+
+  // Check that the tensor can be filled after construction
+  std::fill(x.begin(), x.end(), 1);
+  for(TensorN::const_iterator it = x.begin(); it != x.end(); ++it)
+    BOOST_CHECK_EQUAL(*it, 1);
+}
+
 BOOST_AUTO_TEST_CASE( value_constructor )
 {
   BOOST_REQUIRE_NO_THROW(TensorN x(r, 8));
@@ -0,0 +1,150 @@
+/*
+ *  This file is a part of TiledArray.
+ *  Copyright (C) 2016  Virginia Tech
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "TiledArray/tensor/pool_allocator.h"
+#include "tiledarray.h"
+#include "unit_test_config.h"
+#include <future>
+#include <thread>
+
+using namespace TiledArray;
+
+struct PoolAllocatorFixture {
+
+  PoolAllocatorFixture() { pool::trim(); }
+
+  ~PoolAllocatorFixture() { pool::trim(); }
+
+}; // PoolAllocatorFixture
+
+BOOST_FIXTURE_TEST_SUITE( pool_allocator_suite, PoolAllocatorFixture )
+
+BOOST_AUTO_TEST_CASE( alignment )
+{
+  PoolAllocator<double> alloc;
+  for(std::size_t n = 1ul; n < 5000ul; n += 97ul) {
+    double* const p = alloc.allocate(n);
+    BOOST_CHECK_EQUAL(reinterpret_cast<std::uintptr_t>(p) % TILEDARRAY_CACHELINE_SIZE, 0ul);
+    std::fill_n(p, n, 1.0);
+    alloc.deallocate(p, n);
+  }
+}
+
+BOOST_AUTO_TEST_CASE( reuse )
+{
+  PoolAllocator<double> alloc;
+  const PoolStatistics start = pool::statistics();
+
+  // The first allocation of a size class is a miss
+  double* const p = alloc.allocate(1000ul);
+  const PoolStatistics allocated = pool::statistics();
+  BOOST_CHECK_EQUAL(allocated.misses, start.misses + 1ul);
+  BOOST_CHECK_GE(allocated.bytes_in_use, start.bytes_in_use + 1000ul * sizeof(double));
+  BOOST_CHECK_GE(allocated.high_water, allocated.bytes_in_use);
+
+  // Freed blocks are cached and reused for requests of the same size class
+  alloc.deallocate(p, 1000ul);
+  BOOST_CHECK_EQUAL(pool::statistics().bytes_in_use, start.bytes_in_use);
+  BOOST_CHECK_GT(pool::statistics().bytes_cached, 0ul);
+
+  double* const q = alloc.allocate(990ul);
+  const PoolStatistics reused = pool::statistics();
+  BOOST_CHECK_EQUAL(q, p);
+  BOOST_CHECK_EQUAL(reused.hits, allocated.hits + 1ul);
+  BOOST_CHECK_EQUAL(reused.misses, allocated.misses);
+  alloc.deallocate(q, 990ul);
+
+  // Trim releases the cached blocks
+  pool::trim();
+  BOOST_CHECK_EQUAL(pool::statistics().bytes_cached, 0ul);
+}
+
+BOOST_AUTO_TEST_CASE( trim_thread_caches )
+{
+  // Cache a block in the cache of another thread, which is still running
+  // when the pool is trimmed.
+  std::promise<void> cached, trimmed;
+  std::future<void> trimmed_future = trimmed.get_future();
+  std::thread thread([&] () {
+    PoolAllocator<double> alloc;
+    alloc.deallocate(alloc.allocate(1000ul), 1000ul);
+    cached.set_value();
+    trimmed_future.wait();
+  });
+  cached.get_future().wait();
+  BOOST_CHECK_GT(pool::statistics().bytes_cached, 0ul);
+
+  pool::trim();
+  BOOST_CHECK_EQUAL(pool::statistics().bytes_cached, 0ul);
+
+  trimmed.set_value();
+  thread.join();
+  BOOST_CHECK_EQUAL(pool::statistics().bytes_cached, 0ul);
+}
+
+BOOST_AUTO_TEST_CASE( tensor )
+{
+  // Tensors with the default allocator use the pool
+  const PoolStatistics start = pool::statistics();
+  {
+    Tensor<double> t(Range(10, 20, 30), 1.0);
+    BOOST_CHECK_GE(pool::statistics().bytes_in_use,
+        start.bytes_in_use + t.size() * sizeof(double));
+  }
+  BOOST_CHECK_EQUAL(pool::statistics().bytes_in_use, start.bytes_in_use);
+}
+
+BOOST_AUTO_TEST_CASE( tensor_single_allocation )
+{
+  // The tensor header and data are placed in one block
+  const PoolStatistics start = pool::statistics();
+  {
+    Tensor<double> t(Range(10, 20), 1.0);
+    const PoolStatistics allocated = pool::statistics();
+    BOOST_CHECK_EQUAL((allocated.hits + allocated.misses) - (start.hits + start.misses), 1ul);
+    BOOST_CHECK_EQUAL(reinterpret_cast<std::uintptr_t>(t.data()) % TILEDARRAY_CACHELINE_SIZE, 0ul);
+
+    // Copies share the data
+    Tensor<double> c(t);
+    BOOST_CHECK_EQUAL(c.data(), t.data());
+    BOOST_CHECK_EQUAL(c[199], 1.0);
+  }
+  BOOST_CHECK_EQUAL(pool::statistics().bytes_in_use, start.bytes_in_use);
+}
+
+BOOST_AUTO_TEST_CASE( tensor_size_class )
+{
+  // The data of a tensor that fills a size class exactly is allocated
+  // separately, so the header does not move it to a larger size class.
+  const std::size_t data_bytes = 4096ul * sizeof(double);
+  BOOST_REQUIRE_EQUAL(pool::block_size(data_bytes), data_bytes);
+  const PoolStatistics start = pool::statistics();
+  {
+    Tensor<double> t(Range(64, 64), 1.0);
+    const PoolStatistics allocated = pool::statistics();
+    BOOST_CHECK_EQUAL((allocated.hits + allocated.misses) - (start.hits + start.misses), 2ul);
+    BOOST_CHECK_LT(allocated.bytes_in_use - start.bytes_in_use,
+        pool::block_size(data_bytes + 1ul));
+    BOOST_CHECK_EQUAL(reinterpret_cast<std::uintptr_t>(t.data()) % TILEDARRAY_CACHELINE_SIZE, 0ul);
+    BOOST_CHECK_EQUAL(t[4095], 1.0);
+  }
+  BOOST_CHECK_EQUAL(pool::statistics().bytes_in_use, start.bytes_in_use);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -406,4 +406,26 @@ BOOST_AUTO_TEST_CASE( scale_to_view )
   }
 }
 
+BOOST_AUTO_TEST_CASE( reduce_large_view )
+{
+  // The view is large enough to be reduced in parallel
+  Tensor<int> big = random_tensor(Range(std::array<int, 3>{{0,0,0}},
+      std::array<int, 3>{{40,50,60}}));
+  TensorConstView<int> view = big.block({1,2,3}, {39,47,58});
+  BOOST_REQUIRE(view.range().volume() >= math::reduce_op_min_volume);
+
+  int sum = 0, squared_norm = 0, dot = 0;
+  for(auto it = view.range().begin(); it != view.range().end(); ++it) {
+    sum += view(*it);
+    squared_norm += view(*it) * view(*it);
+    dot += view(*it) * 2;
+  }
+
+  Tensor<int> twos(view.range(), 2);
+
+  BOOST_CHECK_EQUAL(view.sum(), sum);
+  BOOST_CHECK_EQUAL(view.squared_norm(), squared_norm);
+  BOOST_CHECK_EQUAL(view.dot(twos), dot);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -214,6 +214,93 @@ BOOST_AUTO_TEST_CASE( matrix_multiply )
   BOOST_CHECK_EQUAL(result_map, C);
 }
 
+BOOST_AUTO_TEST_CASE( matrix_multiply_batch )
+{
+  // Set dimension constants
+  const std::size_t left_outer_start = 2, left_outer_finish = 20,
+      right_outer_start = 4, right_outer_finish = 40;
+  const std::size_t inner[4] = { 3, 10, 30, 35 };
+
+  for(int t = 0; t < 4; ++t) {
+    const madness::cblas::CBLAS_TRANSPOSE left_op =
+        (t & 1 ? madness::cblas::Trans : madness::cblas::NoTrans);
+    const madness::cblas::CBLAS_TRANSPOSE right_op =
+        (t & 2 ? madness::cblas::Trans : madness::cblas::NoTrans);
+
+    // Construct a batch of argument tiles with different inner dimensions
+    std::vector<tensor_type> left, right;
+    for(int i = 0; i < 3; ++i) {
+      left.push_back(left_op == madness::cblas::NoTrans ?
+          make_tensor(left_outer_start, inner[i], left_outer_finish, inner[i + 1]) :
+          make_tensor(inner[i], left_outer_start, inner[i + 1], left_outer_finish));
+      right.push_back(right_op == madness::cblas::NoTrans ?
+          make_tensor(inner[i], right_outer_start, inner[i + 1], right_outer_finish) :
+          make_tensor(right_outer_start, inner[i], right_outer_finish, inner[i + 1]));
+    }
+    std::vector<const tensor_type*> left_ptrs, right_ptrs;
+    for(int i = 0; i < 3; ++i) {
+      left_ptrs.push_back(& left[i]);
+      right_ptrs.push_back(& right[i]);
+    }
+
+    ContractReduce<tensor_type, tensor_type, int>
+    op(left_op, right_op, 3, 2u, 2u, 2u);
+
+    // Compute the reference with pair-wise contractions
+    tensor_type reference;
+    for(int i = 0; i < 3; ++i)
+      op(reference, left[i], right[i]);
+
+    // Check the batched contraction with an empty result
+    tensor_type result;
+    BOOST_REQUIRE_NO_THROW(op(result, left_ptrs, right_ptrs));
+    BOOST_CHECK_EQUAL(result.range(), reference.range());
+    for(std::size_t i = 0ul; i < reference.size(); ++i)
+      BOOST_CHECK_EQUAL(result[i], reference[i]);
+
+    // Check the batched contraction with a non-empty result
+    for(int i = 0; i < 3; ++i)
+      op(reference, left[i], right[i]);
+    BOOST_REQUIRE_NO_THROW(op(result, left_ptrs, right_ptrs));
+    for(std::size_t i = 0ul; i < reference.size(); ++i)
+      BOOST_CHECK_EQUAL(result[i], reference[i]);
+  }
+}
+
+BOOST_AUTO_TEST_CASE( tensor_contract_permuted )
+{
+  // Construct argument tensors that are permuted relative to the layout of the
+  // contraction: left = [i,a,j] -> [a,i,j] and right = [j,b,i] -> [i,j,b]
+  tensor_type left = make_tensor(3, 2, 4, 30, 20, 40);
+  tensor_type right = make_tensor(4, 5, 3, 40, 50, 30);
+  const Permutation left_perm{1, 0, 2}, right_perm{1, 2, 0};
+
+  ContractReduce<tensor_type, tensor_type, int>
+  op(madness::cblas::NoTrans, madness::cblas::NoTrans, 3, 2u, 3u, 3u);
+  ContractReduce<tensor_type, tensor_type, int>
+  strided_op(madness::cblas::NoTrans, madness::cblas::NoTrans, 3, 2u, 3u, 3u,
+      Permutation(), left_perm, right_perm);
+  BOOST_CHECK(! op.permuted_args());
+  BOOST_CHECK(strided_op.permuted_args());
+
+  // Compute the reference with the permuted tensors
+  tensor_type reference;
+  op(reference, left.permute(left_perm), right.permute(right_perm));
+
+  // Check the strided contraction with an empty result
+  tensor_type result;
+  BOOST_REQUIRE_NO_THROW(strided_op(result, left, right));
+  BOOST_CHECK_EQUAL(result.range(), reference.range());
+  for(std::size_t i = 0ul; i < reference.size(); ++i)
+    BOOST_CHECK_EQUAL(result[i], reference[i]);
+
+  // Check the strided contraction with a non-empty result
+  op(reference, left.permute(left_perm), right.permute(right_perm));
+  BOOST_REQUIRE_NO_THROW(strided_op(result, left, right));
+  for(std::size_t i = 0ul; i < reference.size(); ++i)
+    BOOST_CHECK_EQUAL(result[i], reference[i]);
+}
+
 BOOST_AUTO_TEST_CASE( tensor_contract1 )
 {
   // Set dimension constants